@@ -1,15 +1,27 @@
 #include "../include/data_ingestion/DataReaderManager.h"
 #include "../include/core/ConfigParser.h"
+#include "../include/utils/SimdScan.h"
 #include <iostream>
 #include <chrono>
 
 int main(int argc, char** argv) {
     std::string config_path = (argc > 1) ? argv[1] : BENCH_CONFIG_DEFAULT;
+    // Optional second argument overrides every stream's parser: scalar | simd
+    std::string parser_override = (argc > 2) ? argv[2] : "";
 
     size_t message_count = 0;
     long long total_volume = 0;
 
     backtester::AppConfig config = backtester::ParseConfigToObj(config_path);
+    if (!parser_override.empty()) {
+        for (auto& dc : config.data_configs) {
+            dc.parser = backtester::StrToCsvParser(parser_override);
+        }
+    }
+    const bool simd = config.data_configs[0].parser == backtester::CsvParser::SIMD;
+    std::cout << "Parser: " << (simd ? "simd" : "scalar");
+    if (simd) std::cout << " (" << backtester::simd_scan::ActiveIsa() << ")";
+    std::cout << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
     ////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,143 @@
+#include "../include/core/EventQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic-event queue harness: the lane queue in EventQueue against the plain binary heap
+// it replaced, on the traffic the backtest loop produces and on random timestamps.
+
+namespace {
+
+using backtester::EventComparator;
+
+// The previous EventQueue: std::push_heap / std::pop_heap over whole events
+class HeapQueue {
+ public:
+  void PushEvent(const EventUnion& event) {
+    pq_.push_back(event);
+    std::push_heap(pq_.begin(), pq_.end(), comparator_);
+  }
+  bool IsEmpty() const { return pq_.empty(); }
+  const EventUnion& ReadTopEvent() const { return pq_.front(); }
+  EventUnion PopTopEvent() {
+    std::pop_heap(pq_.begin(), pq_.end(), comparator_);
+    EventUnion top = pq_.back();
+    pq_.pop_back();
+    return top;
+  }
+
+ private:
+  std::vector<EventUnion> pq_;
+  EventComparator comparator_;
+};
+
+EventUnion Make(uint64_t ts, EventType type) {
+  return EventUnion{.control_ev = {.header = {.timestamp = ts, .type = type}}};
+}
+
+struct Result {
+  uint64_t ops = 0;
+  uint64_t checksum = 0;  // order of (timestamp, type) pops
+  double secs = 0.0;
+};
+
+void Pop(auto& q, Result& r, uint64_t& pops) {
+  const EventUnion ev = q.PopTopEvent();
+  const auto& h = Hdr(ev);
+  r.checksum = r.checksum * 1'000'003 + h.timestamp * 31 + static_cast<uint64_t>(h.type);
+  ++pops;
+}
+
+// Market-maker requotes: every market tick emits a burst of signals at `now`, each signal
+// becomes an order at `now`, each order a fill at now + latency (+ up to `jitter_ns`, which
+// sends fills behind the fill lane's tail and into the heap).
+template <class Queue>
+Result Requotes(uint64_t ticks, uint32_t burst, uint64_t latency_ns, uint64_t jitter_ns = 0) {
+  Queue q;
+  Result r;
+  uint64_t pops = 0;
+  std::mt19937_64 rng(7);
+  std::uniform_int_distribution<uint64_t> jitter(0, jitter_ns);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint64_t tick = 0; tick < ticks; ++tick) {
+    const uint64_t now = 1'000'000 + tick * 1'000;
+    for (uint32_t i = 0; i < burst; ++i) q.PushEvent(Make(now, EventType::kStrategySignal));
+    while (!q.IsEmpty() && Hdr(q.ReadTopEvent()).timestamp <= now) {
+      const EventType type = Hdr(q.ReadTopEvent()).type;
+      const uint64_t ts = Hdr(q.ReadTopEvent()).timestamp;
+      Pop(q, r, pops);
+      if (type == EventType::kStrategySignal) {
+        q.PushEvent(Make(ts, EventType::kStrategyOrderAdd));
+      } else if (type == EventType::kStrategyOrderAdd) {
+        q.PushEvent(Make(ts + latency_ns + jitter(rng), EventType::kStrategyOrderFill));
+      }
+    }
+  }
+  while (!q.IsEmpty()) Pop(q, r, pops);
+  r.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  r.ops = pops * 2;  // every pop had a push
+  return r;
+}
+
+// No order at all: every push may land anywhere, most go to the overflow heap.
+template <class Queue>
+Result RandomTimestamps(uint64_t events, uint32_t depth) {
+  Queue q;
+  Result r;
+  uint64_t pops = 0;
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> ts(0, 1'000'000'000);
+  std::uniform_int_distribution<int> type(10, 15);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < depth; ++i) {
+    q.PushEvent(Make(ts(rng), static_cast<EventType>(type(rng))));
+  }
+  for (uint64_t i = 0; i < events; ++i) {
+    q.PushEvent(Make(ts(rng), static_cast<EventType>(type(rng))));
+    Pop(q, r, pops);
+  }
+  while (!q.IsEmpty()) Pop(q, r, pops);
+  r.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  r.ops = pops * 2;
+  return r;
+}
+
+void Report(const std::string& name, const Result& heap, const Result& lanes) {
+  auto mops = [](const Result& r) { return static_cast<double>(r.ops) / r.secs / 1e6; };
+  std::cout << name << "\n"
+            << "  heap : " << heap.secs << "s  " << mops(heap) << " M ops/s\n"
+            << "  lanes: " << lanes.secs << "s  " << mops(lanes) << " M ops/s  ("
+            << heap.secs / lanes.secs << "x)\n";
+  if (heap.checksum != lanes.checksum) std::cout << "  !! pop order differs\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint64_t ticks = (argc > 1) ? std::stoull(argv[1]) : 2'000'000;
+
+  for (uint32_t burst : {1u, 8u, 32u}) {
+    const std::string name = "requotes: " + std::to_string(ticks) + " ticks, " +
+                             std::to_string(burst) + " signals per tick, 500us latency";
+    const Result heap = Requotes<HeapQueue>(ticks, burst, 500'000);
+    const Result lanes = Requotes<backtester::EventQueue>(ticks, burst, 500'000);
+    Report(name, heap, lanes);
+  }
+
+  for (uint32_t burst : {8u, 32u}) {
+    const std::string name = "requotes: " + std::to_string(ticks / 4) + " ticks, " +
+                             std::to_string(burst) + " signals per tick, 500us +- 250us latency";
+    const Result heap = Requotes<HeapQueue>(ticks / 4, burst, 250'000, 500'000);
+    const Result lanes = Requotes<backtester::EventQueue>(ticks / 4, burst, 250'000, 500'000);
+    Report(name, heap, lanes);
+  }
+
+  const std::string name = "random timestamps: " + std::to_string(ticks) + " push/pop, depth 64";
+  Report(name, RandomTimestamps<HeapQueue>(ticks, 64),
+         RandomTimestamps<backtester::EventQueue>(ticks, 64));
+  return 0;
+}
@@ -5,15 +5,30 @@
 #include "../data_ingestion/DataReaderManager.h"
 #include "../execution/ExecutionHandler.h"
 #include "../market_state/MarketStateManager.h"
+#include "../market_state/SnapshotMarketDataProvider.h"
 #include "../portfolio/PortfolioManager.h"
 #include "../reporting/ReportGenerator.h"
 #include "../strategy/StrategyManager.h"
+#include "../utils/StageProfiler.h"
+#include "BroadcastRing.h"
 #include "EventQueue.h"
+#include "InstrumentShards.h"
 #include "SPSCRing.h"
 #include "Types.h"
 
 namespace backtester {
 
+// Every book walk the execution handler makes must be answerable from a frame
+static_assert(kFrameDepth >= MAX_AGGREGATE_DEPTH);
+
+// Traded instruments a book tracks, with the tick their depth ladders step by
+using TrackedInstruments = std::vector<std::pair<uint32_t, int64_t>>;
+
+// The book stage of every shared-market run, single or sharded: applies `ev` to `book` and
+// writes it to `frame`, with its instrument's post-event state when that one is in `traded`.
+void ApplyToFrame(MarketStateManager& book, const EventUnion& ev,
+                  const TrackedInstruments& traded, MarketFrame& frame);
+
 class Backtester {
  public:
   Backtester(EventQueue& eq, DataReaderManager& drm, MarketStateManager& msm, PortfolioManager& pm,
@@ -26,11 +41,39 @@ class Backtester {
         report_generator_(rg),
         execution_handler_(eh),
         strategy_manager_(sm),
-        config_(config) {}
+        config_(config),
+        consumer_wait_(config.ring_wait),
+        producer_wait_(config.ring_wait) {}
 
   int RunLoopSingleThreaded();
   int RunLoopThreaded();
 
+  // Three stages: the producer merges the sources into ring_, a book thread applies each event
+  // to the MarketStateManager and forwards it with its instrument's post-event state, and the
+  // calling thread runs strategies, execution and portfolio on `view`. Those must have been
+  // built on `view`, not on the book, which the book thread owns for the whole run. With
+  // config.book_shards > 1 the book stage is an InstrumentShards instead and the
+  // MarketStateManager given at construction is not touched.
+  int RunLoopPipelined(SnapshotMarketDataProvider& view);
+
+  // MARK: Shared market
+  // One book for many strategy replicas: a book thread runs PublishFrames, each replica runs
+  // RunReplica on its own thread with its strategy, portfolio and execution built on its own
+  // SnapshotMarketDataProvider.
+  static constexpr size_t kFrameCapacity = 1 << 12;
+  using FrameRing = BroadcastRing<MarketFrame, kFrameCapacity>;
+
+  // Merges the sources into the MarketStateManager and broadcasts every event with the
+  // post-event state of its instrument. Only touches the sources and the book, so it may run
+  // beside this object's own RunReplica. Returns once the sources are drained or every
+  // replica has detached.
+  void PublishFrames(FrameRing& frames);
+
+  // The single threaded loop with market events taken from `frames` instead of the sources.
+  // The DataReaderManager and MarketStateManager given at construction are not touched.
+  // Returns 1 without writing a report when the frames end because the book failed.
+  int RunReplica(FrameRing& frames, size_t reader, SnapshotMarketDataProvider& view);
+
  private:
   struct SourceHead {
     EventUnion event;  // next event from this source (valid unless exhausted)
@@ -48,12 +91,86 @@ class Backtester {
     }
   };
 
+  // Events pulled from DataReaderManager per LoadNextBatch call on the inline path.
+  // Non-MBO sources (OHLCV, MBP-10) fill `market` (via LoadNextMarketEvents) instead.
+  struct SourceBatch {
+    std::vector<MarketByOrderEvent> events;
+    std::vector<EventUnion> market;
+    size_t pos = 0;
+    size_t size = 0;
+  };
+
   static constexpr size_t kCapacity = 1 << 16;
+  static constexpr size_t kSourceCapacity = 1 << 14;
+  static constexpr size_t kSourceBatch = 512;
+  static constexpr size_t kRingBatch = 64;  // events per ring publish / release, threaded run
+  using SourceRing = SPSCRing<EventUnion, kSourceCapacity>;
+
+  // One decode/parse thread per source when running more than one source threaded.
+  // The producer then only merges ring heads instead of parsing every stream itself.
+  struct SourceFeed {
+    explicit SourceFeed(WaitPolicy policy) : data_wait(policy), space_wait(policy) {}
+    std::unique_ptr<SourceRing> ring = std::make_unique<SourceRing>();
+    std::thread thread;
+    std::atomic<bool> done{false};
+    alignas(64) RingWaiter data_wait;   // producer idles here while the ring is empty
+    alignas(64) RingWaiter space_wait;  // reader thread idles here while the ring is full
+  };
 
   void ProducerLoop();
+  // Book stage of RunLoopPipelined: drains ring_ in batches into `frames`
+  uint64_t BookLoop(FrameRing& frames);
+  // Sharded book stage: drains ring_ in batches into the shards' router
+  uint64_t RouteLoop(InstrumentShards& shards);
+  // Hands each event of ring_ to `publish` until it returns false or the producer is done
+  template <class Publish>
+  uint64_t DrainRing(Publish&& publish);
+  // Runs `book_stage` on its own thread beside the producer and replays `frames` here
+  template <class Frames, class BookStage>
+  uint64_t RunStages(Frames& frames, SnapshotMarketDataProvider& view, BookStage&& book_stage);
+  // RunReplica over any frame source with the FrameRing reader interface
+  template <class Frames>
+  int ReplayFrames(Frames& frames, size_t reader, SnapshotMarketDataProvider& view);
+  // Traded instruments the book tracks, with the tick their depth ladders step by
+  TrackedInstruments TrackedTraded() const;
+  // Applies `ev` to the book and publishes it as the next frame; false once no reader is left
+  bool PublishFrame(FrameRing& frames, const EventUnion& ev, const TrackedInstruments& traded);
+  void SourceReaderLoop(SourceFeed& feed, uint16_t source_id, DataSchema schema);
+  void StartSourceReaders();
+  void JoinSourceReaders();
+  bool NextSourceEvent(uint16_t idx, EventUnion& out);
   uint64_t ConsumerLoop();
-  bool FillRing();
+  // Publishes up to `max_events` merged events to ring_ in one batch; 0 when full or drained.
+  size_t FillRing(size_t max_events = 1);
   void ApplyMarket(const MarketByOrderEvent& mbo);
+  void ApplyBar(const OhlcvBarEvent& bar);
+  void ReactToMarket(const MarketByOrderEvent& mbo);
+  void ReactToBar(const OhlcvBarEvent& bar);
+  void ApplyMarketEvent(const EventUnion& ev) {
+    const EventType type = Hdr(ev).type;
+    if (BT_UNLIKELY(type == EventType::kMarketLevelUpdate)) {
+      BT_PROFILE_STAGE(Stage::kBookApply);
+      market_state_manager_.OnLevelEvent(ev.level);  // book only; the row's action follows
+    } else if (BT_UNLIKELY(type == EventType::kMarketBar)) {
+      ApplyBar(ev.bar);
+    } else {
+      ApplyMarket(ev.mbo);
+    }
+  }
+  // ApplyMarketEvent minus the book, for replicas whose view already holds the new state
+  void ReactToMarketEvent(const EventUnion& ev) {
+    const EventType type = Hdr(ev).type;
+    if (BT_UNLIKELY(type == EventType::kMarketLevelUpdate)) return;
+    if (BT_UNLIKELY(type == EventType::kMarketBar)) {
+      ReactToBar(ev.bar);
+    } else {
+      ReactToMarket(ev.mbo);
+    }
+  }
+  std::unordered_map<uint32_t, BidAskPair> TradedInstrsBbo() {
+    return replica_view_ ? replica_view_->GetTradedInstrsBbo()
+                         : market_state_manager_.GetTradedInstrsBbo();
+  }
   void ApplySynthetic(const EventUnion& ev, uint64_t current_time);
   void PrimeSources();
   void EmitClosingOrders(timestamp_t close_ts);
@@ -70,8 +187,13 @@ class Backtester {
 
   std::vector<SourceHead> source_heads_;  // one slot per configured source
   std::vector<uint16_t> source_heap_;
+  std::vector<SourceBatch> source_batches_;  // parallel to source_heads_ (inline path only)
+  std::vector<std::unique_ptr<SourceFeed>> source_feeds_;  // empty => producer parses inline
 
   SPSCRing<EventUnion, kCapacity> ring_;
+  alignas(64) RingWaiter consumer_wait_;  // consumer idles here while ring_ is empty
+  alignas(64) RingWaiter producer_wait_;  // producer idles here while ring_ is full
+  SnapshotMarketDataProvider* replica_view_ = nullptr;  // set while RunReplica runs
   std::atomic<bool> producer_done_{false};
   std::atomic<bool> backtest_complete_{false};
 };
@@ -80,7 +202,8 @@ inline bool isMarketEvent(EventType type) {
   return type == EventType::kMarketOrderAdd || type == EventType::kMarketOrderCancel ||
          type == EventType::kMarketOrderModify || type == EventType::kMarketOrderClear ||
          type == EventType::kMarketTrade || type == EventType::kMarketFill ||
-         type == EventType::kMarketHeartbeat;
+         type == EventType::kMarketHeartbeat || type == EventType::kMarketBar ||
+         type == EventType::kMarketLevelUpdate;
 }
 inline bool isStrategySignalEvent(EventType type) { return type == EventType::kStrategySignal; }
 inline bool isStrategyOrderEvent(EventType type) {
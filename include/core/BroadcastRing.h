@@ -0,0 +1,169 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <type_traits>
+
+#include "SPSCRing.h"
+
+namespace backtester {
+
+// Single-producer ring read in full by a fixed number of readers: every reader sees every
+// item, in order, through its own cursor. The producer may only overwrite a slot once every
+// attached reader has moved past it. Readers that finish early Detach so they stop holding
+// the producer back; Close tells the readers that nothing more is coming. A reader waiting in
+// WaitRead idles on a RingWaiter of its own with the given policy, and the producer waiting in
+// WaitWrite on one that every reader notifies as it frees slots or detaches.
+template <class T, size_t Capacity>
+class BroadcastRing {
+ public:
+  explicit BroadcastRing(size_t readers, WaitPolicy wait = WaitPolicy::SPIN)
+      : reader_count_(readers),
+        cursors_(std::make_unique<Cursor[]>(readers)),
+        wait_(wait),
+        space_(wait) {
+    for (size_t r = 0; r < readers; ++r) waiters_.emplace_back(wait);
+  }
+
+  size_t ReaderCount() const { return reader_count_; }
+
+  // ---- Producer side ----
+  // Slot to fill, nullptr while the slowest attached reader is a full ring behind. With every
+  // reader detached the ring reads as full within a ring of writes, so a producer that checks
+  // Abandoned when it sees nullptr stops there.
+  T* PrepareWrite() {
+    const size_t w = write_idx_.load(std::memory_order_relaxed);
+    if (w - cached_min_read_ >= Capacity) {
+      cached_min_read_ = MinReadIdx(w);
+      if (w - cached_min_read_ >= Capacity) {
+        WakeReaders();  // a reader parked before the last partial batch of notifies
+        return nullptr;
+      }
+    }
+    return &slots_[w & kMask];
+  }
+
+  // Slot to fill, waiting for the slowest attached reader; nullptr once every reader has
+  // detached.
+  T* WaitWrite() {
+    if (T* slot = PrepareWrite()) return slot;
+    space_.Wait([&] { return PrepareWrite() != nullptr || Abandoned(); });
+    return PrepareWrite();  // still nullptr when abandoned
+  }
+
+  void CommitWrite() {
+    const size_t w = write_idx_.load(std::memory_order_relaxed);
+    write_idx_.store(w + 1, std::memory_order_release);
+    if (wait_ == WaitPolicy::PARK) {
+      for (auto& waiter : waiters_) waiter.Notify();
+    }
+  }
+
+  // No more items; readers drain what is left and then see the end.
+  void Close() {
+    closed_.store(true, std::memory_order_release);
+    WakeReaders();
+  }
+
+  // Close because producing failed: readers still drain what is left, then see Failed().
+  void Fail() {
+    failed_.store(true, std::memory_order_relaxed);
+    Close();  // the release store publishes failed_ to readers that see the close
+  }
+
+  // True once every reader has detached, so producing more is pointless.
+  bool Abandoned() const {
+    for (size_t r = 0; r < reader_count_; ++r) {
+      if (!cursors_[r].detached.load(std::memory_order_acquire)) return false;
+    }
+    return true;
+  }
+
+  // ---- Reader side ----
+  const T* PeekRead(size_t reader) {
+    Cursor& c = cursors_[reader];
+    const size_t r = c.read_idx.load(std::memory_order_relaxed);
+    if (r == c.cached_write) {
+      c.cached_write = write_idx_.load(std::memory_order_acquire);
+      if (r == c.cached_write) return nullptr;
+    }
+    return &slots_[r & kMask];
+  }
+
+  void CommitRead(size_t reader) {
+    Cursor& c = cursors_[reader];
+    c.read_idx.store(c.read_idx.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    // Batched like RingWaiter::Notify, with the count kept per reader
+    if (wait_ == WaitPolicy::PARK && ++c.unnotified == RingWaiter::kWakeBatch) NotifySpace(c);
+  }
+
+  // Next item for `reader`, waiting for the producer; nullptr once the ring is closed and
+  // this reader has seen everything. The item stays valid until CommitRead.
+  const T* WaitRead(size_t reader) {
+    if (const T* item = PeekRead(reader)) return item;
+    if (cursors_[reader].unnotified > 0) NotifySpace(cursors_[reader]);  // before idling
+    waiters_[reader].Wait([&] {
+      return PeekRead(reader) != nullptr || closed_.load(std::memory_order_acquire);
+    });
+    // re-check after the flag: the producer may have published its last item right before
+    return PeekRead(reader);
+  }
+
+  void Detach(size_t reader) {
+    cursors_[reader].detached.store(true, std::memory_order_release);
+    space_.NotifyNow();  // the producer may be waiting on this reader alone
+  }
+
+  // After WaitRead returned nullptr: whether the ring ended by Fail rather than Close.
+  bool Failed() const { return failed_.load(std::memory_order_acquire); }
+
+ private:
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+  static_assert(std::is_trivially_copyable_v<T>);
+  static constexpr size_t kMask = Capacity - 1;
+  static constexpr size_t kCacheLine = 64;
+
+  struct alignas(kCacheLine) Cursor {
+    std::atomic<size_t> read_idx{0};
+    std::atomic<bool> detached{false};
+    size_t cached_write = 0;  // reader-only copy of write_idx_
+    uint32_t unnotified = 0;  // reads since this reader last notified space_
+  };
+
+  // A detached reader no longer holds the producer back; with none attached the ring is full.
+  size_t MinReadIdx(size_t write_idx) const {
+    size_t min = write_idx;
+    bool attached = false;
+    for (size_t r = 0; r < reader_count_; ++r) {
+      if (cursors_[r].detached.load(std::memory_order_acquire)) continue;
+      attached = true;
+      const size_t idx = cursors_[r].read_idx.load(std::memory_order_acquire);
+      if (idx < min) min = idx;
+    }
+    return attached ? min : write_idx - Capacity;
+  }
+
+  void WakeReaders() {
+    for (auto& waiter : waiters_) waiter.NotifyNow();
+  }
+
+  void NotifySpace(Cursor& c) {
+    c.unnotified = 0;
+    space_.NotifyNow();
+  }
+
+  alignas(kCacheLine) std::array<T, Capacity> slots_{};
+  alignas(kCacheLine) std::atomic<size_t> write_idx_{0};
+  alignas(kCacheLine) size_t cached_min_read_{0};  // producer-only
+  alignas(kCacheLine) std::atomic<bool> closed_{false};
+  std::atomic<bool> failed_{false};
+  size_t reader_count_;
+  std::unique_ptr<Cursor[]> cursors_;
+  WaitPolicy wait_;
+  std::deque<RingWaiter> waiters_;  // one per reader, notified by the producer
+  RingWaiter space_;                // the producer's, notified by every reader
+};
+
+}  // namespace backtester
@@ -14,15 +14,35 @@ AppConfig ParseConfigToObj(const std::filesystem::path& config_path);
 AppConfig ParseConfigFromJson(const nlohmann::json& data,
                               std::filesystem::path config_path);
 
+// Expands a data_filepath into the files of a multi-file source, in replay order. A
+// "{date}" placeholder becomes every UTC day (YYYYMMDD) from start_time to end_time whose
+// file exists; glob characters (*, ?, [) match files sorted by name. Anything else is
+// returned as is. Throws when a pattern matches no file.
+std::vector<std::string> ExpandDataFiles(const std::string& pattern, timestamp_t start_time,
+                                         timestamp_t end_time);
 std::vector<Symbol> ParseDataSymbols(const std::string& filepath);
 std::vector<Strategy> ParseStrategies(const nlohmann::json& data);
+// "sweep" block: axes refer to strategies by name (the first one of that name) and to a
+// params slot by index. Throws on an unknown strategy, an out of range slot or no values.
+SweepConfig ParseSweep(const nlohmann::json& data, const std::vector<Strategy>& strategies);
 std::vector<TradedInstrument> ParseTradedInstrs(const nlohmann::json& data);
 RiskLimits ParseRiskLimits(const nlohmann::json& data);
 CommissionStruct ParseCommissions(const nlohmann::json& data);
 
+// Databento bar schemas ("ohlcv-1s", "ohlcv-1m", "ohlcv-1h", "ohlcv-1d") carry their
+// interval in the name; plain "ohlcv" means the bar interval is unknown (0).
+inline timestamp_t StrToBarInterval(const std::string& str) {
+  if (AreEqual(str, "ohlcv-1s")) return 1'000'000'000ULL;
+  if (AreEqual(str, "ohlcv-1m")) return 60'000'000'000ULL;
+  if (AreEqual(str, "ohlcv-1h")) return 3'600'000'000'000ULL;
+  if (AreEqual(str, "ohlcv-1d")) return 86'400'000'000'000ULL;
+  return 0;
+}
+
 inline DataSchema StrToDataSchema(const std::string& str) {
   if (AreEqual(str, "mbo")) return DataSchema::MBO;
-  if (AreEqual(str, "ohlcv")) return DataSchema::OHLCV;
+  if (AreEqual(str, "ohlcv") || StrToBarInterval(str) != 0) return DataSchema::OHLCV;
+  if (AreEqual(str, "mbp-10") || AreEqual(str, "mbp10")) return DataSchema::MBP10;
   spdlog::error("Invalid/unparsable data schema in data stream config: {}",
                 str);
   throw std::invalid_argument("Invalid schema: " + str);
@@ -32,6 +52,7 @@ inline Encoding StrToEncoding(const std::string& str) {
   if (AreEqual(str, "csv")) return Encoding::CSV;
   if (AreEqual(str, "dbn")) return Encoding::DBN;
   if (AreEqual(str, "json")) return Encoding::JSON;
+  if (AreEqual(str, "mbocache")) return Encoding::MBOCACHE;
   spdlog::error("Invalid/unparsable data encoding in data stream config: {}",
                 str);
   throw std::invalid_argument("Invalid encoding value: " + str);
@@ -61,6 +82,22 @@ inline TmStampFormat StrToTSFormat(const std::string& str) {
   throw std::invalid_argument("Invalid schema: " + str);
 };
 
+inline CsvParser StrToCsvParser(const std::string& str) {
+  if (AreEqual(str, "scalar")) return CsvParser::SCALAR;
+  if (AreEqual(str, "simd")) return CsvParser::SIMD;
+  spdlog::error("Invalid/unparsable csv parser in data stream config: {}",
+                str);
+  throw std::invalid_argument("Invalid parser: " + str);
+};
+
+inline WaitPolicy StrToWaitPolicy(const std::string& str) {
+  if (AreEqual(str, "spin")) return WaitPolicy::SPIN;
+  if (AreEqual(str, "pause")) return WaitPolicy::PAUSE;
+  if (AreEqual(str, "park")) return WaitPolicy::PARK;
+  spdlog::error("Invalid/unparsable ring wait policy in config: {}", str);
+  throw std::invalid_argument("Invalid ring_wait: " + str);
+};
+
 inline InstrumentType ParseInstrType(const std::string& str) {
   if (AreEqual(str, "fut")) return InstrumentType::FUT;
   if (AreEqual(str, "stock")) return InstrumentType::STOCK;
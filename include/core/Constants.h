@@ -4,6 +4,8 @@
 const std::string kExpectedMboHeader =
     "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,"
     "channel_id,order_id,flags,ts_in_delta,sequence,symbol";
+const std::string kExpectedOhlcvHeader =
+    "ts_event,rtype,publisher_id,instrument_id,open,high,low,close,volume,symbol";
 const std::string kExpectedMBP10Header =
     "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,depth,price,"
     "size,flags,ts_in_delta,sequence,bid_px_00,ask_px_00,bid_sz_00,ask_sz_00,"
@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "../reporting/ReportGenerator.h"
+#include "Types.h"
+
+namespace backtester {
+
+// One UTC day of a sharded run: the config clamped to that day, with only the day's data files.
+struct DayShard {
+  std::string label;  // YYYYMMDD
+  AppConfig config;
+};
+
+// Splits [start_time, end_time] at UTC midnights. A source whose files carry dates in their
+// names (e.g. ES-20251105.mbo.csv.zst) keeps only the files of that day and sits the day out
+// when it has none; a source without dated files is replayed whole every day from the day's
+// start. Days left without any source are dropped. Reports go to <report_output_dir>/days/<label>.
+std::vector<DayShard> SplitIntoDays(const AppConfig& config);
+
+struct DayResult {
+  std::string label;
+  std::vector<TradeRecord> trades;
+  std::vector<EquitySnapshot> equity_curve;
+  std::vector<std::string> strategy_names;
+  money_t final_equity = 0;  // after the closing orders
+  money_t final_realized_pnl = 0;
+  PerformanceSummary summary;
+  bool ok = false;
+};
+
+// Chains the days' equity curves as if each day started with the equity the previous one
+// ended with: equity, cash and realized PnL are shifted by the PnL of the earlier days and the
+// drawdown is taken against the peak carried across days.
+std::vector<EquitySnapshot> StitchEquityCurves(const std::vector<DayResult>& days,
+                                               money_t initial_cash);
+
+// Runs every day of the config's window as an independent single-threaded backtest on a pool
+// of "day_threads" workers, then merges the trade logs and equity curves into one report in
+// report_output_dir. Every day starts flat with initial_cash, so the merged report matches a
+// continuous run only for strategies that are flat at the close and keep no state overnight.
+class DayShardedBacktest {
+ public:
+  explicit DayShardedBacktest(const AppConfig& config) : config_(config) {}
+
+  // False if there was nothing to run or any day failed.
+  bool Run();
+
+  // In day order; filled by Run.
+  const std::vector<DayResult>& Days() const { return days_; }
+
+ private:
+  static void RunDay(const DayShard& shard, DayResult& result);
+
+  const AppConfig& config_;
+  std::vector<DayResult> days_;
+};
+
+}  // namespace backtester
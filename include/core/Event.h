@@ -11,8 +11,10 @@ enum class EventType : uint8_t {
   kMarketFill,
   kMarketNone,
   kMarketHeartbeat,
+  kMarketBar,
+  kMarketLevelUpdate,
 
-  kStrategySignal,  // 8
+  kStrategySignal,  // 10
 
   kStrategyOrderAdd,
   kStrategyOrderCancel,
@@ -21,7 +23,7 @@ enum class EventType : uint8_t {
   kStrategyOrderFill,
   kStrategyOrderRejection,
 
-  kBacktestControlStart,  // 14
+  kBacktestControlStart,  // 16
   kBacktestControlEndOfDay,
   kBacktestControlSnapshot,
   kBacktestControlEndOfBacktest
@@ -71,6 +73,44 @@ struct MarketByOrderEvent {  // 62
   uint8_t flags;             //  1
 };
 
+//////////////////////////////////////////////////////////////
+///////////// MARK: OHLCV Bar Event Class
+//////////////////////////////////////////////////////////////
+
+// One aggregated bar. header.timestamp is when the bar is complete (ts_event + interval),
+// so strategies never see a bar before its close.
+struct OhlcvBarEvent {       // 64
+  EventHeader header;        // 16
+  int64_t open;              //  8
+  int64_t high;              //  8
+  int64_t low;               //  8
+  int64_t close;             //  8
+  uint64_t volume;           //  8
+  uint32_t instrument_id;    //  4
+  uint16_t data_source_id;   //  2
+  uint16_t publisher_id;     //  2
+};
+
+//////////////////////////////////////////////////////////////
+///////////// MARK: Price Level Event Class
+//////////////////////////////////////////////////////////////
+
+// New contents of one (side, depth) slot of a fixed-depth MBP book. Emitted by the MBP-10
+// reader for every slot a row changed, ahead of the row's own action event; the slot is
+// empty when price is kUndefPrice.
+struct MarketLevelEvent {    // 48
+  EventHeader header;        // 16
+  int64_t price;             //  8
+  uint32_t size;             //  4
+  uint32_t count;            //  4
+  uint32_t instrument_id;    //  4
+  uint32_t sequence;         //  4
+  uint16_t data_source_id;   //  2
+  uint16_t publisher_id;     //  2
+  OrderSide side;            //  1
+  uint8_t depth;             //  1
+};
+
 //////////////////////////////////////////////////////////////
 ///////////// MARK: Strategy Classes
 //////////////////////////////////////////////////////////////
@@ -127,6 +167,8 @@ struct ControlEvent {
 
 union EventUnion {
   MarketByOrderEvent mbo;
+  OhlcvBarEvent bar;
+  MarketLevelEvent level;
   StrategySignalEvent strat_signal_ev;
   StrategyOrderEvent strat_order_ev;
   StrategyOrderRejectionEvent strat_rej_ev;
@@ -138,4 +180,6 @@ inline const EventHeader& Hdr(const EventUnion& e) noexcept { return e.mbo.heade
 
 static_assert(sizeof(EventUnion) == 64);
 static_assert(std::is_trivially_copyable_v<EventUnion>);
-static_assert(std::is_standard_layout_v<MarketByOrderEvent>);
\ No newline at end of file
+static_assert(std::is_standard_layout_v<MarketByOrderEvent>);
+static_assert(sizeof(OhlcvBarEvent) == 64);
+static_assert(sizeof(MarketLevelEvent) == 48);
\ No newline at end of file
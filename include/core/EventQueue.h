@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <optional>
 #include <queue>
 
@@ -16,6 +17,15 @@ struct EventComparator {
   }
 };
 
+// Synthetic events mostly arrive in time order per type: signals at the market event's time,
+// orders and fills at now or now + latency. Each type gets a FIFO lane, so the common push and
+// pop are O(1); only an event stamped before its lane's tail goes to a binary heap. The top is
+// the smallest (timestamp, type) across the non-empty lanes and the heap, which keeps the
+// EventComparator ordering; equal events of one lane come out in push order.
+//
+// Heap entries are 16-byte keys into a slab that holds their payloads, so a sift shuffles keys
+// rather than whole events. Lanes keep the events themselves: a FIFO never reorders, and reading
+// it front to back is cheaper than chasing slab slots.
 class EventQueue {
  public:
   EventQueue() {}
@@ -35,8 +45,43 @@ class EventQueue {
   void clear();
 
  private:
-  std::vector<EventUnion> pq_;
-  EventComparator comparator_;
+  static constexpr size_t kLaneCount =
+      static_cast<size_t>(EventType::kBacktestControlEndOfBacktest) + 1;
+  static constexpr size_t kHeapSource = kLaneCount;
+  static constexpr size_t kNoTop = kLaneCount + 1;
+  static_assert(kLaneCount <= 32, "lane_mask_ has one bit per event type");
+
+  struct Key {
+    uint64_t timestamp;
+    uint32_t slot;  // index into slab_
+    EventType type;
+  };
+  static_assert(sizeof(Key) == 16);
+
+  // EventComparator on keys: true if a pops after b
+  struct KeyComparator {
+    bool operator()(const Key& a, const Key& b) const noexcept {
+      if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+      return a.type > b.type;
+    }
+  };
+
+  struct Lane {
+    std::vector<EventUnion> events;
+    size_t head = 0;  // events before head are already popped
+  };
+
+  // Lane index of the top event, or kHeapSource; cached until the next push or pop
+  size_t TopSource() const;
+
+  std::array<Lane, kLaneCount> lanes_;
+  uint32_t lane_mask_ = 0;        // bit i set while lane i holds events
+  std::vector<Key> overflow_;     // heap of events pushed behind their lane's tail
+  std::vector<EventUnion> slab_;  // overflow payloads, indexed by Key::slot
+  std::vector<uint32_t> free_slots_;
+  KeyComparator comparator_;
+  size_t size_ = 0;
+  mutable size_t top_ = kNoTop;
 };
 
-}  // namespace backtester
\ No newline at end of file
+}  // namespace backtester
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../market_state/MarketStateManager.h"
+#include "../market_state/SnapshotMarketDataProvider.h"
+#include "SPSCRing.h"
+#include "Types.h"
+
+namespace backtester {
+
+// Book building split across threads by instrument: shard `instrument_id % shards` owns the
+// instrument's book in a MarketStateManager of its own, so books that never interact update
+// in parallel. One router thread hands each market event to its shard and appends the shard
+// to a route ring; the reader takes frames back in route order, which is the order they were
+// routed in. It therefore sees the stream a single book thread would have published, frame
+// for frame, whatever the workers' relative speed.
+//
+// The reader side mirrors a one-reader Backtester::FrameRing, so the replica loop runs on
+// either unchanged. Every thread idles on RingWaiters with config.ring_wait, and flushes the
+// notifications it owes before it waits, so no two threads can park on each other.
+class InstrumentShards {
+ public:
+  static constexpr size_t kInputCapacity = 1 << 12;
+  static constexpr size_t kOutputCapacity = 1 << 10;
+  static constexpr size_t kRouteCapacity = 1 << 16;
+
+  // Starts one worker per shard, each with a book over its share of the active instruments.
+  InstrumentShards(size_t shard_count, const AppConfig& config);
+  ~InstrumentShards();
+
+  size_t ShardCount() const { return shards_.size(); }
+  size_t ShardOf(uint32_t instrument_id) const { return instrument_id % shards_.size(); }
+
+  // ---- Router side ----
+  // Hands `ev` to its shard; false once the reader has detached or that shard's worker failed.
+  bool Route(const EventUnion& ev);
+
+  // No more events; the workers drain their input and stop.
+  void Close();
+  // Close because routing failed; the reader sees Failed() once it has drained.
+  void Fail();
+
+  // Waits for the workers and rethrows the first error one of them hit.
+  void Join();
+
+  // ---- Reader side ----
+  // Next frame in routing order, nullptr once closed and drained or when a worker failed.
+  const MarketFrame* WaitRead(size_t reader);
+  void CommitRead(size_t reader);
+  void Detach(size_t reader);
+  // After WaitRead returned nullptr: whether the stream ended by Fail or a worker's failure.
+  bool Failed() const;
+
+ private:
+  using InputRing = SPSCRing<EventUnion, kInputCapacity>;
+  using OutputRing = SPSCRing<MarketFrame, kOutputCapacity>;
+
+  struct Shard {
+    explicit Shard(WaitPolicy wait)
+        : input_ready(wait), input_space(wait), output_ready(wait), output_space(wait) {}
+    MarketStateManager book;
+    std::vector<std::pair<uint32_t, int64_t>> traded;  // TrackedInstruments of this book
+    std::unique_ptr<InputRing> input = std::make_unique<InputRing>();
+    std::unique_ptr<OutputRing> output = std::make_unique<OutputRing>();
+    std::thread thread;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    uint64_t events = 0;
+    alignas(64) RingWaiter input_ready;   // worker, while input is empty
+    alignas(64) RingWaiter input_space;   // router, while input is full
+    alignas(64) RingWaiter output_ready;  // reader, while output is empty
+    alignas(64) RingWaiter output_space;  // worker, while output is full
+  };
+
+  void WorkerLoop(Shard& shard);
+  // Wakes whoever may be parked on what this side published or freed since its last Notify
+  void FlushRouter();
+  void FlushWorker(Shard& shard);
+  void FlushReader();
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::unique_ptr<SPSCRing<uint16_t, kRouteCapacity>> route_;
+  alignas(64) RingWaiter route_ready_;  // reader, while the route ring is empty
+  alignas(64) RingWaiter route_space_;  // router, while the route ring is full
+  uint16_t reading_ = 0;  // reader-only: shard of the frame WaitRead returned
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> failed_{false};
+  std::atomic<bool> detached_{false};
+};
+
+}  // namespace backtester
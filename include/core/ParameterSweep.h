@@ -0,0 +1,60 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../data_ingestion/EventArena.h"
+#include "../reporting/ReportGenerator.h"
+#include "Types.h"
+
+namespace backtester {
+
+// Every combination of the sweep's axis values, one value per axis, first axis slowest.
+std::vector<std::vector<int>> ExpandSweepGrid(const SweepConfig& sweep);
+
+// `base` with one combination written into its strategy params and its reports sent to
+// `report_dir`.
+AppConfig ApplySweepCombo(const AppConfig& base, const std::vector<int>& values,
+                          const std::string& report_dir);
+
+struct SweepResult {
+  size_t combo = 0;
+  std::vector<int> values;
+  std::string report_dir;
+  PerformanceSummary summary;
+  bool ok = false;
+};
+
+// Runs one backtest per combination of the config's sweep grid. The MBO sources are decoded
+// once into an in-memory EventArena that every run replays. By default each run owns its
+// books, strategies, portfolio and execution and runs are spread over a pool of worker
+// threads. With share_book, combinations run in passes of `threads` replicas behind one book
+// thread (see Backtester::PublishFrames). Each run writes the usual report to
+// <report_output_dir>/sweep/combo_NNNN, then <report_output_dir>/sweep_ranking.csv ranks them.
+class ParameterSweep {
+ public:
+  explicit ParameterSweep(const AppConfig& config) : config_(config) {}
+
+  // False if the arena could not be built or any combination failed.
+  bool Run();
+
+  // In combination order; filled by Run.
+  const std::vector<SweepResult>& Results() const { return results_; }
+
+  // Successful runs, best Sharpe first, ties broken by total PnL then combination order.
+  static std::vector<SweepResult> Rank(const std::vector<SweepResult>& results);
+
+  static bool WriteRanking(const std::string& filepath, const AppConfig& config,
+                           const std::vector<SweepResult>& ranked);
+
+ private:
+  void RunCombo(SweepResult& result, const std::shared_ptr<const EventArena>& arena) const;
+  void RunSharedPass(std::span<SweepResult> batch,
+                     const std::shared_ptr<const EventArena>& arena) const;
+
+  const AppConfig& config_;
+  std::vector<SweepResult> results_;
+};
+
+}  // namespace backtester
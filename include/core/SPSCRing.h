@@ -1,10 +1,112 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "Types.h"
 
 namespace backtester {
 
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// How one side of an SPSCRing idles until the other side makes progress. SPIN re-polls at once,
+// PAUSE re-polls after a CPU pause hint, PARK pauses for kSpinsBeforePark turns and then sleeps
+// on a futex (std::atomic::wait) until the other side notifies. Notify only looks for a sleeper
+// every kWakeBatch calls, so the busy side pays one fence per batch and a parked side wakes up to
+// a batch of work; NotifyNow is for the last word (end of stream, stop). Notify has one caller;
+// NotifyNow may have several (a BroadcastRing's readers all free slots for its producer). Spins
+// and parks are counted by the waiting thread, wakes by the notifying ones.
+class RingWaiter {
+ public:
+  static constexpr uint32_t kSpinsBeforePark = 4096;
+  static constexpr uint32_t kWakeBatch = 64;
+
+  struct Counters {
+    uint64_t spins = 0;
+    uint64_t parks = 0;
+    uint64_t wakes = 0;
+  };
+
+  explicit RingWaiter(WaitPolicy policy = WaitPolicy::SPIN) : policy_(policy) {}
+
+  // Returns once ready() holds.
+  template <class Ready>
+  void Wait(Ready&& ready) {
+    uint32_t turns = 0;
+    while (!ready()) {
+      ++counters_.spins;
+      if (policy_ == WaitPolicy::SPIN) continue;
+      CpuRelax();
+      if (policy_ == WaitPolicy::PARK && ++turns >= kSpinsBeforePark) {
+        turns = 0;
+        Park(ready);
+      }
+    }
+  }
+
+  // Called by the other side after publishing or freeing `n` slots.
+  void Notify(uint32_t n = 1) {
+    if (policy_ != WaitPolicy::PARK) return;
+    since_check_ += n;
+    if (since_check_ < kWakeBatch) return;
+    since_check_ = 0;
+    NotifyNow();
+  }
+
+  void NotifyNow() {
+    if (policy_ != WaitPolicy::PARK) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);  // publish before reading sleeping_
+    // one wake per park, however many batches land before the sleeper runs again
+    if (!sleeping_.load(std::memory_order_relaxed) ||
+        !sleeping_.exchange(false, std::memory_order_relaxed)) {
+      return;
+    }
+    epoch_.fetch_add(1, std::memory_order_release);
+    epoch_.notify_one();
+    wakes_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  WaitPolicy Policy() const { return policy_; }
+  Counters Stats() const {
+    Counters stats = counters_;
+    stats.wakes = wakes_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  template <class Ready>
+  void Park(Ready& ready) {
+    const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);  // pairs with NotifyNow's fence
+    if (!ready()) {
+      ++counters_.parks;
+      epoch_.wait(epoch, std::memory_order_acquire);
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+  }
+
+  WaitPolicy policy_;
+  std::atomic<bool> sleeping_{false};
+  std::atomic<uint32_t> epoch_{0};
+  uint32_t since_check_ = 0;  // notifier-only
+  Counters counters_;         // spins and parks, waiter-only
+  std::atomic<uint64_t> wakes_{0};
+};
+
 template <class T, size_t Capacity>
 class SPSCRing {
  public:
@@ -61,6 +163,43 @@ class SPSCRing {
     read_idx_.store(r + 1, std::memory_order_release);  // free the slot for the producer
   }
 
+  // ---- Batched producer side ----
+  // Up to `max` free slots, contiguous in memory, so fewer than free at the wrap; empty when
+  // full. One CommitWriteBatch publishes all that were filled with a single release store.
+  std::span<T> PrepareWriteBatch(size_t max) {
+    const size_t w = write_idx_.load(std::memory_order_relaxed);
+    size_t free = Capacity - (w - cached_read_);
+    if (free < max) {  // only touch the consumer's line when the cache can't cover the batch
+      cached_read_ = read_idx_.load(std::memory_order_acquire);
+      free = Capacity - (w - cached_read_);
+    }
+    const size_t start = w & kMask;
+    return {slots_.data() + start, std::min({max, free, Capacity - start})};
+  }
+
+  void CommitWriteBatch(size_t n) {
+    const size_t w = write_idx_.load(std::memory_order_relaxed);
+    write_idx_.store(w + n, std::memory_order_release);
+  }
+
+  // ---- Batched consumer side ----
+  // Up to `max` readable slots, contiguous in memory; they stay valid until CommitReadBatch.
+  std::span<const T> PeekReadBatch(size_t max) {
+    const size_t r = read_idx_.load(std::memory_order_relaxed);
+    size_t avail = cached_write_ - r;
+    if (avail < max) {
+      cached_write_ = write_idx_.load(std::memory_order_acquire);
+      avail = cached_write_ - r;
+    }
+    const size_t start = r & kMask;
+    return {slots_.data() + start, std::min({max, avail, Capacity - start})};
+  }
+
+  void CommitReadBatch(size_t n) {
+    const size_t r = read_idx_.load(std::memory_order_relaxed);
+    read_idx_.store(r + n, std::memory_order_release);
+  }
+
  private:
   static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
   static_assert(std::is_trivially_copyable_v<T>);
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "../data_ingestion/IDataReader.h"
@@ -24,11 +25,14 @@ using qty_t = int64_t;
 using order_id_t = int64_t;  // internal IDs (wire IDs stay uint64_t)
 using money_t = int64_t;
 
-enum class DataSchema { MBO, OHLCV };
-enum class Encoding { DBN, CSV, JSON };
+enum class DataSchema { MBO, OHLCV, MBP10 };
+static constexpr uint32_t kMbp10Depth = 10;  // levels per side in an MBP-10 row
+enum class Encoding { DBN, CSV, JSON, MBOCACHE };
 enum class Compression { ZSTD, NONE };
 enum class PriceFormat { FIXPNTINT, DECIMAL };
 enum class TmStampFormat { UNIX, ISO };
+enum class CsvParser { SCALAR, SIMD };
+enum class WaitPolicy { SPIN, PAUSE, PARK };  // how a threaded run's ring sides wait
 enum class InstrumentType { FUT, STOCK, OPTION };
 
 enum class RiskMode {
@@ -52,6 +56,13 @@ struct DataSourceConfig {
   Compression compression;
   PriceFormat price_format;
   TmStampFormat ts_format;
+  uint32_t decode_threads = 1;  // >1 decodes multi-frame .csv.zst files in parallel
+  CsvParser parser = CsvParser::SCALAR;
+  uint32_t prefetch_blocks = 3;  // compressed blocks read ahead of the decoder, 0 = inline
+  timestamp_t bar_interval_ns = 0;  // OHLCV only; 0 = bars are already stamped at their close
+  bool seek_to_start = false;  // resume at the last recovery point before start_time (.tsidx)
+  std::vector<uint32_t> instrument_filter = {};  // instrument_ids to keep; empty = all
+  std::vector<std::string> data_files = {};  // multi-file source in replay order; empty = one file
 };
 
 struct DataStream {
@@ -97,6 +108,20 @@ struct RiskLimits {
   int64_t max_delta_per_trade;  // Max dollar delta added per trade
 };
 
+// One swept strategy parameter: every value to try for params[param_index] of
+// strategies[strategy_index].
+struct SweepAxis {
+  size_t strategy_index = 0;
+  size_t param_index = 0;
+  std::vector<int> values = {};
+};
+
+struct SweepConfig {
+  std::vector<SweepAxis> axes = {};  // empty = no sweep configured
+  uint32_t threads = 0;              // 0 = one per hardware thread
+  bool share_book = false;           // one book thread feeds `threads` replicas per pass
+};
+
 struct AppConfig {
   timestamp_t start_time;  // Expected: YYYY-MM-DDTHH:MM:SS.nnnnnnnnnZ
   timestamp_t end_time;    // Expected: YYYY-MM-DDTHH:MM:SS.nnnnnnnnnZ
@@ -107,12 +132,17 @@ struct AppConfig {
   double risk_free_rate;
   std::string log_file_path;
   std::string report_output_dir;
+  std::string event_arena_dir;  // shared decoded-event arenas (e.g. /dev/shm); empty = none
   std::vector<Strategy> strategies;
   uint32_t max_lob_lvl;
   std::vector<TradedInstrument> traded_instruments;
   RiskLimits risk_limits;
   std::vector<DataSourceConfig> data_configs;
   std::vector<uint32_t> active_instruments;
+  SweepConfig sweep;
+  uint32_t day_threads = 0;  // workers of a day-sharded run, 0 = one per hardware thread
+  WaitPolicy ring_wait = WaitPolicy::SPIN;
+  uint32_t book_shards = 1;  // book threads of a pipelined run, split by instrument_id
 };
 
 struct Position {
@@ -0,0 +1,76 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace backtester {
+
+// Reads a file front to back in fixed-size blocks on a background thread, keeping up to
+// `depth` blocks in flight so the caller decompresses one block while the next ones are
+// being read. A depth of 0 reads each block inline on the caller's thread.
+class BlockPrefetcher {
+ public:
+  static constexpr size_t kDefaultDepth = 3;
+  static constexpr size_t kDefaultBlockBytes = size_t{1} << 20;
+
+  explicit BlockPrefetcher(size_t depth = kDefaultDepth,
+                           size_t block_bytes = kDefaultBlockBytes);
+  ~BlockPrefetcher();
+
+  BlockPrefetcher(const BlockPrefetcher&) = delete;
+  BlockPrefetcher& operator=(const BlockPrefetcher&) = delete;
+
+  // Blocks start at byte `offset` of the file, e.g. the start of a zstd frame.
+  bool Open(const std::string& filename, size_t offset = 0);
+  void Close();
+  bool IsOpen() const { return fd_ >= 0; }
+
+  // Next block in file order; empty at end of file or after a read error. The returned
+  // bytes stay valid until the following call, which hands the block back for reuse.
+  std::span<const char> NextBlock();
+  // True once NextBlock has ended on a read error rather than at end of file. Kept until
+  // the next Open, so a reader can still ask after closing.
+  bool Failed() const { return failed_; }
+
+  size_t Depth() const { return depth_; }
+  // Blocks the caller had to wait for because the reader thread had not caught up
+  size_t Stalls() const { return stalls_; }
+
+ private:
+  struct Slot {
+    std::vector<char> data;
+    size_t size = 0;
+    bool failed = false;  // the read of this block failed; nothing follows it
+  };
+
+  size_t depth_;
+  size_t block_bytes_;
+  int fd_ = -1;
+  size_t start_offset_ = 0;
+  std::vector<Slot> slots_;
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable filled_cv_;
+  std::condition_variable free_cv_;
+  size_t produced_ = 0;  // blocks published by the reader thread
+  size_t released_ = 0;  // blocks the caller has finished with
+  bool stop_ = false;
+
+  // Caller-side state
+  size_t taken_ = 0;
+  bool holding_ = false;
+  bool at_end_ = false;
+  bool failed_ = false;
+  size_t stalls_ = 0;
+  size_t inline_offset_ = 0;
+
+  void ReaderLoop();
+  size_t ReadBlock(char* dst, size_t offset, bool& failed) const;
+};
+
+}  // namespace backtester
@@ -1,20 +1,61 @@
-#include <fstream>
+#pragma once
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "../core/Types.h"
 #include "IDataReader.h"
 
 namespace backtester {
 
+// Uncompressed CSV source ("compression": "NONE"). The file is memory-mapped with
+// sequential / huge-page hints and read ahead in fixed windows, so every line is a view
+// straight into the page cache. With "parser": "simd" it parses whole windows through
+// ParseMboBlock and hands out events instead of lines.
 class CsvReader : public IDataReader {
  public:
-  CsvReader() = default;
+  explicit CsvReader(const DataSourceConfig& config) : config_(config) {}
   ~CsvReader();
+
+  CsvReader(const CsvReader&) = delete;
+  CsvReader& operator=(const CsvReader&) = delete;
+
   bool Open(const std::string& filename) override;
   void Close() override;
   bool ReadLine(std::string& line) override;
+  bool ReadLineView(std::string_view& line) override {
+    if (BT_UNLIKELY(pos_ >= size_)) return false;
+    const auto* nl = static_cast<const char*>(std::memchr(data_ + pos_, '\n', size_ - pos_));
+    const size_t end = nl ? static_cast<size_t>(nl - data_) : size_;
+    line = std::string_view(data_ + pos_, end - pos_);
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    pos_ = end + 1;
+    if (BT_UNLIKELY(pos_ >= next_readahead_)) ReadAhead();
+    return true;
+  }
+
+  bool ProducesEvents() const override { return config_.parser == CsvParser::SIMD; }
+  bool ReadEvent(MarketByOrderEvent& out) override { return ReadEvents({&out, 1}) == 1; }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override;
+  // Byte offset of a row
+  bool Seek(uint64_t position) override;
 
  private:
-  std::ifstream file_;
+  DataSourceConfig config_;
+  int fd_ = -1;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  size_t next_readahead_ = 0;
+
+  // Event mode only
+  std::vector<uint32_t> delims_;
+  std::vector<MarketByOrderEvent> events_;
+  size_t cursor_ = 0;
+
+  void ReadAhead();
+  bool ParseNextWindow();
 };
 
-}  // namespace backtester
\ No newline at end of file
+}  // namespace backtester
@@ -10,18 +10,22 @@
 #include <sstream>
 #include <vector>
 
+#include "BlockPrefetcher.h"
+
 namespace backtester {
 
 class CsvZstReader : public IDataReader {
  public:
-  CsvZstReader()
-      : dstream_(nullptr),
+  // Compressed input is read `prefetch_blocks` blocks ahead on a background thread; 0
+  // reads inline.
+  explicit CsvZstReader(size_t prefetch_blocks = BlockPrefetcher::kDefaultDepth)
+      : file_(prefetch_blocks),
+        dstream_(nullptr),
         output_pos_(0),
         output_size_(0),
         input_pos_(0),
         input_valid_size_(0),
         eof_reached_(false) {
-    input_buffer_.resize(input_buf_size);
     output_buffer_.resize(output_buf_size);
   }
 
@@ -29,19 +33,26 @@ class CsvZstReader : public IDataReader {
   bool Open(const std::string& filename) override;
   void Close() override;
   bool ReadLine(std::string& line) override;
+  // Lines that fit in output_buffer_ are viewed in place; only a line straddling a
+  // refill is stitched together in carry_.
+  bool ReadLineView(std::string_view& line) override;
+  // Offset of a zstd frame that starts on a line boundary (see ReframeCsvZst)
+  bool Seek(uint64_t position) override;
+  bool Failed() const override { return file_.Failed(); }
 
  private:
-  std::ifstream file_;
+  std::string filename_;
+  BlockPrefetcher file_;
   ZSTD_DStream* dstream_;
-  std::vector<char> input_buffer_;
+  std::span<const char> input_block_;
   std::vector<char> output_buffer_;
+  std::string carry_;
   size_t output_pos_;
   size_t output_size_;
   size_t input_pos_;
   size_t input_valid_size_;
   bool eof_reached_;
 
-  size_t input_buf_size = ZSTD_DStreamInSize();
   size_t output_buf_size = ZSTD_DStreamOutSize();
 
   bool FillBuffer();
@@ -0,0 +1,23 @@
+#pragma once
+#include <memory>
+
+#include "../core/Types.h"
+#include "IDataReader.h"
+
+namespace backtester {
+
+// Builds the reader for one data stream from its encoding and compression (plus the
+// parser / decode_threads tuning for CSV). Returns nullptr, after logging why, when the
+// combination has no reader.
+//
+//   encoding  compression  reader
+//   CSV       ZSTD         CsvZstReader, SimdCsvZstReader or ParallelCsvZstReader
+//   CSV       NONE         CsvReader (mmap)
+//   DBN       ZSTD / NONE  DbnMboReader
+//   mbocache  (ignored)    MboCacheReader
+//
+// OHLCV and MBP-10 streams are CSV only and always get a line reader (CsvZstReader or
+// CsvReader). A source with several data_files gets a MultiFileReader over those readers.
+std::unique_ptr<IDataReader> MakeDataReader(const DataSourceConfig& source);
+
+}  // namespace backtester
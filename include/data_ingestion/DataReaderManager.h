@@ -1,67 +1,64 @@
 #pragma once
+#include <atomic>
+#include <memory>
+#include <span>
 #include <unordered_map>
 
 #include "../core/Constants.h"
 #include "../core/Event.h"
 #include "../core/Types.h"
-#include "CsvZstReader.h"
+#include "DataReaderFactory.h"
+#include "InstrumentFilter.h"
+#include "MboCsvParser.h"
+#include "Mbp10CsvParser.h"
+#include "OhlcvCsvParser.h"
 
 namespace backtester {
 class EventQueue;
+class EventArena;
 
 class DataReaderManager {
  public:
   DataReaderManager() = default;
 
-  bool RegisterAndInitStreams(const std::vector<DataSourceConfig>& file_paths);
-  bool LoadNextEventFromSource(uint16_t data_source_id, MarketByOrderEvent& out);
-
- private:
-  std::vector<DataStream> readers_;
+  // Sources held by `arena` are replayed from it instead of their data files. Call before
+  // RegisterAndInitStreams.
+  void UseArena(std::shared_ptr<const EventArena> arena) { arena_ = std::move(arena); }
 
-  bool ParseMboLineToEvent(const std::vector<backtester::DataStream>::iterator it,
-                           const std::string& line, MarketByOrderEvent& out);
+  // Sources with seek_to_start resume at the last recovery point before `start_time` in their
+  // timestamp index (see TimestampIndex.h); 0 replays every source from its first row.
+  bool RegisterAndInitStreams(const std::vector<DataSourceConfig>& file_paths,
+                              timestamp_t start_time = 0);
+  bool LoadNextEventFromSource(uint16_t data_source_id, MarketByOrderEvent& out);
+  // Fills as much of `out` as the source has and returns the count; 0 means end of data.
+  size_t LoadNextBatch(uint16_t data_source_id, std::span<MarketByOrderEvent> out);
+  // Same for any non-MBO source (OHLCV bars, MBP-10 level updates and actions). An MBP-10
+  // row is never split across calls, so a batch can come back up to
+  // Mbp10CsvDecoder::kMaxEventsPerRow - 1 short; `out` must hold at least that many.
+  size_t LoadNextMarketEvents(uint16_t data_source_id, std::span<EventUnion> out);
 
-  std::string_view GetNextToken(size_t& start_pos, std::string_view& current_view);
+  // Messages the source's instrument filter dropped so far
+  uint64_t SkippedMessages(uint16_t data_source_id) const;
 
-  // std::unique_ptr<Event> ParseOhlcvLineToEvent(  // TODO
-  //     const std::string& symbol,
-  //     const std::string& line
-  // );
+  // True once a source ended on a read error rather than at the end of its data. Sources may
+  // be read on threads of their own; a run checks this after they are done and writes no
+  // report over partial data.
+  bool Failed() const { return failed_.load(std::memory_order_acquire); }
 
-  inline OrderSide CharToOrderSide(char side) {
-    if (side == 'A') {
-      return OrderSide::kAsk;
-    }
-    if (side == 'B') {
-      return OrderSide::kBid;
-    } else {
-      return OrderSide::kNone;
-    }
-  }
+ private:
+  std::vector<DataStream> readers_;
+  std::shared_ptr<const EventArena> arena_;
+  std::vector<std::unique_ptr<Mbp10CsvDecoder>> mbp10_decoders_;  // parallel to readers_
+  std::vector<InstrumentFilter> filters_;                          // parallel to readers_
+  std::vector<int32_t> stream_by_id_;  // data_source_id -> index into readers_, -1 if none
+  std::atomic<bool> failed_{false};
 
-  inline EventType ActionToEventTyp(char act) {
-    if (act == 'A') {
-      return EventType::kMarketOrderAdd;
-    }
-    if (act == 'M') {
-      return EventType::kMarketOrderModify;
-    }
-    if (act == 'C') {
-      return EventType::kMarketOrderCancel;
-    }
-    if (act == 'R') {
-      return EventType::kMarketOrderClear;
-    }
-    if (act == 'T') {
-      return EventType::kMarketTrade;
-    }
-    if (act == 'F') {
-      return EventType::kMarketFill;
-    } else {
-      return EventType::kMarketNone;
-    }
+  DataStream* StreamFor(uint16_t data_source_id) {
+    if (BT_UNLIKELY(data_source_id >= stream_by_id_.size())) return nullptr;
+    const int32_t idx = stream_by_id_[data_source_id];
+    return idx < 0 ? nullptr : &readers_[static_cast<size_t>(idx)];
   }
+  void EndOfData(DataStream& stream);
 };
 
 }  // namespace backtester
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+#include "MboCsvParser.h"
+
+namespace backtester {
+
+//////////////////////////////////////////////////////////////
+///////////// MARK: Databento Binary Encoding (DBN)
+//////////////////////////////////////////////////////////////
+// ["DBN"][version u8][metadata length u32][metadata]
+// [record]... each record starts with DbnRecordHeader, whose `length` counts 4-byte words.
+//
+// Only what the MBO reader needs is declared here. Layouts are identical across DBN
+// versions 1-3 for MBO records; all integers are little-endian.
+
+inline constexpr char kDbnMagic[3] = {'D', 'B', 'N'};
+inline constexpr uint8_t kDbnMaxVersion = 3;
+inline constexpr size_t kDbnPreludeSize = 8;  // magic, version, metadata length
+inline constexpr uint8_t kDbnRtypeMbo = 0xA0;
+inline constexpr uint16_t kDbnSchemaMbo = 0;
+inline constexpr uint16_t kDbnSchemaMixed = 0xFFFF;
+inline constexpr size_t kDbnDatasetLen = 16;  // metadata: dataset[16] then schema u16
+inline constexpr int64_t kDbnUndefPrice = INT64_MAX;
+
+struct DbnRecordHeader {
+  uint8_t length;  // in 4-byte words
+  uint8_t rtype;
+  uint16_t publisher_id;
+  uint32_t instrument_id;
+  uint64_t ts_event;
+};
+
+struct DbnMboMsg {
+  DbnRecordHeader hd;
+  uint64_t order_id;
+  int64_t price;  // 1e-9 units, same scale as price_t
+  uint32_t size;
+  uint8_t flags;
+  uint8_t channel_id;
+  char action;
+  char side;
+  uint64_t ts_recv;
+  int32_t ts_in_delta;
+  uint32_t sequence;
+};
+
+static_assert(sizeof(DbnRecordHeader) == 16);
+static_assert(sizeof(DbnMboMsg) == 56);
+static_assert(offsetof(DbnMboMsg, ts_recv) == 40);
+
+// Same field mapping as ParseMboLine, so a DBN file and its CSV export replay identically.
+inline void DecodeDbnMbo(const DbnMboMsg& msg, uint16_t data_source_id, MarketByOrderEvent& out) {
+  const EventType action = ActionToEventTyp(msg.action);
+  out = {
+      .header = {.timestamp = msg.hd.ts_event, .type = action},
+      .ts_recv = msg.ts_recv,
+      .order_id = msg.order_id,
+      .price = (action == EventType::kMarketOrderClear) ? 0 : msg.price,
+      .size = msg.size,
+      .sequence = msg.sequence,
+      .instrument_id = msg.hd.instrument_id,
+      .ts_in_delta = msg.ts_in_delta,
+      .data_source_id = data_source_id,
+      .publisher_id = msg.hd.publisher_id,
+      .side = CharToOrderSide(msg.side),
+      .flags = msg.flags,
+  };
+}
+
+}  // namespace backtester
@@ -0,0 +1,60 @@
+#pragma once
+#include <zstd.h>
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../core/Types.h"
+#include "BlockPrefetcher.h"
+#include "DbnFormat.h"
+#include "IDataReader.h"
+
+namespace backtester {
+
+// Reads Databento's native DBN encoding (zstd-compressed or raw, per the stream's
+// `compression`) and decodes MBO records straight into MarketByOrderEvent. Records of any
+// other rtype (system, symbol mapping, ...) are skipped and counted.
+class DbnMboReader : public IDataReader {
+ public:
+  explicit DbnMboReader(const DataSourceConfig& config)
+      : config_(config), file_(config.prefetch_blocks) {}
+  ~DbnMboReader();
+
+  DbnMboReader(const DbnMboReader&) = delete;
+  DbnMboReader& operator=(const DbnMboReader&) = delete;
+
+  bool Open(const std::string& filename) override;
+  void Close() override;
+  bool ReadLine(std::string& /*line*/) override { return false; }
+
+  bool ProducesEvents() const override { return true; }
+  bool ReadEvent(MarketByOrderEvent& out) override { return ReadEvents({&out, 1}) == 1; }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override;
+  bool Failed() const override { return file_.Failed(); }
+
+  uint8_t Version() const { return version_; }
+  uint64_t SkippedRecords() const { return skipped_; }
+
+ private:
+  DataSourceConfig config_;
+  BlockPrefetcher file_;
+  ZSTD_DStream* dstream_ = nullptr;  // null for uncompressed files
+  std::span<const char> input_;
+  size_t input_pos_ = 0;
+  size_t input_size_ = 0;
+  bool eof_ = true;
+
+  std::vector<char> buffer_;  // decoded DBN bytes, [begin_, end_) unread
+  size_t begin_ = 0;
+  size_t end_ = 0;
+
+  uint8_t version_ = 0;
+  uint64_t skipped_ = 0;
+
+  size_t Available() const { return end_ - begin_; }
+  bool Fill(size_t min_bytes);
+  size_t ReadRaw(char* dst, size_t capacity);
+};
+
+}  // namespace backtester
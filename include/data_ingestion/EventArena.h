@@ -0,0 +1,87 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../core/Types.h"
+#include "IDataReader.h"
+#include "MboCacheReader.h"
+
+namespace backtester {
+
+// Decoded MBO events of a config's sources, decoded once and replayed by any number of
+// backtests. In memory the arena is shared by the runs of one process (see Build); under a
+// tmpfs directory such as /dev/shm it is a set of MBO cache files that sibling processes map
+// read-only (see BuildShared / OpenShared). Events are decoded through DataReaderManager, so
+// instrument filters and seek_to_start apply as they would to a direct read. OHLCV and
+// MBP-10 sources are not held and keep reading their files.
+class EventArena {
+ public:
+  // Decodes every MBO source into memory.
+  static std::shared_ptr<const EventArena> Build(const std::vector<DataSourceConfig>& sources,
+                                                 timestamp_t start_time = 0);
+
+  // Writes every MBO source to `dir` as an MBO cache, named after the source's files and
+  // decode settings so a changed file or setting gets a new arena. Sources already there
+  // are not decoded again. Returns the mapped arena, nullptr on failure.
+  static std::shared_ptr<const EventArena> BuildShared(const std::vector<DataSourceConfig>& sources,
+                                                       const std::string& dir,
+                                                       timestamp_t start_time = 0);
+
+  // Maps the arena files BuildShared left in `dir`. Sources without one are left out and
+  // read from their data files as usual.
+  static std::shared_ptr<const EventArena> OpenShared(const std::vector<DataSourceConfig>& sources,
+                                                      const std::string& dir,
+                                                      timestamp_t start_time = 0);
+
+  // <dir>/bt-arena-<source name>-<hash of files, sizes, mtimes and decode settings>.bin
+  static std::string SharedPathFor(const DataSourceConfig& source, const std::string& dir,
+                                   timestamp_t start_time);
+
+  bool Contains(uint16_t data_source_id) const;
+  std::span<const MarketByOrderEvent> Events(uint16_t data_source_id) const;
+  size_t SourceCount() const { return sources_.size(); }
+
+ private:
+  struct Source {
+    uint16_t data_source_id;
+    std::vector<MarketByOrderEvent> events;  // in-memory arena
+    std::unique_ptr<MboCacheReader> mapped;  // shared arena
+    std::span<const MarketByOrderEvent> view;
+  };
+  std::vector<Source> sources_;
+};
+
+// Replays one source's slice of an EventArena. The arena must outlive the reader.
+class ArenaReader : public IDataReader {
+ public:
+  explicit ArenaReader(std::span<const MarketByOrderEvent> events) : events_(events) {}
+
+  bool Open(const std::string& /*filename*/) override {
+    pos_ = 0;
+    return true;
+  }
+  void Close() override { pos_ = events_.size(); }
+  bool ReadLine(std::string& /*line*/) override { return false; }
+
+  bool ProducesEvents() const override { return true; }
+  bool ReadEvent(MarketByOrderEvent& out) override {
+    if (BT_UNLIKELY(pos_ >= events_.size())) return false;
+    out = events_[pos_++];
+    return true;
+  }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override {
+    const size_t n = std::min(out.size(), events_.size() - pos_);
+    std::memcpy(out.data(), events_.data() + pos_, n * sizeof(MarketByOrderEvent));
+    pos_ += n;
+    return n;
+  }
+
+ private:
+  std::span<const MarketByOrderEvent> events_;
+  size_t pos_ = 0;
+};
+
+}  // namespace backtester
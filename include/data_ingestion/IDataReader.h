@@ -1,9 +1,46 @@
 #pragma once
+#include <span>
 #include <string>
+#include <string_view>
+
+#include "../core/Event.h"
 class IDataReader {
  public:
     virtual ~IDataReader() = default;
     virtual bool Open(const std::string& filename) = 0;
     virtual void Close() = 0;
     virtual bool ReadLine(std::string& line) = 0; 
-};
\ No newline at end of file
+
+    // Next line without its line ending, viewing the reader's own buffer; valid until the
+    // next read. Readers without one fall back to ReadLine into a scratch string.
+    virtual bool ReadLineView(std::string_view& line) {
+      if (!ReadLine(line_scratch_)) return false;
+      line = line_scratch_;
+      return true;
+    }
+
+    // Binary readers hand out decoded events directly; text readers keep the defaults
+    // and are parsed line by line in DataReaderManager.
+    virtual bool ProducesEvents() const { return false; }
+    virtual bool ReadEvent(MarketByOrderEvent& /*out*/) { return false; }
+
+    // Fills up to out.size() events and returns how many, 0 once the data is exhausted.
+    // Readers with decoded events already in memory override this with a bulk copy.
+    virtual size_t ReadEvents(std::span<MarketByOrderEvent> out) {
+      size_t n = 0;
+      while (n < out.size() && ReadEvent(out[n])) ++n;
+      return n;
+    }
+
+    // Moves to a TimestampIndex position: a byte offset, zstd frame offset or record number
+    // depending on the file (see IndexPosition). Readers that cannot seek, or that do not
+    // recognise the position, return false and are left where they were.
+    virtual bool Seek(uint64_t /*position*/) { return false; }
+
+    // True when reading stopped on an error rather than at the end of the data. Readers
+    // report such an error as end of data, so whoever sees the end checks this first.
+    virtual bool Failed() const { return false; }
+
+ private:
+    std::string line_scratch_;
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../core/Types.h"
+
+namespace backtester {
+
+// CSV column holding instrument_id (see the expected headers in Constants.h)
+inline constexpr size_t kMboInstrumentColumn = 4;  // MBO and MBP-10
+inline constexpr size_t kOhlcvInstrumentColumn = 3;
+
+inline size_t InstrumentColumnFor(DataSchema schema) {
+  return schema == DataSchema::OHLCV ? kOhlcvInstrumentColumn : kMboInstrumentColumn;
+}
+
+// Reads the instrument_id of a CSV row without tokenizing the rest of it. False if the row
+// has fewer columns or the field is not a number.
+inline bool PeekInstrumentId(std::string_view row, size_t column, uint32_t& id) {
+  size_t pos = 0;
+  for (size_t c = 0; c < column; ++c) {
+    pos = row.find(',', pos);
+    if (pos == std::string_view::npos) return false;
+    ++pos;
+  }
+  uint32_t value = 0;
+  size_t i = pos;
+  for (; i < row.size() && row[i] >= '0' && row[i] <= '9'; ++i) {
+    value = value * 10 + static_cast<uint32_t>(row[i] - '0');
+  }
+  if (i == pos) return false;
+  id = value;
+  return true;
+}
+
+// Drops messages for instruments a source does not trade: text rows before they are parsed,
+// decoded events before they are queued. Counts what it drops. An empty id list keeps
+// everything.
+class InstrumentFilter {
+ public:
+  InstrumentFilter() = default;
+  explicit InstrumentFilter(std::vector<uint32_t> ids) : ids_(std::move(ids)) {
+    std::sort(ids_.begin(), ids_.end());
+    ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+  }
+
+  bool Enabled() const { return !ids_.empty(); }
+
+  bool Accepts(uint32_t id) const {
+    // A source usually trades a handful of instruments; a scan beats the binary search
+    if (ids_.size() <= 8) return std::find(ids_.begin(), ids_.end(), id) != ids_.end();
+    return std::binary_search(ids_.begin(), ids_.end(), id);
+  }
+
+  // Rows whose instrument_id cannot be read are kept so the parser reports them.
+  bool AcceptsRow(std::string_view row, size_t column) {
+    uint32_t id;
+    if (!Enabled() || !PeekInstrumentId(row, column, id) || Accepts(id)) return true;
+    ++skipped_;
+    return false;
+  }
+
+  // Compacts `events` down to the accepted ones in order and returns how many are left.
+  template <typename Event>
+  size_t Keep(std::span<Event> events) {
+    if (!Enabled()) return events.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (Accepts(events[i].instrument_id)) {
+        if (kept != i) events[kept] = events[i];
+        ++kept;
+      }
+    }
+    skipped_ += events.size() - kept;
+    return kept;
+  }
+
+  uint64_t Skipped() const { return skipped_; }
+
+ private:
+  std::vector<uint32_t> ids_;  // sorted
+  uint64_t skipped_ = 0;
+};
+
+}  // namespace backtester
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "../core/Event.h"
+
+namespace backtester {
+
+//////////////////////////////////////////////////////////////
+///////////// MARK: MBO Cache File Layout
+//////////////////////////////////////////////////////////////
+// [MboCacheHeader][pad to kMboCacheRecordsOffset]
+// [MarketByOrderEvent x record_count]
+// [MboCacheIndexEntry x instrument_count][MboCacheIndexEntry x publisher_count]
+//
+// Records are raw MarketByOrderEvent structs with their padding zeroed, so the file is
+// only portable between builds that agree on the struct layout (checked via record_size
+// and version). The checksum covers the records and both index tables.
+
+inline constexpr char kMboCacheMagic[8] = {'B', 'T', 'M', 'B', 'O', 'C', 'A', 'C'};
+inline constexpr uint32_t kMboCacheVersion = 1;
+inline constexpr uint64_t kMboCacheRecordsOffset = 128;
+
+struct MboCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t record_count;
+  uint64_t records_offset;
+  uint64_t index_offset;
+  uint32_t instrument_count;
+  uint32_t publisher_count;
+  uint64_t first_ts;
+  uint64_t last_ts;
+  uint64_t checksum;
+};
+
+struct MboCacheIndexEntry {
+  uint32_t id;  // instrument_id or publisher_id
+  uint32_t reserved;
+  uint64_t record_count;
+};
+
+static_assert(sizeof(MboCacheHeader) <= kMboCacheRecordsOffset);
+static_assert(sizeof(MarketByOrderEvent) % sizeof(uint64_t) == 0);
+static_assert(sizeof(MboCacheIndexEntry) % sizeof(uint64_t) == 0);
+
+// FNV-1a folded over 64-bit words; every section of the file is a multiple of 8 bytes.
+inline constexpr uint64_t kMboChecksumSeed = 14695981039346656037ULL;
+
+inline uint64_t MboCacheChecksum(const void* data, size_t bytes, uint64_t seed) {
+  constexpr uint64_t kPrime = 1099511628211ULL;
+  const auto* p = static_cast<const unsigned char*>(data);
+  uint64_t h = seed;
+  for (size_t i = 0; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, p + i, sizeof(word));
+    h = (h ^ word) * kPrime;
+  }
+  return h;
+}
+
+// ES-glbx-20251105.mbo.csv.zst -> ES-glbx-20251105.mbo.bin
+inline std::string MboCachePathFor(const std::string& data_filepath) {
+  static const std::string kCsvZst = ".csv.zst";
+  if (data_filepath.size() > kCsvZst.size() &&
+      data_filepath.compare(data_filepath.size() - kCsvZst.size(), kCsvZst.size(), kCsvZst) == 0) {
+    return data_filepath.substr(0, data_filepath.size() - kCsvZst.size()) + ".bin";
+  }
+  return data_filepath + ".bin";
+}
+
+}  // namespace backtester
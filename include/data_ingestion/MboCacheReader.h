@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string>
+
+#include "../core/Types.h"
+#include "IDataReader.h"
+#include "MboCacheFormat.h"
+
+namespace backtester {
+
+// Memory-maps a cache file written by MboCacheWriter and hands out its records with no
+// parsing. Open() validates the header and, unless disabled, the checksum.
+class MboCacheReader : public IDataReader {
+ public:
+  explicit MboCacheReader(bool verify_checksum = true) : verify_checksum_(verify_checksum) {}
+  ~MboCacheReader();
+
+  MboCacheReader(const MboCacheReader&) = delete;
+  MboCacheReader& operator=(const MboCacheReader&) = delete;
+
+  bool Open(const std::string& filename) override;
+  void Close() override;
+  bool ReadLine(std::string& /*line*/) override { return false; }
+
+  bool ProducesEvents() const override { return true; }
+  bool ReadEvent(MarketByOrderEvent& out) override {
+    if (BT_UNLIKELY(pos_ >= records_.size())) return false;
+    out = records_[pos_++];
+    return true;
+  }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override {
+    const size_t n = std::min(out.size(), records_.size() - pos_);
+    std::memcpy(out.data(), records_.data() + pos_, n * sizeof(MarketByOrderEvent));
+    pos_ += n;
+    return n;
+  }
+  // Record number
+  bool Seek(uint64_t position) override {
+    if (position > records_.size()) return false;
+    pos_ = position;
+    return true;
+  }
+
+  const MboCacheHeader& Header() const { return header_; }
+  std::span<const MarketByOrderEvent> Events() const { return records_; }
+  std::span<const MboCacheIndexEntry> InstrumentIndex() const { return instruments_; }
+  std::span<const MboCacheIndexEntry> PublisherIndex() const { return publishers_; }
+
+ private:
+  bool verify_checksum_;
+  int fd_ = -1;
+  void* map_ = nullptr;
+  size_t map_size_ = 0;
+  size_t pos_ = 0;
+
+  MboCacheHeader header_{};
+  std::span<const MarketByOrderEvent> records_;
+  std::span<const MboCacheIndexEntry> instruments_;
+  std::span<const MboCacheIndexEntry> publishers_;
+
+  bool Validate(const std::string& filename);
+};
+
+}  // namespace backtester
@@ -0,0 +1,36 @@
+#pragma once
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "../core/Event.h"
+#include "MboCacheFormat.h"
+
+namespace backtester {
+
+// Streams MarketByOrderEvents into the packed cache format read by MboCacheReader.
+// Records are written as they arrive; the header and index tables are patched in
+// Finalize() once the totals and checksum are known.
+class MboCacheWriter {
+ public:
+  MboCacheWriter() = default;
+  ~MboCacheWriter();
+
+  bool Open(const std::string& filename);
+  bool Append(const MarketByOrderEvent& event);
+  bool Finalize();
+
+  uint64_t RecordCount() const { return header_.record_count; }
+
+ private:
+  std::ofstream file_;
+  std::string filename_;
+  MboCacheHeader header_{};
+  uint64_t checksum_ = kMboChecksumSeed;
+  std::map<uint32_t, uint64_t> instrument_counts_;
+  std::map<uint32_t, uint64_t> publisher_counts_;
+
+  bool WriteIndex(const std::map<uint32_t, uint64_t>& counts);
+};
+
+}  // namespace backtester
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+
+namespace backtester {
+
+// Parses one Databento MBO CSV row (kExpectedMboHeader column order) into `out`.
+// Stateless, so reader threads and decode workers can call it concurrently.
+bool ParseMboLine(std::string_view line, const DataSourceConfig& config, MarketByOrderEvent& out);
+
+// Parses every complete row of `block` (anything after the last '\n' is left alone) and
+// appends the events to `out`, returning the number of bytes consumed. Delimiters for the
+// whole block are found in one SIMD pass (utils/SimdScan.h) and numeric fields are parsed
+// in place, so no per-row string is built. `delims` is scratch reused across calls.
+// Blank rows are skipped; anything else matches ParseMboLine field for field. A row with a
+// numeric field that is not plain digits in range of its type is parsed by ParseMboLine.
+size_t ParseMboBlock(std::string_view block, const DataSourceConfig& config,
+                     std::vector<uint32_t>& delims, std::vector<MarketByOrderEvent>& out);
+
+std::string_view GetNextToken(size_t& start_pos, std::string_view current_view);
+
+inline OrderSide CharToOrderSide(char side) {
+  if (side == 'A') {
+    return OrderSide::kAsk;
+  }
+  if (side == 'B') {
+    return OrderSide::kBid;
+  } else {
+    return OrderSide::kNone;
+  }
+}
+
+inline EventType ActionToEventTyp(char act) {
+  if (act == 'A') {
+    return EventType::kMarketOrderAdd;
+  }
+  if (act == 'M') {
+    return EventType::kMarketOrderModify;
+  }
+  if (act == 'C') {
+    return EventType::kMarketOrderCancel;
+  }
+  if (act == 'R') {
+    return EventType::kMarketOrderClear;
+  }
+  if (act == 'T') {
+    return EventType::kMarketTrade;
+  }
+  if (act == 'F') {
+    return EventType::kMarketFill;
+  } else {
+    return EventType::kMarketNone;
+  }
+}
+
+}  // namespace backtester
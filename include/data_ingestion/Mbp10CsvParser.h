@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+
+namespace backtester {
+
+// Turns Databento MBP-10 CSV rows (kExpectedMBP10Header column order) into events for a
+// fixed-depth level book. Each row yields one MarketLevelEvent for every (side, depth) slot
+// that differs from the previous row of the same instrument and publisher, followed by the
+// row's action as a MarketByOrderEvent with order_id 0. A trade row is also repeated as a
+// fill on the resting side, which is what the queue-position fill model drains on with MBO.
+// Stateful (it remembers the last levels per book), so use one decoder per stream.
+class Mbp10CsvDecoder {
+ public:
+  static constexpr size_t kMaxEventsPerRow = 2 * kMbp10Depth + 2;
+
+  explicit Mbp10CsvDecoder(const DataSourceConfig& config);
+
+  // Decodes one row into `out` and returns the number of events written; 0 for a blank row.
+  size_t DecodeLine(std::string_view line, std::span<EventUnion, kMaxEventsPerRow> out);
+
+ private:
+  struct Levels {
+    std::array<PriceLevel, kMbp10Depth> bids{};
+    std::array<PriceLevel, kMbp10Depth> asks{};
+  };
+
+  PriceFormat price_format_;
+  TmStampFormat ts_format_;
+  uint16_t data_source_id_;
+  std::unordered_map<uint64_t, Levels> last_levels_;  // (instrument_id << 16) | publisher_id
+};
+
+}  // namespace backtester
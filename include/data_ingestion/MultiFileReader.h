@@ -0,0 +1,66 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Types.h"
+#include "IDataReader.h"
+
+namespace backtester {
+
+// Reads the files of one multi-file source (DataSourceConfig::data_files, e.g. one file per
+// trading day) back to back as if they were one stream. Each file gets the reader
+// MakeDataReader would give it alone. While one file drains, the next one is opened on a
+// background thread and, for text files, read up to its first line, so its first blocks are
+// already read and decompressed when the switch happens. Text files must all start with
+// the header of the first one; the repeated headers are dropped. A later file that will not
+// open or whose header differs, or a file whose read fails, ends the stream there with
+// Failed() set.
+class MultiFileReader : public IDataReader {
+ public:
+  explicit MultiFileReader(const DataSourceConfig& source);
+  ~MultiFileReader() override;
+
+  // Starts the walk at `filename`, which must be one of the source's files.
+  bool Open(const std::string& filename) override;
+  void Close() override;
+  bool ReadLine(std::string& line) override;
+  bool ReadLineView(std::string_view& line) override;
+
+  bool ProducesEvents() const override { return produces_events_; }
+  bool ReadEvent(MarketByOrderEvent& out) override;
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override;
+  // Seeks within the current file
+  bool Seek(uint64_t position) override { return current_ && current_->Seek(position); }
+  bool Failed() const override { return failed_; }
+
+  size_t FileIndex() const { return file_idx_; }
+  // File switches where the next file was not ready yet and the caller had to wait
+  size_t Stalls() const { return stalls_; }
+
+ private:
+  struct OpenedFile {
+    std::unique_ptr<IDataReader> reader;
+    std::string first_line;  // text files only; the header
+  };
+
+  DataSourceConfig source_;
+  std::vector<std::string> files_;
+  bool produces_events_ = false;
+
+  std::unique_ptr<IDataReader> current_;
+  std::string header_;
+  bool replay_header_ = false;  // hand out the first file's header once
+  size_t file_idx_ = 0;
+  std::future<OpenedFile> next_;
+  size_t stalls_ = 0;
+  bool failed_ = false;
+
+  static OpenedFile OpenFile(DataSourceConfig source, const std::string& path);
+  void PrefetchNext();
+  bool AdvanceFile();
+  bool Fail(const std::string& why);
+};
+
+}  // namespace backtester
@@ -0,0 +1,13 @@
+#pragma once
+#include <string_view>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+
+namespace backtester {
+
+// Parses one Databento OHLCV CSV row (kExpectedOhlcvHeader column order) into `out`. The
+// bar is stamped at ts_event + config.bar_interval_ns, i.e. when it closed. Stateless.
+bool ParseOhlcvLine(std::string_view line, const DataSourceConfig& config, OhlcvBarEvent& out);
+
+}  // namespace backtester
@@ -0,0 +1,100 @@
+#pragma once
+#include <zstd.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../core/Types.h"
+#include "IDataReader.h"
+#include "ZstdFraming.h"
+
+namespace backtester {
+
+// Decodes and parses a multi-frame .csv.zst on a pool of worker threads, one frame per
+// task, and hands the events back in file order. Lines that straddle a frame boundary
+// are stitched together by the consuming thread. Files with a single frame gain nothing
+// here; ReframeCsvZst (or pzstd) splits them first.
+class ParallelCsvZstReader : public IDataReader {
+ public:
+  ParallelCsvZstReader(const DataSourceConfig& config, unsigned threads);
+  ~ParallelCsvZstReader();
+
+  ParallelCsvZstReader(const ParallelCsvZstReader&) = delete;
+  ParallelCsvZstReader& operator=(const ParallelCsvZstReader&) = delete;
+
+  bool Open(const std::string& filename) override;
+  void Close() override;
+  bool ReadLine(std::string& /*line*/) override { return false; }
+
+  bool ProducesEvents() const override { return true; }
+  bool ReadEvent(MarketByOrderEvent& out) override {
+    while (true) {
+      if (has_stitched_) {
+        has_stitched_ = false;
+        out = stitched_;
+        return true;
+      }
+      if (BT_LIKELY(cursor_ < current_.size())) {
+        out = current_[cursor_++];
+        return true;
+      }
+      if (!NextChunk()) return false;
+    }
+  }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override;
+  // Offset of a frame that starts on a line boundary; decoding restarts at that frame.
+  bool Seek(uint64_t position) override;
+
+  size_t FrameCount() const { return frames_.size(); }
+
+ private:
+  struct Chunk {
+    std::string head;  // bytes before the first '\n' (end of the previous chunk's last line)
+    std::string tail;  // bytes after the last '\n' (start of the next chunk's first line)
+    std::vector<MarketByOrderEvent> events;  // every complete line in between
+    std::exception_ptr error;
+    bool has_newline = false;
+    bool ready = false;
+  };
+
+  DataSourceConfig config_;
+  unsigned thread_count_;
+  size_t window_;  // chunks decoded ahead of the consumer
+
+  int fd_ = -1;
+  void* map_ = nullptr;
+  size_t map_size_ = 0;
+  std::vector<ZstdFrameSpan> frames_;
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable ready_cv_;
+  std::vector<Chunk> slots_;
+  size_t next_dispatch_ = 0;
+  size_t next_emit_ = 0;
+  bool stop_ = false;
+
+  // Consumer-side state
+  std::vector<MarketByOrderEvent> current_;
+  size_t cursor_ = 0;
+  std::string carry_;
+  MarketByOrderEvent stitched_{};
+  bool has_stitched_ = false;
+  bool header_pending_ = true;
+
+  bool NextChunk();
+  bool VerifyHeader();
+  void StartWorkers();
+  void StopWorkers();
+  void WorkerLoop();
+  void DecodeChunk(ZSTD_DCtx* dctx, const ZstdFrameSpan& frame, std::string& text,
+                   std::vector<uint32_t>& delims, Chunk& out) const;
+  bool ParseStitched(std::string_view line);
+};
+
+}  // namespace backtester
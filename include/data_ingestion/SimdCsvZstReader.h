@@ -0,0 +1,62 @@
+#pragma once
+#include <zstd.h>
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../core/Types.h"
+#include "BlockPrefetcher.h"
+#include "IDataReader.h"
+
+namespace backtester {
+
+// Streaming .csv.zst reader that parses whole decompressed blocks with ParseMboBlock
+// instead of handing out one std::string per row. Selected with "parser": "simd".
+class SimdCsvZstReader : public IDataReader {
+ public:
+  explicit SimdCsvZstReader(const DataSourceConfig& config)
+      : config_(config), file_(config.prefetch_blocks) {}
+  ~SimdCsvZstReader();
+
+  SimdCsvZstReader(const SimdCsvZstReader&) = delete;
+  SimdCsvZstReader& operator=(const SimdCsvZstReader&) = delete;
+
+  bool Open(const std::string& filename) override;
+  void Close() override;
+  bool ReadLine(std::string& /*line*/) override { return false; }
+
+  bool ProducesEvents() const override { return true; }
+  bool ReadEvent(MarketByOrderEvent& out) override {
+    if (BT_UNLIKELY(cursor_ >= events_.size()) && !Refill()) return false;
+    out = events_[cursor_++];
+    return true;
+  }
+  size_t ReadEvents(std::span<MarketByOrderEvent> out) override;
+  // Offset of a zstd frame that starts on a line boundary (see ReframeCsvZst)
+  bool Seek(uint64_t position) override;
+  bool Failed() const override { return file_.Failed(); }
+
+ private:
+  DataSourceConfig config_;
+  std::string filename_;
+  BlockPrefetcher file_;
+  ZSTD_DStream* dstream_ = nullptr;
+  std::span<const char> input_;
+  size_t input_pos_ = 0;
+  size_t input_size_ = 0;
+  bool input_eof_ = false;
+
+  std::vector<char> text_;  // decompressed bytes, [text_begin_, text_end_) not yet parsed
+  size_t text_begin_ = 0;
+  size_t text_end_ = 0;
+
+  std::vector<uint32_t> delims_;
+  std::vector<MarketByOrderEvent> events_;
+  size_t cursor_ = 0;
+
+  bool Decompress();
+  bool Refill();
+};
+
+}  // namespace backtester
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../core/Types.h"
+
+namespace backtester {
+
+//////////////////////////////////////////////////////////////
+///////////// MARK: Timestamp Index File Layout
+//////////////////////////////////////////////////////////////
+// [TimestampIndexHeader][TimestampIndexEntry x entry_count]
+//
+// Sparse map from event time to places a reader can resume from, written next to a data
+// file as <data file>.tsidx by the 'index' mode. Entries are in file order. One is recorded
+// at the first row of every interval_ns of event time and at every recovery point: a row
+// from which a replay ends up with the same books as a replay of the whole file.
+//  - MBO: the first clear of a timestamp at which every book seen so far is cleared, i.e.
+//    the start of a full snapshot. A feed with one book recovers at every clear.
+//  - MBP-10 / OHLCV: an interval entry once every book seen before it has had a row since.
+//    An MBP-10 row carries all ten levels and a bar replaces the last one, so each book is
+//    whole again at its first row after the seek. The recovery entry's ts is that of the row
+//    that completed it, which can be later than the interval entry for the same row.
+//
+// `position` is what IDataReader::Seek takes for the file (see IndexPosition); after the
+// seek, `skip_rows` rows are read and dropped to reach the entry's row. Position 0 is the
+// first row after the header: no seek, only the skip.
+
+inline constexpr char kTimestampIndexMagic[8] = {'B', 'T', 'T', 'S', 'I', 'D', 'X', '\0'};
+inline constexpr uint32_t kTimestampIndexVersion = 2;
+inline constexpr timestamp_t kDefaultIndexIntervalNs = 60'000'000'000;  // one minute
+
+enum class IndexPosition : uint32_t {
+  kByteOffset = 0,   // plain CSV: byte offset of the row
+  kFrameOffset = 1,  // .csv.zst: offset of a zstd frame that starts on a row
+  kRecord = 2,       // MBO cache: record number
+};
+
+inline constexpr uint8_t kIndexInterval = 1;
+inline constexpr uint8_t kIndexRecovery = 2;
+
+struct TimestampIndexHeader {
+  char magic[8];
+  uint32_t version;
+  IndexPosition position_kind;
+  uint64_t interval_ns;
+  uint64_t data_size;   // size and modification time of the indexed file; a mismatch in
+  int64_t data_mtime;   // either means the index is stale
+  uint64_t entry_count;
+};
+
+struct TimestampIndexEntry {
+  timestamp_t ts;
+  uint64_t position;
+  uint32_t skip_rows;
+  uint8_t flags;  // kIndexInterval | kIndexRecovery
+  uint8_t reserved[3];
+};
+
+static_assert(sizeof(TimestampIndexHeader) == 48);
+static_assert(sizeof(TimestampIndexEntry) == 24);
+
+// ES-glbx-20251105.mbo.csv.zst -> ES-glbx-20251105.mbo.csv.zst.tsidx
+std::string TimestampIndexPathFor(const std::string& data_filepath);
+
+// How positions are expressed for the source's files; nullopt for formats with no index
+// (DBN, JSON).
+std::optional<IndexPosition> IndexPositionFor(const DataSourceConfig& source);
+
+// Reads `data_filepath` (one file of `source`) once and writes its index. A single-frame
+// .csv.zst can only be resumed from its start, so it is worth running 'reframe' first.
+bool BuildTimestampIndex(const DataSourceConfig& source, const std::string& data_filepath,
+                         timestamp_t interval_ns = kDefaultIndexIntervalNs);
+
+class TimestampIndex {
+ public:
+  // Fails, with a warning, if the file is missing, malformed, for another kind of position,
+  // or older than a change to `data_filepath`.
+  bool Load(const std::string& index_path, const std::string& data_filepath,
+            IndexPosition expected);
+
+  // Last recovery point strictly before `ts`, nullptr if there is none
+  const TimestampIndexEntry* RecoveryPointBefore(timestamp_t ts) const;
+
+  const TimestampIndexHeader& Header() const { return header_; }
+  std::span<const TimestampIndexEntry> Entries() const { return entries_; }
+
+ private:
+  TimestampIndexHeader header_{};
+  std::vector<TimestampIndexEntry> entries_;
+};
+
+}  // namespace backtester
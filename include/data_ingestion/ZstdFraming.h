@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace backtester {
+
+// Uncompressed bytes per frame written by ReframeCsvZst. Small enough that a handful of
+// frames are in flight per decode worker, large enough to amortize per-frame overhead.
+inline constexpr size_t kDefaultFrameBytes = size_t{4} << 20;
+
+struct ZstdFrameSpan {
+  size_t offset;
+  size_t size;
+};
+
+// Walks the frame headers of an in-memory zstd stream. Returns an empty vector if the
+// stream is malformed or truncated.
+std::vector<ZstdFrameSpan> ScanZstdFrames(const void* data, size_t size);
+
+// Frame count of a zstd file on disk, 0 if it cannot be read or is not valid zstd.
+size_t CountZstdFrames(const std::string& filename);
+
+// True if a zstd frame (not a skippable one) starts at byte `offset` of the file. Used to
+// check a seek target before restarting a decoder there.
+bool IsZstdFrameAt(const std::string& filename, size_t offset);
+
+// Rewrites a single-frame .csv.zst as independently decodable frames of roughly
+// `frame_bytes` uncompressed each, split on line boundaries, so ParallelCsvZstReader
+// can decode it on several threads.
+bool ReframeCsvZst(const std::string& in_path, const std::string& out_path,
+                   size_t frame_bytes = kDefaultFrameBytes);
+
+// ES-glbx-20251105.mbo.csv.zst -> ES-glbx-20251105.mbo.framed.csv.zst
+std::string FramedPathFor(const std::string& data_filepath);
+
+}  // namespace backtester
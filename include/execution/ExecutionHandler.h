@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <unordered_map>
 
 #include "../core/EventQueue.h"
@@ -21,6 +22,10 @@ constexpr qty_t ZERO_QUANTITY = 0;
 //   price. Optimistic assumption — useful as an upper-bound benchmark or for
 //   aggressive limit orders that are expected to be at/near TOB.
 
+// Bars: instruments fed by an OHLCV source have no book, so their orders skip both
+//   models above. A live order fills in full, at its limit price, on the first bar whose
+//   range reaches it (low <= bid price, high >= ask price).
+
 enum class FillModel { QueuePosition, TopOfBook };
 
 // ==================================================================================
@@ -80,6 +85,12 @@ class ExecutionHandler {
   // -------------------------------------------------------------------
   void OnMarketEvent(const MarketByOrderEvent& mbo_event);
 
+  // -------------------------------------------------------------------
+  // Called on every OHLCV bar, after MarketStateManager saw it. Marks
+  // the instrument as bar driven and fills orders the bar traded through.
+  // -------------------------------------------------------------------
+  void OnBarEvent(const OhlcvBarEvent& bar);
+
   // void ProcessGoLives(timestamp_t now, const MarketByOrderEvent* trigger);
   void CancelAllPendingOrders();
   // -------------------------------------------------------------------
@@ -98,6 +109,7 @@ class ExecutionHandler {
 
   std::vector<size_t> filled_idxs_;
   std::vector<PendingOrder> pending_orders_;
+  std::vector<uint32_t> bar_instruments_;  // instruments priced by bars, usually 0 or 1
 
   // -------------------------------------------------------------------
   // Order placement handlers
@@ -111,6 +123,7 @@ class ExecutionHandler {
   // -------------------------------------------------------------------
   void CheckFillsQueuePosition(timestamp_t now, const MarketByOrderEvent* mbo_event);
   void CheckFillsTopOfBook(timestamp_t now, const MarketByOrderEvent* mbo_event);
+  void CheckFillsBar(const OhlcvBarEvent& bar);
 
   // -------------------------------------------------------------------
   // Helpers
@@ -120,6 +133,12 @@ class ExecutionHandler {
 
   money_t GetCommissionsByInstr(uint32_t instrument_id, qty_t fill_qty);
 
+  inline bool IsBarDriven(uint32_t instrument_id) const {
+    return !bar_instruments_.empty() &&
+           std::find(bar_instruments_.begin(), bar_instruments_.end(), instrument_id) !=
+               bar_instruments_.end();
+  }
+
   void EmitFill(PendingOrder& order, int64_t fill_price, qty_t fill_qty, timestamp_t fill_ts);
 
   template <class Side>
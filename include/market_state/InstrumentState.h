@@ -1,4 +1,5 @@
 #pragma once
+#include "LevelBook.h"
 #include "OrderBook.h"
 
 namespace backtester {
@@ -12,6 +13,12 @@ class InstrumentState {
   uint32_t instrument_id;
 
   void OnMarketEvent(const MarketByOrderEvent& event);
+  // Book-free update from an aggregated bar: the close stands in for both sides of the BBO
+  // and for the last trade, so prices, equity and closing orders work without MBO data.
+  void OnBarEvent(const OhlcvBarEvent& bar);
+  // MBP-10 slot update. The first one switches the instrument to fixed-depth LevelBooks;
+  // its order events then only feed trades/VWAP and every book query reads the levels.
+  void OnLevelEvent(const MarketLevelEvent& level);
   inline const BidAskPair GetInstrumentBbo() const { return instrument_Bbo_; }
 
   const std::vector<BidAskPair> GetOBSnapshotByPub(uint16_t publisher_id,
@@ -26,18 +33,14 @@ class InstrumentState {
 
  private:
   std::vector<OrderBook> books_;
+  std::vector<LevelBook> level_books_;
+  bool level_driven_ = false;
   BidAskPair instrument_Bbo_;
   MarketSnapshot snapshot_;
   __int128_t cumulative_notional_ = 0;
 
   void UpdateInstrumentBbo();
-
-  const inline OrderBook* GetOrderBook(uint16_t publisher_id) const {
-    auto it = std::find_if(books_.begin(), books_.end(), [publisher_id](const OrderBook& ob) {
-      return publisher_id == ob.publisher_id;
-    });
-    return (it != books_.end()) ? &(*it) : nullptr;
-  }
+  void UpdateWmp();
 
   inline OrderBook& GetOrInsertOrderBook(uint16_t publisher_id) {
     auto it = std::find_if(books_.begin(), books_.end(), [publisher_id](const OrderBook& ob) {
@@ -51,6 +54,14 @@ class InstrumentState {
       return ob;
     }
   }
+
+  inline LevelBook& GetOrInsertLevelBook(uint16_t publisher_id) {
+    auto it = std::find_if(level_books_.begin(), level_books_.end(),
+                           [publisher_id](const LevelBook& lb) {
+                             return publisher_id == lb.publisher_id;
+                           });
+    return BT_LIKELY(it != level_books_.end()) ? *it : level_books_.emplace_back(publisher_id);
+  }
 };
 
 }  // namespace backtester
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <vector>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+
+namespace backtester {
+
+// Fixed-depth book for one publisher, rebuilt from MBP-10 level updates instead of
+// individual orders. Reads the same way as OrderBook (BBO, level by index or price,
+// snapshot) so InstrumentState can answer IMarketDataProvider from either one, at a few
+// hundred bytes per book instead of a full order table.
+class LevelBook {
+ public:
+  static constexpr std::size_t kDepth = kMbp10Depth;
+
+  LevelBook(uint16_t pub_id);
+  uint16_t publisher_id;
+  inline const BidAskPair GetBbo() const { return {bids_[0], asks_[0]}; }
+
+  PriceLevel GetBidLevel(std::size_t idx = 0) const;
+  PriceLevel GetAskLevel(std::size_t idx = 0) const;
+  PriceLevel GetLevelByPx(OrderSide side, int64_t price) const;
+
+  const std::vector<BidAskPair> GetSnapshot(std::size_t level_count = 1) const;
+  void Apply(const MarketLevelEvent& level);
+  void Clear();
+
+ private:
+  std::array<PriceLevel, kDepth> bids_{};
+  std::array<PriceLevel, kDepth> asks_{};
+};
+
+}  // namespace backtester
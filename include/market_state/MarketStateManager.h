@@ -14,6 +14,8 @@ class MarketStateManager : public IMarketDataProvider {
   void Initialize(const std::vector<uint32_t>& active_ids);
 
   void OnMarketEvent(const MarketByOrderEvent& event);
+  void OnBarEvent(const OhlcvBarEvent& bar);
+  void OnLevelEvent(const MarketLevelEvent& level);
 
   const BidAskPair GetInstrumentBbo(uint32_t instr_id) const;
   std::unordered_map<uint32_t, BidAskPair> GetTradedInstrsBbo();
@@ -109,7 +109,7 @@ class OrderBook {
  public:
   OrderBook(uint16_t pub_id);
   uint16_t publisher_id;
-  inline const BidAskPair GetBbo() { return bbo_cache_; }
+  inline const BidAskPair GetBbo() const { return bbo_cache_; }
   int64_t GetMidPrice() const;
 
   PriceLevel GetBidLevel(std::size_t idx = 0) const;
@@ -0,0 +1,102 @@
+#pragma once
+#include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/Event.h"
+#include "../core/Types.h"
+#include "IMarketDataProvider.h"
+
+namespace backtester {
+
+// Aggregated price levels published per side, one per tick out from the best price. As deep as
+// the execution handler walks (MAX_AGGREGATE_DEPTH), so fills match a run against the book.
+inline constexpr size_t kFrameDepth = 256;
+
+// Aggregated size and order count at one price of a ladder; the price follows from the index
+struct LadderLevel {
+  uint32_t size = 0;
+  uint32_t count = 0;
+};
+
+// Post-event state of one traded instrument, as a MarketStateManager would report it.
+struct InstrumentFrame {
+  MarketSnapshot snapshot;
+  uint16_t bid_levels = 0;  // bids[bid_levels..] are empty and left stale
+  uint16_t ask_levels = 0;
+  std::array<LadderLevel, kFrameDepth> bids;  // bids[i] = best bid - i ticks
+  std::array<LadderLevel, kFrameDepth> asks;  // asks[i] = best ask + i ticks
+};
+
+// One market event as broadcast by the book thread of a shared-market run, with the state of
+// its instrument after the book applied it when that instrument is traded.
+struct MarketFrame {
+  EventUnion event;
+  bool has_state = false;
+  InstrumentFrame state;
+};
+
+inline uint32_t MarketInstrumentId(const EventUnion& ev) {
+  switch (Hdr(ev).type) {
+    case EventType::kMarketBar:
+      return ev.bar.instrument_id;
+    case EventType::kMarketLevelUpdate:
+      return ev.level.instrument_id;
+    default:
+      return ev.mbo.instrument_id;
+  }
+}
+
+// Market data view of a strategy replica that does not build books itself. It keeps the
+// latest InstrumentFrame of every traded instrument and answers the IMarketDataProvider
+// queries from it, so strategies, execution and portfolio see the same prices they would
+// against the book. Limits: only traded instruments are known and per-publisher books are not
+// kept. A depth query further than kFrameDepth ticks from the best price throws rather than
+// answer differently from the book.
+class SnapshotMarketDataProvider : public IMarketDataProvider {
+ public:
+  explicit SnapshotMarketDataProvider(const std::vector<TradedInstrument>& traded);
+
+  void Apply(const MarketFrame& frame);
+
+  std::unordered_map<uint32_t, BidAskPair> GetTradedInstrsBbo() const;
+
+  // IMarketDataProvider methods
+  const std::vector<BidAskPair> GetOBSnapshotByPub(uint32_t instrument_id, uint16_t publisher_id,
+                                                   std::size_t level_count) const override;
+
+  int64_t GetQueueDepth(uint32_t instr_id, OrderSide side, int64_t price) const override;
+
+  void GetAggOBBidsSnapshot(uint32_t instrument_id, std::span<PriceLevel> levels) const override;
+  void GetAggOBAsksSnapshot(uint32_t instrument_id, std::span<PriceLevel> levels) const override;
+
+  const std::unordered_map<uint32_t, const MarketSnapshot*>& GetMarketSnapshots() const override {
+    return snapshots_;
+  }
+
+  const MarketSnapshot* GetSnapshotByInstr(uint32_t instr_id) const override;
+
+  // Fills `frame` with the current state of `instrument_id` from a book-building provider.
+  static void Capture(const IMarketDataProvider& book, uint32_t instrument_id,
+                      int64_t tick_size, InstrumentFrame& frame);
+
+ private:
+  struct Slot {
+    uint32_t instrument_id;
+    int64_t tick_size;
+    InstrumentFrame state;
+  };
+
+  const Slot* Find(uint32_t instr_id) const {
+    for (const auto& slot : slots_) {
+      if (slot.instrument_id == instr_id) return &slot;
+    }
+    return nullptr;
+  }
+
+  std::vector<Slot> slots_;  // a handful of traded instruments: a scan beats a map
+  std::unordered_map<uint32_t, const MarketSnapshot*> snapshots_;
+};
+
+}  // namespace backtester
@@ -100,9 +100,21 @@ class ReportGenerator {
   // -------------------------------------------------------------------
   void GenerateReport(const PortfolioManager& portfolio, std::vector<std::string> names);
 
+  // Same report from a trade list gathered elsewhere, e.g. stitched from per-day runs.
+  void GenerateReport(const std::vector<TradeRecord>& trades, std::vector<std::string> names);
+
+  // Overall summary computed by the last GenerateReport call.
+  const PerformanceSummary& Summary() const { return summary_; }
+
+  const std::vector<EquitySnapshot>& EquityCurve() const { return equity_curve_; }
+
+  // 1e9 fixed-point to a decimal string with 2 places
+  static std::string FormatScaledPrice(int64_t price);
+
  private:
   const AppConfig& config_;
   std::vector<EquitySnapshot> equity_curve_;
+  PerformanceSummary summary_;
 
   // Peak tracking for drawdown duration
   money_t peak_equity_ = 0;
@@ -112,10 +124,10 @@ class ReportGenerator {
   // -------------------------------------------------------------------
   // Metric Computation
   // -------------------------------------------------------------------
-  PerformanceSummary ComputeSummary(const PortfolioManager& portfolio) const;
+  PerformanceSummary ComputeSummary(const std::vector<TradeRecord>& trades) const;
 
   std::unordered_map<std::string, PerformanceSummary> ComputePerStrategySummary(
-      const PortfolioManager& portfolio, const std::vector<std::string>& names) const;
+      const std::vector<TradeRecord>& trades, const std::vector<std::string>& names) const;
 
   PerformanceSummary ComputeSummaryFromTrades(const std::vector<TradeRecord>& trades,
                                               money_t initial_capital, money_t final_equity) const;
@@ -144,7 +156,6 @@ class ReportGenerator {
   // Formatting Helpers
   // -------------------------------------------------------------------
   static std::string SideToString(OrderSide side);
-  static std::string FormatScaledPrice(int64_t price);
 };
 
 }  // namespace backtester
\ No newline at end of file
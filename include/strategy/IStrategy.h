@@ -12,6 +12,8 @@ class IStrategy {
   virtual ~IStrategy() = default;
   virtual void Initialize(const Strategy& config) = 0;
   virtual std::vector<StrategySignalEvent> OnMarketEvent(const MarketByOrderEvent& event) = 0;
+  // Called for every bar of an OHLCV source; strategies that only trade off MBO ignore it.
+  virtual std::vector<StrategySignalEvent> OnBarEvent(const OhlcvBarEvent& /*bar*/) { return {}; }
   virtual void OnFill(const StrategyFillEvent& fill) = 0;
   virtual void OnRejection(const StrategyOrderRejectionEvent& msg) = 0;
   virtual void OnEndOfDay(uint64_t timestamp) = 0;
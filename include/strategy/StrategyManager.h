@@ -15,6 +15,7 @@ class StrategyManager {
 
   void InitializeStrategies(const IMarketDataProvider& provider);
   std::vector<EventUnion>& OnMarketEvent(const MarketByOrderEvent& event);
+  std::vector<EventUnion>& OnBarEvent(const OhlcvBarEvent& bar);
   void OnFillEvent(const StrategyFillEvent& fill);
   void OnRejectionEvent(const StrategyOrderRejectionEvent& msg);
 
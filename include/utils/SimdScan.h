@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace backtester {
+
+namespace simd_scan {
+
+// Writes the offset of every ',' and '\n' in [data, data + len) to `out` in ascending order
+// and returns how many were found. `out` only ever grows (to len + 64 entries) so a reused
+// vector is not re-zeroed on every block. Uses AVX2 when the CPU has it, SSE2 otherwise,
+// and plain byte compares on non-x86 builds.
+size_t FindCsvDelimiters(const char* data, size_t len, std::vector<uint32_t>& out);
+
+// Byte-at-a-time reference implementation, same contract as FindCsvDelimiters.
+size_t FindCsvDelimitersScalar(const char* data, size_t len, std::vector<uint32_t>& out);
+
+// "avx2", "sse2" or "scalar": the path FindCsvDelimiters takes on this machine.
+const char* ActiveIsa();
+
+}  // namespace simd_scan
+
+}  // namespace backtester
@@ -0,0 +1,155 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace backtester {
+
+// Run-loop stages the profiler tells apart. Ring wait covers every wait on a ring between two
+// pipeline threads; book apply includes a replica's snapshot view update.
+enum class Stage : uint8_t {
+  kRead,
+  kParse,
+  kMerge,
+  kRingWait,
+  kBookApply,
+  kStrategy,
+  kFillModel,
+  kPortfolio,
+  kSnapshot,
+  kCount
+};
+
+const char* StageName(Stage stage);
+
+// Cheapest monotonic tick: the TSC on x86, steady_clock nanoseconds elsewhere.
+inline uint64_t StageClock() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Log-linear histogram in the HdrHistogram layout: values below 2 * kSubBuckets are counted
+// exactly, above that every power of two is cut into kSubBuckets buckets, so a bucket is never
+// wider than 1 / kSubBuckets (~3%) of the values in it. Values past 2^kMaxBits are clamped.
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t kSubBits = 5;
+  static constexpr uint64_t kSubBuckets = 1ULL << kSubBits;
+  static constexpr uint32_t kMaxBits = 48;
+  static constexpr size_t kBucketCount = (kMaxBits - kSubBits + 1) * kSubBuckets;
+  static constexpr uint64_t kMaxValue = (1ULL << kMaxBits) - 1;
+
+  void Record(uint64_t value) {
+    if (value > kMaxValue) value = kMaxValue;
+    ++counts_[BucketOf(value)];
+    ++count_;
+    total_ += value;
+    if (value > max_) max_ = value;
+  }
+  void Merge(const LatencyHistogram& other);
+  void Reset() { *this = LatencyHistogram{}; }
+
+  uint64_t Count() const { return count_; }
+  uint64_t Total() const { return total_; }
+  uint64_t Max() const { return max_; }
+  // Highest value equivalent to the one at quantile `q` in [0, 1]; never above Max().
+  uint64_t ValueAtQuantile(double q) const;
+
+  static size_t BucketOf(uint64_t value) {
+    if (value < 2 * kSubBuckets) return value;
+    const auto shift = static_cast<uint32_t>(std::bit_width(value)) - 1 - kSubBits;
+    return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+  }
+  static uint64_t BucketLowest(size_t bucket);
+
+ private:
+  std::array<uint64_t, kBucketCount> counts_{};
+  uint64_t count_ = 0;
+  uint64_t total_ = 0;
+  uint64_t max_ = 0;
+};
+
+// One histogram of exclusive time per Stage. Every thread records into its own instance
+// (ThisThread), so timing takes no lock and shares no cache line; a thread's numbers join the
+// process-wide totals when it exits, and LogAndReset reports those with the calling thread's.
+class StageProfiler {
+ public:
+  static StageProfiler& ThisThread();
+
+  void Record(Stage stage, uint64_t ticks) {
+    histograms_[static_cast<size_t>(stage)].Record(ticks);
+  }
+  void Merge(const StageProfiler& other);
+  void Reset();
+
+  const LatencyHistogram& Histogram(Stage stage) const {
+    return histograms_[static_cast<size_t>(stage)];
+  }
+
+  // Per-stage count, latency percentiles in ns and share of the profiled time, as a table
+  std::string Format(double ticks_per_ns) const;
+
+  // Merges the calling thread's profile with those of exited threads into one report, logs
+  // it, and starts every count over.
+  static void LogAndReset();
+
+  // StageClock ticks per nanosecond, measured against steady_clock since startup
+  static double TicksPerNs();
+
+ private:
+  friend class StageTimer;
+
+  std::array<LatencyHistogram, static_cast<size_t>(Stage::kCount)> histograms_;
+  uint64_t child_ticks_ = 0;  // time of the nested timers of the one running now
+};
+
+// Times a scope as `stage`. Nested timers are subtracted from the enclosing one, so each stage
+// gets its exclusive time and the shares add up to 100%.
+class StageTimer {
+ public:
+  explicit StageTimer(Stage stage)
+      : profiler_(StageProfiler::ThisThread()),
+        stage_(stage),
+        saved_child_ticks_(profiler_.child_ticks_),
+        start_(StageClock()) {
+    profiler_.child_ticks_ = 0;
+  }
+  ~StageTimer() {
+    const uint64_t elapsed = StageClock() - start_;
+    const uint64_t nested = profiler_.child_ticks_;
+    profiler_.Record(stage_, elapsed > nested ? elapsed - nested : 0);
+    profiler_.child_ticks_ = saved_child_ticks_ + elapsed;
+  }
+  StageTimer(const StageTimer&) = delete;
+  StageTimer& operator=(const StageTimer&) = delete;
+
+ private:
+  StageProfiler& profiler_;
+  Stage stage_;
+  uint64_t saved_child_ticks_;
+  uint64_t start_;
+};
+
+}  // namespace backtester
+
+// Stage instrumentation is compiled in only with -DENABLE_STAGE_PROFILER=ON
+#ifdef BT_STAGE_PROFILER
+#define BT_PROFILE_CONCAT_INNER(a, b) a##b
+#define BT_PROFILE_CONCAT(a, b) BT_PROFILE_CONCAT_INNER(a, b)
+#define BT_PROFILE_STAGE(stage) \
+  ::backtester::StageTimer BT_PROFILE_CONCAT(bt_stage_timer_, __LINE__)(stage)
+#define BT_LOG_STAGE_PROFILE() ::backtester::StageProfiler::LogAndReset()
+#else
+#define BT_PROFILE_STAGE(stage) static_cast<void>(0)
+#define BT_LOG_STAGE_PROFILE() static_cast<void>(0)
+#endif
@@ -1,12 +1,17 @@
 #include "core/Backtester.h"
 
+#include <exception>
+#include <memory>
+
 #include "core/Types.h"
 #include "spdlog/spdlog.h"
+#include "utils/StageProfiler.h"
 
 namespace backtester {
 
 // MARK: Run Loop Multi Threaded
 int Backtester::RunLoopThreaded() {
+  if (config_.data_configs.size() > 1) StartSourceReaders();
   PrimeSources();
 
   const auto t0 = std::chrono::steady_clock::now();
@@ -14,12 +19,24 @@ int Backtester::RunLoopThreaded() {
   std::thread producer(&Backtester::ProducerLoop, this);
   const uint64_t event_tally = ConsumerLoop();  // consumer runs on the main thread
   producer.join();
+  JoinSourceReaders();
 
   const auto elapsed = std::chrono::steady_clock::now() - t0;
   const double secs = std::chrono::duration<double>(elapsed).count();
   spdlog::info("Loop: {} events  {:.3f}s  {:.2f} M evt/s", event_tally, secs,
                static_cast<double>(event_tally) / secs / 1e6);
 
+  const auto& cw = consumer_wait_.Stats();
+  const auto& pw = producer_wait_.Stats();
+  spdlog::info(
+      "Ring wait: consumer {} spins {} parks {} wakes | producer {} spins {} parks {} wakes",
+      cw.spins, cw.parks, cw.wakes, pw.spins, pw.parks, pw.wakes);
+  BT_LOG_STAGE_PROFILE();
+
+  if (data_reader_manager_.Failed()) {
+    spdlog::error("Loop: a data source failed to read to its end; no report written");
+    return 1;
+  }
   report_generator_.GenerateReport(portfolio_manager_, strategy_manager_.GetStrategyNames());
   return 0;
 }
@@ -28,9 +45,111 @@ int Backtester::RunLoopThreaded() {
 void Backtester::ProducerLoop() {
   while (!source_heap_.empty()) {
     if (backtest_complete_.load(std::memory_order_acquire)) break;
-    FillRing();
+    const size_t n = FillRing(kRingBatch);
+    if (BT_UNLIKELY(n == 0)) {  // full: wait for the consumer
+      BT_PROFILE_STAGE(Stage::kRingWait);
+      producer_wait_.Wait([this] {
+        return ring_.PrepareWrite() != nullptr ||
+               backtest_complete_.load(std::memory_order_acquire);
+      });
+      continue;
+    }
+    consumer_wait_.Notify(static_cast<uint32_t>(n));
   }
   producer_done_.store(true, std::memory_order_release);
+  consumer_wait_.NotifyNow();
+}
+
+// MARK: Source Readers
+void Backtester::StartSourceReaders() {
+  source_feeds_.clear();
+  for (size_t i = 0; i < config_.data_configs.size(); ++i) {
+    source_feeds_.push_back(std::make_unique<SourceFeed>(config_.ring_wait));
+    SourceFeed& feed = *source_feeds_[i];
+    feed.thread = std::thread(&Backtester::SourceReaderLoop, this, std::ref(feed),
+                              config_.data_configs[i].data_source_id,
+                              config_.data_configs[i].schema);
+  }
+  spdlog::info("Started {} per-source reader threads", source_feeds_.size());
+}
+
+void Backtester::JoinSourceReaders() {
+  // The producer has exited, so this thread is the only one left to wake a reader parked on a
+  // full ring; it then sees backtest_complete_ and stops.
+  for (auto& feed : source_feeds_) {
+    feed->space_wait.NotifyNow();
+    if (feed->thread.joinable()) feed->thread.join();
+  }
+  source_feeds_.clear();
+}
+
+void Backtester::SourceReaderLoop(SourceFeed& feed, uint16_t source_id, DataSchema schema) {
+  const bool mbo = schema == DataSchema::MBO;
+  std::vector<MarketByOrderEvent> batch(mbo ? kSourceBatch : 0);
+  std::vector<EventUnion> market_batch(mbo ? 0 : kSourceBatch);
+  while (!backtest_complete_.load(std::memory_order_acquire)) {
+    const size_t n = mbo ? data_reader_manager_.LoadNextBatch(source_id, batch)
+                         : data_reader_manager_.LoadNextMarketEvents(source_id, market_batch);
+    if (n == 0) break;
+    for (size_t i = 0; i < n;) {
+      EventUnion* slot = feed.ring->PrepareWrite();
+      if (!slot) {
+        if (backtest_complete_.load(std::memory_order_acquire)) break;
+        feed.space_wait.Wait([&] {  // the producer is behind on this source
+          return feed.ring->PrepareWrite() != nullptr ||
+                 backtest_complete_.load(std::memory_order_acquire);
+        });
+        continue;
+      }
+      if (mbo) {
+        slot->mbo = batch[i++];
+      } else {
+        *slot = market_batch[i++];
+      }
+      feed.ring->CommitWrite();
+      feed.data_wait.Notify();
+    }
+  }
+  feed.done.store(true, std::memory_order_release);
+  feed.data_wait.NotifyNow();
+}
+
+// Next event of one source: straight from its reader, or from its reader thread's ring.
+bool Backtester::NextSourceEvent(uint16_t idx, EventUnion& out) {
+  if (source_feeds_.empty()) {
+    SourceBatch& batch = source_batches_[idx];
+    const bool mbo = batch.market.empty();
+    if (BT_UNLIKELY(batch.pos == batch.size)) {
+      const uint16_t source_id = source_heads_[idx].source_id;
+      batch.size = mbo ? data_reader_manager_.LoadNextBatch(source_id, batch.events)
+                       : data_reader_manager_.LoadNextMarketEvents(source_id, batch.market);
+      batch.pos = 0;
+      if (batch.size == 0) return false;
+    }
+    if (BT_UNLIKELY(!mbo)) {
+      out = batch.market[batch.pos++];
+    } else {
+      out.mbo = batch.events[batch.pos++];
+    }
+    return true;
+  }
+
+  SourceFeed& feed = *source_feeds_[idx];
+  const EventUnion* ev = feed.ring->PeekRead();
+  if (BT_UNLIKELY(!ev)) {
+    BT_PROFILE_STAGE(Stage::kRingWait);
+    feed.data_wait.Wait([&] {
+      return feed.ring->PeekRead() != nullptr || feed.done.load(std::memory_order_acquire) ||
+             backtest_complete_.load(std::memory_order_acquire);
+    });
+    // re-check: the reader may have published its last event right before the flag
+    ev = feed.ring->PeekRead();
+    if (!ev) return false;
+  }
+  out = *ev;
+  feed.ring->CommitRead();
+  feed.space_wait.Notify();
+  return true;
 }
 
 // MARK: Consumer Loop
@@ -40,8 +159,24 @@ uint64_t Backtester::ConsumerLoop() {
   uint64_t event_tally = 0;
   bool end_of_bt_pushed = false;
 
+  // Readable slots taken from ring_ in one go and released together once all are consumed
+  std::span<const EventUnion> batch;
+  size_t pos = 0;
+  auto next_market = [&]() -> const EventUnion* {
+    if (pos == batch.size()) {
+      if (pos > 0) {
+        ring_.CommitReadBatch(pos);  // frees the slots for the producer
+        producer_wait_.Notify(static_cast<uint32_t>(pos));
+      }
+      batch = ring_.PeekReadBatch(kRingBatch);
+      pos = 0;
+      if (batch.empty()) return nullptr;
+    }
+    return &batch[pos];
+  };
+
   while (true) {
-    const EventUnion* mkt_ev = ring_.PeekRead();
+    const EventUnion* mkt_ev = next_market();
     const bool synth = !event_queue_.IsEmpty();
 
     // --- termination / starvation handling -------------------------------
@@ -50,10 +185,14 @@ uint64_t Backtester::ConsumerLoop() {
       //   (a) producer finished and everything is processed -> DONE
       //   (b) producer just hasn't caught up yet            -> SPIN
       if (producer_done_.load(std::memory_order_acquire) &&
-          ring_.PeekRead() == nullptr) {  // re-check: closes push-then-flag race
+          next_market() == nullptr) {  // re-check: closes push-then-flag race
         break;
       }
-      continue;  // ring transiently empty; try again
+      BT_PROFILE_STAGE(Stage::kRingWait);
+      consumer_wait_.Wait([this] {
+        return ring_.PeekRead() != nullptr || producer_done_.load(std::memory_order_acquire);
+      });
+      continue;  // ring was transiently empty; try again
     }
 
     // --- two-way merge: earliest wins; market wins ties ------------------
@@ -66,13 +205,13 @@ uint64_t Backtester::ConsumerLoop() {
 
     if (take_market) {
       if (backtest_complete_.load(std::memory_order_acquire)) {
-        ring_.CommitRead();  // discard: past the window, don't process
+        ++pos;  // discard: past the window, don't process
         continue;
       }
-      const MarketByOrderEvent mbo = mkt_ev->mbo;  // copy out BEFORE CommitRead
-      current_time = mbo.header.timestamp;
-      ring_.CommitRead();  // frees slot for producer
-      ApplyMarket(mbo);
+      const EventUnion ev = *mkt_ev;  // copy out; the slot is released with its batch
+      current_time = Hdr(ev).timestamp;
+      ++pos;
+      ApplyMarketEvent(ev);
       // NOTE: no FillRing() here anymore — the producer thread owns that.
     } else {
       EventUnion ev = event_queue_.PopTopEvent();
@@ -82,7 +221,7 @@ uint64_t Backtester::ConsumerLoop() {
     ++event_tally;
 
     // End-of-backtest trigger 
-    const bool streams_dry = (ring_.PeekRead() == nullptr) && event_queue_.IsEmpty() &&
+    const bool streams_dry = (next_market() == nullptr) && event_queue_.IsEmpty() &&
                              producer_done_.load(std::memory_order_acquire);
 
     if (((streams_dry || current_time > config_.end_time) && !backtest_complete_) &&
@@ -130,12 +269,12 @@ int Backtester::RunLoopSingleThreaded() {
       take_market = (mkt_ev != nullptr);
     }
 
-    if (take_market) {
-      const MarketByOrderEvent mbo = mkt_ev->mbo;  // copy out before CommitRead
-      current_time = mbo.header.timestamp;
+    if (take_market && mkt_ev) {
+      const EventUnion ev = *mkt_ev;  // copy out before CommitRead
+      current_time = Hdr(ev).timestamp;
       ring_.CommitRead();  // free slot AFTER copying out
 
-      ApplyMarket(mbo);
+      ApplyMarketEvent(ev);
 
       if (!backtest_complete_) FillRing();
     } else {
@@ -167,49 +306,368 @@ int Backtester::RunLoopSingleThreaded() {
   const double secs = std::chrono::duration<double>(elapsed).count();
   spdlog::info("Loop: {} events  {:.3f}s  {:.2f} M evt/s", event_tally, secs,
                static_cast<double>(event_tally) / secs / 1e6);
+  BT_LOG_STAGE_PROFILE();
 
+  if (data_reader_manager_.Failed()) {
+    spdlog::error("Loop: a data source failed to read to its end; no report written");
+    return 1;
+  }
   report_generator_.GenerateReport(portfolio_manager_, strategy_manager_.GetStrategyNames());
   return 0;
 }
 
-// MARK: Fill Ring
-bool Backtester::FillRing() {
-  if (source_heap_.empty()) return false;  // every source drained
+// MARK: Publish Frames
+void Backtester::PublishFrames(FrameRing& frames) {
+  PrimeSources();
+  FillRing();
 
-  EventUnion* slot = ring_.PrepareWrite();
-  if (!slot) return true;  // ring full this turn (not EOF)
+  const TrackedInstruments traded = TrackedTraded();
+  uint64_t published = 0;
+  while (const EventUnion* ev = ring_.PeekRead()) {
+    if (!PublishFrame(frames, *ev, traded)) break;
+    ring_.CommitRead();
+    ++published;
+    FillRing();
+  }
+  frames.Close();
+  spdlog::info("Book thread published {} events to {} replicas", published,
+               frames.ReaderCount());
+}
 
-  // Earliest-timestamp source sits at the heap top.
-  std::pop_heap(source_heap_.begin(), source_heap_.end(), SourceGreater{&source_heads_});
-  const uint16_t idx = source_heap_.back();
-  SourceHead& head = source_heads_[idx];
+TrackedInstruments Backtester::TrackedTraded() const {
+  TrackedInstruments traded;
+  const auto& known = market_state_manager_.GetMarketSnapshots();
+  for (const auto& instr : config_.traded_instruments) {
+    if (known.contains(instr.instrument_id)) {
+      traded.emplace_back(instr.instrument_id, instr.tick_size);
+    }
+  }
+  return traded;
+}
 
-  *slot = head.event;  // publish earliest event
-  ring_.CommitWrite();
+bool Backtester::PublishFrame(FrameRing& frames, const EventUnion& ev,
+                              const TrackedInstruments& traded) {
+  MarketFrame* frame = frames.PrepareWrite();
+  if (!frame) {
+    BT_PROFILE_STAGE(Stage::kRingWait);
+    frame = frames.WaitWrite();  // the slowest replica is a full ring behind
+    if (!frame) return false;    // every replica detached
+  }
 
-  // Advance that one source to its next event.
-  head.exhausted = !data_reader_manager_.LoadNextEventFromSource(head.source_id, head.event.mbo);
+  BT_PROFILE_STAGE(Stage::kBookApply);
+  ApplyToFrame(market_state_manager_, ev, traded, *frame);
+  frames.CommitWrite();
+  return true;
+}
 
-  if (head.exhausted) {
-    source_heap_.pop_back();  // drop drained source
+void ApplyToFrame(MarketStateManager& book, const EventUnion& ev,
+                  const TrackedInstruments& traded, MarketFrame& frame) {
+  frame.event = ev;
+  const EventType type = Hdr(ev).type;
+  if (BT_UNLIKELY(type == EventType::kMarketLevelUpdate)) {
+    book.OnLevelEvent(ev.level);
+  } else if (BT_UNLIKELY(type == EventType::kMarketBar)) {
+    book.OnBarEvent(ev.bar);
   } else {
-    std::push_heap(source_heap_.begin(), source_heap_.end(),
-                   SourceGreater{&source_heads_});  // re-insert w/ new ts
+    book.OnMarketEvent(ev.mbo);
+  }
+  frame.has_state = false;
+  const uint32_t id = MarketInstrumentId(ev);
+  for (const auto& [instr_id, tick_size] : traded) {
+    if (instr_id != id) continue;
+    SnapshotMarketDataProvider::Capture(book, id, tick_size, frame.state);
+    frame.has_state = true;
+    break;
   }
-  return true;
+}
+
+// MARK: Run Replica
+int Backtester::RunReplica(FrameRing& frames, size_t reader, SnapshotMarketDataProvider& view) {
+  return ReplayFrames(frames, reader, view);
+}
+
+template <class Frames>
+int Backtester::ReplayFrames(Frames& frames, size_t reader, SnapshotMarketDataProvider& view) {
+  replica_view_ = &view;
+  // The frame at the head of this reader's cursor plays the part of ring_ in
+  // RunLoopSingleThreaded: one market event of lookahead, refilled until the backtest ends.
+  // A source that ends because the book stage failed stops the replay without a report.
+  bool book_failed = false;
+  auto wait_frame = [&]() {
+    BT_PROFILE_STAGE(Stage::kRingWait);
+    const MarketFrame* frame = frames.WaitRead(reader);
+    if (!frame && frames.Failed()) book_failed = true;
+    return frame;
+  };
+  const MarketFrame* next = wait_frame();
+
+  uint64_t current_time = 0;
+  uint64_t last_snapshot_ts_ = 0;
+  uint64_t event_tally = 0;
+  backtest_complete_ = false;
+  bool end_of_bt_pushed = false;
+
+  const auto t0 = std::chrono::steady_clock::now();
+  while (!book_failed && (next != nullptr || !event_queue_.IsEmpty())) {
+    const bool synth_ev = !event_queue_.IsEmpty();
+
+    bool take_market;
+    if (next && synth_ev) {
+      take_market = Hdr(next->event).timestamp <= Hdr(event_queue_.ReadTopEvent()).timestamp;
+    } else {
+      take_market = (next != nullptr);
+    }
+
+    if (take_market) {
+      current_time = Hdr(next->event).timestamp;
+      {
+        BT_PROFILE_STAGE(Stage::kBookApply);
+        view.Apply(*next);
+      }
+      ReactToMarketEvent(next->event);
+      frames.CommitRead(reader);
+      next = backtest_complete_ ? nullptr : wait_frame();
+    } else {
+      EventUnion ev = event_queue_.PopTopEvent();
+      current_time = Hdr(ev).timestamp;
+      ApplySynthetic(ev, current_time);
+    }
+    ++event_tally;
+
+    const bool streams_dry = (next == nullptr) && event_queue_.IsEmpty();
+    if (((streams_dry || current_time > config_.end_time) && !backtest_complete_) &&
+        !end_of_bt_pushed) {
+      event_queue_.PushEvent(
+          EventUnion{.control_ev = {.header = {.timestamp = current_time,
+                                               .type =
+                                               EventType::kBacktestControlEndOfBacktest}}});
+      end_of_bt_pushed = true;
+    }
+
+    if (current_time >= config_.start_time &&
+        current_time - last_snapshot_ts_ >= config_.snapshot_interval_ns) {
+      RecordSnapshot(current_time);
+      last_snapshot_ts_ = current_time;
+    }
+  }
+  frames.Detach(reader);
+
+  const auto elapsed = std::chrono::steady_clock::now() - t0;
+  const double secs = std::chrono::duration<double>(elapsed).count();
+  spdlog::info("Replica {}: {} events  {:.3f}s  {:.2f} M evt/s", reader, event_tally, secs,
+               static_cast<double>(event_tally) / secs / 1e6);
+  replica_view_ = nullptr;
+  if (book_failed) {
+    spdlog::error("Replica {}: book stage failed after {} events; no report written", reader,
+                  event_tally);
+    return 1;
+  }
+  if (data_reader_manager_.Failed()) {
+    spdlog::error("Replica {}: a data source failed to read to its end; no report written",
+                  reader);
+    return 1;
+  }
+
+  report_generator_.GenerateReport(portfolio_manager_, strategy_manager_.GetStrategyNames());
+  return 0;
+}
+
+// MARK: Run Loop Pipelined
+int Backtester::RunLoopPipelined(SnapshotMarketDataProvider& view) {
+  if (config_.data_configs.size() > 1) StartSourceReaders();
+  PrimeSources();
+
+  const auto t0 = std::chrono::steady_clock::now();
+  uint64_t published = 0;
+  if (config_.book_shards > 1) {
+    InstrumentShards shards(config_.book_shards, config_);
+    published = RunStages(shards, view, [&] { return RouteLoop(shards); });
+    shards.Join();
+  } else {
+    auto frames = std::make_unique<FrameRing>(1, config_.ring_wait);
+    published = RunStages(*frames, view, [&] { return BookLoop(*frames); });
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - t0;
+  const double secs = std::chrono::duration<double>(elapsed).count();
+  spdlog::info("Pipeline: {} market events through {} book thread(s)  {:.3f}s  {:.2f} M evt/s",
+               published, config_.book_shards, secs,
+               static_cast<double>(published) / secs / 1e6);
+
+  const auto& bw = consumer_wait_.Stats();
+  const auto& pw = producer_wait_.Stats();
+  spdlog::info(
+      "Ring wait: book {} spins {} parks {} wakes | producer {} spins {} parks {} wakes",
+      bw.spins, bw.parks, bw.wakes, pw.spins, pw.parks, pw.wakes);
+  BT_LOG_STAGE_PROFILE();
+  return data_reader_manager_.Failed() ? 1 : 0;  // the strategy stage wrote no report then
+}
+
+template <class Frames, class BookStage>
+uint64_t Backtester::RunStages(Frames& frames, SnapshotMarketDataProvider& view,
+                               BookStage&& book_stage) {
+  std::thread producer(&Backtester::ProducerLoop, this);
+  uint64_t published = 0;
+  std::exception_ptr book_error;
+  std::thread book([&]() {
+    try {
+      published = book_stage();
+    } catch (...) {
+      book_error = std::current_exception();
+      frames.Fail();  // let the strategy stage drain and stop without a report
+    }
+  });
+
+  auto join = [&]() {
+    book.join();
+    producer.join();
+    JoinSourceReaders();
+  };
+  try {
+    ReplayFrames(frames, 0, view);  // strategy stage runs on the calling thread
+  } catch (...) {
+    frames.Detach(0);
+    backtest_complete_.store(true, std::memory_order_release);
+    producer_wait_.NotifyNow();
+    join();
+    throw;
+  }
+  join();
+  if (book_error) std::rethrow_exception(book_error);
+  return published;
+}
+
+// MARK: Book Loop
+template <class Publish>
+uint64_t Backtester::DrainRing(Publish&& publish) {
+  uint64_t published = 0;
+  bool abandoned = false;
+  while (!abandoned) {
+    std::span<const EventUnion> batch = ring_.PeekReadBatch(kRingBatch);
+    if (batch.empty()) {
+      if (producer_done_.load(std::memory_order_acquire)) {
+        // re-check: the producer may have published its last batch right before the flag
+        batch = ring_.PeekReadBatch(kRingBatch);
+        if (batch.empty()) break;
+      } else {
+        BT_PROFILE_STAGE(Stage::kRingWait);
+        consumer_wait_.Wait([this] {
+          return ring_.PeekRead() != nullptr || producer_done_.load(std::memory_order_acquire);
+        });
+        continue;
+      }
+    }
+    for (const EventUnion& ev : batch) {
+      if (!publish(ev)) {
+        abandoned = true;  // the strategy stage finished; the rest is past the window
+        break;
+      }
+      ++published;
+    }
+    ring_.CommitReadBatch(batch.size());
+    producer_wait_.Notify(static_cast<uint32_t>(batch.size()));
+  }
+  return published;
+}
+
+uint64_t Backtester::BookLoop(FrameRing& frames) {
+  const TrackedInstruments traded = TrackedTraded();
+  const uint64_t published =
+      DrainRing([&](const EventUnion& ev) { return PublishFrame(frames, ev, traded); });
+  frames.Close();
+  spdlog::info("Book thread published {} events", published);
+  return published;
+}
+
+uint64_t Backtester::RouteLoop(InstrumentShards& shards) {
+  const uint64_t routed = DrainRing([&](const EventUnion& ev) { return shards.Route(ev); });
+  shards.Close();
+  spdlog::info("Router handed {} events to {} book shards", routed, shards.ShardCount());
+  return routed;
+}
+
+// MARK: Fill Ring
+size_t Backtester::FillRing(size_t max_events) {
+  if (source_heap_.empty()) return 0;  // every source drained
+  BT_PROFILE_STAGE(Stage::kMerge);  // reading the sources inside is timed on its own
+
+  const std::span<EventUnion> slots = ring_.PrepareWriteBatch(max_events);
+  size_t n = 0;
+  while (n < slots.size() && !source_heap_.empty()) {
+    // Earliest-timestamp source sits at the heap top.
+    std::pop_heap(source_heap_.begin(), source_heap_.end(), SourceGreater{&source_heads_});
+    const uint16_t idx = source_heap_.back();
+    SourceHead& head = source_heads_[idx];
+
+    slots[n++] = head.event;
+
+    // Advance that one source to its next event.
+    head.exhausted = !NextSourceEvent(idx, head.event);
+
+    if (head.exhausted) {
+      source_heap_.pop_back();  // drop drained source
+    } else {
+      std::push_heap(source_heap_.begin(), source_heap_.end(),
+                     SourceGreater{&source_heads_});  // re-insert w/ new ts
+    }
+  }
+  if (n > 0) ring_.CommitWriteBatch(n);  // one release store for the whole batch
+  return n;
 }
 
 // MARK: Apply Market
 void Backtester::ApplyMarket(const MarketByOrderEvent& mbo) {
-  market_state_manager_.OnMarketEvent(mbo);
+  {
+    BT_PROFILE_STAGE(Stage::kBookApply);
+    market_state_manager_.OnMarketEvent(mbo);
+  }
+  ReactToMarket(mbo);
+}
 
+void Backtester::ReactToMarket(const MarketByOrderEvent& mbo) {
   const uint64_t current_time = mbo.header.timestamp;
   if (current_time >= config_.start_time) {
-    auto signals = strategy_manager_.OnMarketEvent(mbo);
-    for (size_t i = 0; i < signals.size(); ++i) {
-      event_queue_.PushEvent(signals[i]);
+    {
+      BT_PROFILE_STAGE(Stage::kStrategy);
+      auto signals = strategy_manager_.OnMarketEvent(mbo);
+      for (size_t i = 0; i < signals.size(); ++i) {
+        event_queue_.PushEvent(signals[i]);
+      }
+    }
+    {
+      BT_PROFILE_STAGE(Stage::kFillModel);
+      execution_handler_.OnMarketEvent(mbo);
     }
-    execution_handler_.OnMarketEvent(mbo);
+    BT_PROFILE_STAGE(Stage::kPortfolio);
+    if (portfolio_manager_.HasAnyOpenPosition()) {
+      portfolio_manager_.UpdateMaxEquity();
+    }
+  }
+}
+
+// MARK: Apply Bar
+void Backtester::ApplyBar(const OhlcvBarEvent& bar) {
+  {
+    BT_PROFILE_STAGE(Stage::kBookApply);
+    market_state_manager_.OnBarEvent(bar);
+  }
+  ReactToBar(bar);
+}
+
+void Backtester::ReactToBar(const OhlcvBarEvent& bar) {
+  if (bar.header.timestamp >= config_.start_time) {
+    {
+      BT_PROFILE_STAGE(Stage::kStrategy);
+      auto signals = strategy_manager_.OnBarEvent(bar);
+      for (size_t i = 0; i < signals.size(); ++i) {
+        event_queue_.PushEvent(signals[i]);
+      }
+    }
+    {
+      BT_PROFILE_STAGE(Stage::kFillModel);
+      execution_handler_.OnBarEvent(bar);
+    }
+    BT_PROFILE_STAGE(Stage::kPortfolio);
     if (portfolio_manager_.HasAnyOpenPosition()) {
       portfolio_manager_.UpdateMaxEquity();
     }
@@ -221,17 +679,24 @@ void Backtester::ApplySynthetic(const EventUnion& ev, uint64_t current_time) {
   const EventType type = Hdr(ev).type;
 
   if (isStrategySignalEvent(type)) {
+    BT_PROFILE_STAGE(Stage::kPortfolio);
     auto order_event = portfolio_manager_.RequestOrder(ev.strat_signal_ev);
     const EventType t = Hdr(order_event).type;
     if (isStrategyOrderEvent(t) || t == EventType::kStrategyOrderRejection) {
       event_queue_.PushEvent(order_event);
     }
   } else if (isStrategyOrderEvent(type)) {
+    BT_PROFILE_STAGE(Stage::kFillModel);
     execution_handler_.OnStrategyOrder(ev.strat_order_ev);
   } else if (type == EventType::kStrategyOrderFill) {
-    portfolio_manager_.ProcessFill(ev.strat_fill_ev);
+    {
+      BT_PROFILE_STAGE(Stage::kPortfolio);
+      portfolio_manager_.ProcessFill(ev.strat_fill_ev);
+    }
+    BT_PROFILE_STAGE(Stage::kStrategy);
     strategy_manager_.OnFillEvent(ev.strat_fill_ev);
   } else if (type == EventType::kStrategyOrderRejection) {
+    BT_PROFILE_STAGE(Stage::kStrategy);
     strategy_manager_.OnRejectionEvent(ev.strat_rej_ev);
   } else if (isControlEvent(type)) {
     if (type == EventType::kBacktestControlEndOfBacktest && !backtest_complete_) {
@@ -239,13 +704,14 @@ void Backtester::ApplySynthetic(const EventUnion& ev, uint64_t current_time) {
       portfolio_manager_.CancelAllPendingOrders();
       EmitClosingOrders(current_time);
       backtest_complete_.store(true);
+      producer_wait_.NotifyNow();  // a producer parked on a full ring has to see the stop
     }
   }
 }
 
 // MARK: Emit Closing Orders
 void Backtester::EmitClosingOrders(timestamp_t close_ts) {
-  auto current_prices = market_state_manager_.GetTradedInstrsBbo();
+  auto current_prices = TradedInstrsBbo();
 
   for (const auto& pos : portfolio_manager_.GetPositions()) {
     if (pos.quantity == 0) continue;
@@ -279,7 +745,8 @@ void Backtester::EmitClosingOrders(timestamp_t close_ts) {
 
 // MARK: Record Snapshot
 void Backtester::RecordSnapshot(timestamp_t current_time) {
-  auto current_prices = market_state_manager_.GetTradedInstrsBbo();
+  BT_PROFILE_STAGE(Stage::kSnapshot);
+  auto current_prices = TradedInstrsBbo();
   money_t equity = portfolio_manager_.GetTotalEquity();
   money_t cash = portfolio_manager_.GetCash();
   money_t realized = portfolio_manager_.GetRealizedPnL();
@@ -295,13 +762,21 @@ void Backtester::RecordSnapshot(timestamp_t current_time) {
 void Backtester::PrimeSources() {
   source_heads_.clear();
   source_heap_.clear();
+  source_batches_.clear();
   spdlog::info("Populating initial events from data sources...");
   for (const auto& dc : config_.data_configs) {
     SourceHead h;
     h.source_id = dc.data_source_id;
-    h.exhausted = !data_reader_manager_.LoadNextEventFromSource(h.source_id, h.event.mbo);
-    const uint16_t idx = static_cast<uint16_t>(source_heads_.size());
     source_heads_.push_back(h);
+    if (dc.schema != DataSchema::MBO) {
+      source_batches_.push_back({{}, std::vector<EventUnion>(kSourceBatch)});
+    } else {
+      source_batches_.push_back({std::vector<MarketByOrderEvent>(kSourceBatch), {}});
+    }
+  }
+  for (uint16_t idx = 0; idx < source_heads_.size(); ++idx) {
+    SourceHead& h = source_heads_[idx];
+    h.exhausted = !NextSourceEvent(idx, h.event);
     if (!h.exhausted) source_heap_.push_back(idx);
   }
   std::make_heap(source_heap_.begin(), source_heap_.end(), SourceGreater{&source_heads_});
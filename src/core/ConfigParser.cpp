@@ -1,5 +1,9 @@
 #include "core/ConfigParser.h"
 
+#include <glob.h>
+
+#include <algorithm>
+#include <ctime>
 #include <fstream>
 #include <sstream>
 
@@ -24,6 +28,7 @@ constexpr double kDefaultMaxRiskPerTradePct = .02;
 constexpr double kDefaultMaxPortfolioDelta = 0;
 constexpr double kDefaultMaxDrawdownPct = .4;
 constexpr double kDefaultMaxDeltaPerTrade = 0;
+constexpr uint32_t kMaxBookShards = 64;
 constexpr double kDefaultFutPerContract = 2.17;
 constexpr double kDefaultStockClearingFee = 0.0002;
 constexpr double kDefaultStockOrderMin = 0.35;
@@ -128,6 +133,21 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
   if (config.report_output_dir == "") config.report_output_dir = kDefaultReportDir;
   ResolvePath(config.report_output_dir, config_dir);
 
+  config.event_arena_dir =
+      GetOptional<std::string>(data, "event_arena_dir", "Global Settings").value_or("");
+  if (!config.event_arena_dir.empty()) ResolvePath(config.event_arena_dir, config_dir);
+
+  config.day_threads =
+      GetOptional<uint32_t>(data, "day_threads", "Global Settings").value_or(0);
+  config.ring_wait = StrToWaitPolicy(
+      GetOptional<std::string>(data, "ring_wait", "Global Settings").value_or("spin"));
+  config.book_shards =
+      GetOptional<uint32_t>(data, "book_shards", "Global Settings").value_or(1);
+  if (config.book_shards < 1 || config.book_shards > kMaxBookShards) {
+    throw std::runtime_error(fmt::format("Config Error: 'book_shards' must be 1 to {}, got {}",
+                                         kMaxBookShards, config.book_shards));
+  }
+
   // MARK: Risk-Free Rate
   config.risk_free_rate =
       GetOptional<double>(data, "risk_free_rate", "Global Settings").value_or(kDefaultRiskFreeRate);
@@ -192,6 +212,7 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
   for (const auto& stream : data["data_streams"]) {
     DataSourceConfig data_config;
     data_config.data_source_name = GetRequired<std::string>(stream, "data_source_name", context);
+    data_config.data_source_id = static_cast<uint16_t>(config.data_configs.size());
 
     auto tmp_sym_path = GetRequired<std::string>(stream, "symbology_filepath", context);
     ResolvePath(tmp_sym_path, config_dir);
@@ -199,8 +220,17 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
 
     data_config.data_filepath = GetRequired<std::string>(stream, "data_filepath", context);
     ResolvePath(data_config.data_filepath, config_dir);
+    auto data_files =
+        ExpandDataFiles(data_config.data_filepath, config.start_time, config.end_time);
+    data_config.data_filepath = data_files.front();
+    if (data_files.size() > 1) {
+      spdlog::info("Source {} reads {} files", data_config.data_source_name, data_files.size());
+      data_config.data_files = std::move(data_files);
+    }
 
-    data_config.schema = StrToDataSchema(GetRequired<std::string>(stream, "schema", context));
+    const auto schema = GetRequired<std::string>(stream, "schema", context);
+    data_config.schema = StrToDataSchema(schema);
+    data_config.bar_interval_ns = StrToBarInterval(schema);
     data_config.encoding = StrToEncoding(GetRequired<std::string>(stream, "encoding", context));
     data_config.compression =
         StrToCompression(GetRequired<std::string>(stream, "compression", context));
@@ -208,6 +238,23 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
         StrToPriceFormat(GetRequired<std::string>(stream, "price_format", context));
     data_config.ts_format =
         StrToTSFormat(GetRequired<std::string>(stream, "timestamp_format", context));
+    data_config.decode_threads =
+        GetOptional<uint32_t>(stream, "decode_threads", context).value_or(1);
+    if (data_config.decode_threads == 0) {
+      throw std::runtime_error("Config Error: 'decode_threads' must be at least 1 in " +
+                               data_config.data_source_name);
+    }
+    data_config.parser =
+        StrToCsvParser(GetOptional<std::string>(stream, "parser", context).value_or("scalar"));
+    data_config.prefetch_blocks =
+        GetOptional<uint32_t>(stream, "prefetch_blocks", context).value_or(3);
+    data_config.seek_to_start =
+        GetOptional<bool>(stream, "seek_to_start", context).value_or(false);
+    if (GetOptional<bool>(stream, "filter_instruments", context).value_or(false)) {
+      for (const auto& symbology : data_config.data_symbology) {
+        data_config.instrument_filter.push_back(symbology.instrument_id);
+      }
+    }
     config.data_configs.push_back(data_config);
   };
 
@@ -217,6 +264,22 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
     }
   }
 
+  // Mark: MBP-10 streams only carry kMbp10Depth levels per side
+  for (const auto& data_stream : config.data_configs) {
+    if (data_stream.schema != DataSchema::MBP10) continue;
+    for (const auto& strat : config.strategies) {
+      if (strat.max_lob_lvl <= kMbp10Depth) continue;
+      for (const auto& symbology : data_stream.data_symbology) {
+        if (symbology.instrument_id != strat.traded_instr_id) continue;
+        throw std::runtime_error(
+            fmt::format("Config Error: strategy {} needs {} book levels but stream {} is "
+                        "MBP-10 ({} levels)",
+                        strat.name, strat.max_lob_lvl, data_stream.data_source_name,
+                        kMbp10Depth));
+      }
+    }
+  }
+
   // MARK:Commissions
   if (!data.contains("commissions")) {
     spdlog::warn("No parsable commissions settings detected, using default");
@@ -225,9 +288,52 @@ AppConfig ParseConfigFromJson(const nlohmann::json& data, std::filesystem::path
     config.commission_struct = ParseCommissions(data["commissions"]);
   }
 
+  // MARK: Parameter Sweep
+  if (data.contains("sweep")) config.sweep = ParseSweep(data["sweep"], config.strategies);
+
   return config;
 }
 
+// MARK: EXPAND DATA FILES
+std::vector<std::string> ExpandDataFiles(const std::string& pattern, timestamp_t start_time,
+                                         timestamp_t end_time) {
+  static constexpr std::string_view kDate = "{date}";
+  static constexpr timestamp_t kNanosPerDay = 86'400'000'000'000ULL;
+  std::vector<std::string> files;
+
+  if (const size_t at = pattern.find(kDate); at != std::string::npos) {
+    for (timestamp_t day = start_time - start_time % kNanosPerDay; day <= end_time;
+         day += kNanosPerDay) {
+      const std::time_t secs = static_cast<std::time_t>(day / 1'000'000'000ULL);
+      std::tm tm{};
+      gmtime_r(&secs, &tm);
+      char date[9];
+      std::strftime(date, sizeof(date), "%Y%m%d", &tm);
+
+      std::string path = pattern;
+      path.replace(at, kDate.size(), date);
+      if (std::filesystem::exists(path)) {
+        files.push_back(std::move(path));
+      } else {
+        spdlog::info("No data file for {} at {}, skipping the day", date, path);
+      }
+    }
+  } else if (pattern.find_first_of("*?[") != std::string::npos) {
+    glob_t matches{};
+    if (::glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+      for (size_t i = 0; i < matches.gl_pathc; ++i) files.emplace_back(matches.gl_pathv[i]);
+    }
+    ::globfree(&matches);
+  } else {
+    return {pattern};
+  }
+
+  if (files.empty()) {
+    throw std::runtime_error("Config Error: no data files match " + pattern);
+  }
+  return files;
+}
+
 // MARK: PARSE STRATEGIES
 std::vector<Strategy> ParseStrategies(const nlohmann::json& strategies) {
   std::vector<Strategy> res;
@@ -243,6 +349,42 @@ std::vector<Strategy> ParseStrategies(const nlohmann::json& strategies) {
   return res;
 }
 
+// MARK: PARSE SWEEP
+SweepConfig ParseSweep(const nlohmann::json& data, const std::vector<Strategy>& strategies) {
+  SweepConfig res;
+  std::string context = "Sweep";
+  res.threads = GetOptional<uint32_t>(data, "threads", context).value_or(0);
+  res.share_book = GetOptional<bool>(data, "share_book", context).value_or(false);
+
+  if (!data.contains("grid") || !data["grid"].is_array() || data["grid"].empty()) {
+    throw std::runtime_error("Config Error: 'sweep' needs a 'grid' array with at least one axis.");
+  }
+  for (const auto& item : data["grid"]) {
+    SweepAxis axis;
+    const auto name = GetRequired<std::string>(item, "strategy", context);
+    auto it = std::find_if(strategies.begin(), strategies.end(),
+                           [&name](const Strategy& s) { return s.name == name; });
+    if (it == strategies.end()) {
+      throw std::runtime_error(
+          fmt::format("Config Error: sweep axis names strategy {} which is not configured", name));
+    }
+    axis.strategy_index = static_cast<size_t>(it - strategies.begin());
+    axis.param_index = GetRequired<size_t>(item, "param", context);
+    if (axis.param_index >= it->params.size()) {
+      throw std::runtime_error(fmt::format(
+          "Config Error: sweep axis param {} is out of range, strategy {} has {} params",
+          axis.param_index, name, it->params.size()));
+    }
+    axis.values = GetRequired<std::vector<int>>(item, "values", context);
+    if (axis.values.empty()) {
+      throw std::runtime_error(fmt::format(
+          "Config Error: sweep axis {} param {} has no values", name, axis.param_index));
+    }
+    res.axes.push_back(std::move(axis));
+  }
+  return res;
+}
+
 std::vector<Symbol> ParseDataSymbols(const std::string& filepath) {
   std::vector<Symbol> instruments;
   std::ifstream file(filepath, std::ios::in);
@@ -0,0 +1,202 @@
+#include "core/DayShardedBacktest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <thread>
+
+#include "core/Backtester.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+constexpr timestamp_t kNsPerDay = 86'400'000'000'000ULL;
+
+std::string DayLabel(timestamp_t day_start) {
+  const std::time_t t = static_cast<std::time_t>(day_start / 1'000'000'000ULL);
+  std::tm tm{};
+  gmtime_r(&t, &tm);
+  char label[16];
+  std::strftime(label, sizeof(label), "%Y%m%d", &tm);
+  return label;
+}
+
+std::vector<std::string> FilesOf(const DataSourceConfig& dc) {
+  return dc.data_files.empty() ? std::vector<std::string>{dc.data_filepath} : dc.data_files;
+}
+
+bool NamesAnyDay(const std::string& file, const std::vector<std::string>& labels) {
+  const std::string name = std::filesystem::path(file).filename().string();
+  return std::any_of(labels.begin(), labels.end(), [&](const std::string& label) {
+    return name.find(label) != std::string::npos;
+  });
+}
+
+}  // namespace
+
+// MARK: Split
+std::vector<DayShard> SplitIntoDays(const AppConfig& config) {
+  std::vector<timestamp_t> day_starts;
+  for (timestamp_t day = config.start_time - config.start_time % kNsPerDay;
+       day <= config.end_time; day += kNsPerDay) {
+    day_starts.push_back(day);
+  }
+  std::vector<std::string> labels;
+  for (const timestamp_t day : day_starts) labels.push_back(DayLabel(day));
+
+  // Sources with no dated file at all are not split by day
+  std::vector<bool> dated(config.data_configs.size());
+  for (size_t s = 0; s < config.data_configs.size(); ++s) {
+    const auto files = FilesOf(config.data_configs[s]);
+    dated[s] = std::any_of(files.begin(), files.end(),
+                           [&](const std::string& f) { return NamesAnyDay(f, labels); });
+  }
+
+  std::vector<DayShard> shards;
+  for (size_t d = 0; d < day_starts.size(); ++d) {
+    DayShard shard{labels[d], config};
+    AppConfig& day = shard.config;
+    day.start_time = std::max(config.start_time, day_starts[d]);
+    day.end_time = std::min(config.end_time, day_starts[d] + kNsPerDay - 1);
+    day.report_output_dir = config.report_output_dir + "/days/" + labels[d];
+
+    day.data_configs.clear();
+    for (size_t s = 0; s < config.data_configs.size(); ++s) {
+      DataSourceConfig dc = config.data_configs[s];
+      if (dated[s]) {
+        std::vector<std::string> files;
+        for (const auto& f : FilesOf(dc)) {
+          if (NamesAnyDay(f, {labels[d]})) files.push_back(f);
+        }
+        if (files.empty()) continue;
+        dc.data_filepath = files.front();
+        dc.data_files = files.size() > 1 ? std::move(files) : std::vector<std::string>{};
+      }
+      day.data_configs.push_back(std::move(dc));
+    }
+    if (day.data_configs.empty()) {
+      spdlog::info("DayShardedBacktest: no data for {}, skipping", labels[d]);
+      continue;
+    }
+    shards.push_back(std::move(shard));
+  }
+  return shards;
+}
+
+// MARK: Stitch
+std::vector<EquitySnapshot> StitchEquityCurves(const std::vector<DayResult>& days,
+                                               money_t initial_cash) {
+  std::vector<EquitySnapshot> curve;
+  money_t carried_pnl = 0;       // equity gained by the earlier days
+  money_t carried_realized = 0;  // realized PnL of the earlier days
+  money_t peak = initial_cash;
+  for (const auto& day : days) {
+    if (!day.ok) continue;
+    for (EquitySnapshot snap : day.equity_curve) {
+      // the day's own peak, then the same peak in the chained curve
+      const money_t day_peak = snap.equity + snap.drawdown + carried_pnl;
+      snap.equity += carried_pnl;
+      snap.cash += carried_pnl;
+      snap.realized_pnl += carried_realized;
+      snap.drawdown = std::max(peak, day_peak) - snap.equity;
+      curve.push_back(snap);
+      peak = std::max(peak, day_peak);
+    }
+    peak = std::max(peak, day.final_equity + carried_pnl);
+    carried_pnl += day.final_equity - initial_cash;
+    carried_realized += day.final_realized_pnl;
+  }
+  return curve;
+}
+
+// MARK: Run
+bool DayShardedBacktest::Run() {
+  const std::vector<DayShard> shards = SplitIntoDays(config_);
+  if (shards.empty()) {
+    spdlog::error("DayShardedBacktest: no day in the window has data");
+    return false;
+  }
+
+  days_.assign(shards.size(), {});
+  for (size_t i = 0; i < shards.size(); ++i) days_[i].label = shards[i].label;
+
+  uint32_t threads = config_.day_threads;
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<uint32_t>(std::min<size_t>(threads, shards.size()));
+  spdlog::info("DayShardedBacktest: {} days on {} threads", shards.size(), threads);
+
+  const auto t0 = std::chrono::steady_clock::now();
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next.fetch_add(1); i < shards.size(); i = next.fetch_add(1)) {
+      RunDay(shards[i], days_[i]);
+    }
+  };
+  std::vector<std::thread> pool;
+  for (uint32_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();  // the calling thread is a worker too
+  for (auto& thread : pool) thread.join();
+
+  const double secs =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  const auto failed =
+      std::count_if(days_.begin(), days_.end(), [](const DayResult& d) { return !d.ok; });
+  spdlog::info("DayShardedBacktest: {} days in {:.3f}s, {} failed", days_.size(), secs, failed);
+
+  // Merged report over the whole window from every day that finished
+  std::vector<TradeRecord> trades;
+  std::vector<std::string> names;
+  for (const auto& day : days_) {
+    if (!day.ok) continue;
+    trades.insert(trades.end(), day.trades.begin(), day.trades.end());
+    if (names.empty()) names = day.strategy_names;
+  }
+  ReportGenerator report_generator(config_);
+  for (const auto& s : StitchEquityCurves(days_, config_.initial_cash)) {
+    report_generator.RecordEquitySnapshot(s.timestamp, s.equity, s.cash, s.realized_pnl,
+                                          s.unrealized_pnl, s.drawdown, s.has_open_position);
+  }
+  report_generator.GenerateReport(trades, names);
+  return failed == 0;
+}
+
+void DayShardedBacktest::RunDay(const DayShard& shard, DayResult& result) {
+  const AppConfig& config = shard.config;
+  try {
+    EventQueue event_queue;
+    DataReaderManager data_reader_manager;
+    if (!data_reader_manager.RegisterAndInitStreams(config.data_configs, config.start_time)) {
+      spdlog::error("DayShardedBacktest: {} could not open its data", shard.label);
+      return;
+    }
+    MarketStateManager market_state_manager;
+    market_state_manager.Initialize(config.active_instruments);
+    PortfolioManager portfolio_manager(config, market_state_manager);
+    ReportGenerator report_generator(config);
+    ExecutionHandler execution_handler(event_queue, config, market_state_manager);
+    StrategyManager strategy_manager(config);
+    strategy_manager.InitializeStrategies(market_state_manager);
+
+    // The event ring lives inline in Backtester and is too large for a worker's stack
+    auto backtester = std::make_unique<Backtester>(
+        event_queue, data_reader_manager, market_state_manager, portfolio_manager,
+        report_generator, execution_handler, strategy_manager, config);
+    if (backtester->RunLoopSingleThreaded() != 0) return;
+
+    result.trades = portfolio_manager.GetTradeHistory();
+    result.equity_curve = report_generator.EquityCurve();
+    result.strategy_names = strategy_manager.GetStrategyNames();
+    result.final_equity = portfolio_manager.GetTotalEquity();
+    result.final_realized_pnl = portfolio_manager.GetRealizedPnL();
+    result.summary = report_generator.Summary();
+    result.ok = true;
+  } catch (const std::exception& e) {
+    spdlog::error("DayShardedBacktest: {} failed: {}", shard.label, e.what());
+  }
+}
+
+}  // namespace backtester
@@ -1,38 +1,115 @@
 #include "core/EventQueue.h"
 
-#include <iostream>
-#include <queue>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
 
 namespace backtester {
 
+namespace {
+
+// Popped slots are reclaimed once they are the larger part of a lane that never runs dry
+constexpr size_t kCompactAfter = 64;
+
+}  // namespace
+
 void EventQueue::PushEvent(const EventUnion& event) {
-  pq_.push_back(event);
-  std::push_heap(pq_.begin(), pq_.end(), comparator_);
+  const EventHeader& hdr = Hdr(event);
+  const auto lane_idx = static_cast<size_t>(hdr.type);
+  Lane& lane = lanes_[lane_idx];
+  if (lane.head == lane.events.size() || Hdr(lane.events.back()).timestamp <= hdr.timestamp) {
+    lane.events.push_back(event);
+    lane_mask_ |= 1u << lane_idx;
+  } else {
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+      slab_[slot] = event;
+    } else {
+      slot = static_cast<uint32_t>(slab_.size());
+      slab_.push_back(event);
+    }
+    overflow_.push_back({hdr.timestamp, slot, hdr.type});
+    std::push_heap(overflow_.begin(), overflow_.end(), comparator_);
+  }
+  ++size_;
+  top_ = kNoTop;
 }
 
-bool EventQueue::IsEmpty() const { return pq_.empty(); }
+bool EventQueue::IsEmpty() const { return size_ == 0; }
+
+size_t EventQueue::TopSource() const {
+  if (top_ != kNoTop) return top_;
+  size_t best = kHeapSource;
+  // Lanes are in type order, so on equal timestamps the first lane found wins the tie
+  for (uint32_t mask = lane_mask_; mask != 0; mask &= mask - 1) {
+    const auto idx = static_cast<size_t>(std::countr_zero(mask));
+    const Lane& lane = lanes_[idx];
+    if (best == kHeapSource || Hdr(lane.events[lane.head]).timestamp <
+                                   Hdr(lanes_[best].events[lanes_[best].head]).timestamp) {
+      best = idx;
+    }
+  }
+  if (!overflow_.empty() && best != kHeapSource) {
+    const EventHeader& lane_top = Hdr(lanes_[best].events[lanes_[best].head]);
+    if (comparator_({lane_top.timestamp, 0, lane_top.type}, overflow_.front())) {
+      best = kHeapSource;
+    }
+  }
+  top_ = best;
+  return best;
+}
 
 const EventUnion& EventQueue::ReadTopEvent() const {
-  if (BT_UNLIKELY(pq_.empty())) {
+  if (BT_UNLIKELY(size_ == 0)) {
     throw std::out_of_range("Attempted to grab top event of empty queue");
   }
-  return pq_.front();
+  const size_t src = TopSource();
+  if (src == kHeapSource) return slab_[overflow_.front().slot];
+  return lanes_[src].events[lanes_[src].head];
 }
 
 EventUnion EventQueue::PopTopEvent() {
-  if (pq_.empty()) {
-    if (BT_UNLIKELY(pq_.empty())) {
-      throw std::out_of_range("Attempted to pop from empty queue");
+  if (BT_UNLIKELY(size_ == 0)) {
+    throw std::out_of_range("Attempted to pop from empty queue");
+  }
+  const size_t src = TopSource();
+  EventUnion top_event;
+  if (src == kHeapSource) {
+    std::pop_heap(overflow_.begin(), overflow_.end(), comparator_);
+    const uint32_t slot = overflow_.back().slot;
+    overflow_.pop_back();
+    top_event = slab_[slot];
+    free_slots_.push_back(slot);
+  } else {
+    Lane& lane = lanes_[src];
+    top_event = lane.events[lane.head++];
+    if (lane.head == lane.events.size()) {
+      lane.events.clear();
+      lane.head = 0;
+      lane_mask_ &= ~(1u << src);
+    } else if (lane.head >= kCompactAfter && lane.head * 2 >= lane.events.size()) {
+      lane.events.erase(lane.events.begin(),
+                        lane.events.begin() + static_cast<std::ptrdiff_t>(lane.head));
+      lane.head = 0;
     }
   }
-  std::pop_heap(pq_.begin(), pq_.end(), comparator_);
-  EventUnion top_event = pq_.back();
-  pq_.pop_back();
+  --size_;
+  top_ = kNoTop;
   return top_event;
 }
 
-size_t EventQueue::size() const { return pq_.size(); }
+size_t EventQueue::size() const { return size_; }
 
-void EventQueue::clear() { pq_ = std::vector<EventUnion>(); }
+void EventQueue::clear() {
+  for (auto& lane : lanes_) lane = Lane{};
+  lane_mask_ = 0;
+  overflow_ = std::vector<Key>();
+  slab_ = std::vector<EventUnion>();
+  free_slots_ = std::vector<uint32_t>();
+  size_ = 0;
+  top_ = kNoTop;
+}
 
-}  // namespace backtester
\ No newline at end of file
+}  // namespace backtester
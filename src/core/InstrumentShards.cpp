@@ -0,0 +1,200 @@
+#include "core/InstrumentShards.h"
+
+#include "core/Backtester.h"
+#include "spdlog/spdlog.h"
+#include "utils/StageProfiler.h"
+
+namespace backtester {
+
+InstrumentShards::InstrumentShards(size_t shard_count, const AppConfig& config)
+    : route_(std::make_unique<SPSCRing<uint16_t, kRouteCapacity>>()),
+      route_ready_(config.ring_wait),
+      route_space_(config.ring_wait) {
+  for (size_t s = 0; s < shard_count; ++s) {
+    shards_.push_back(std::make_unique<Shard>(config.ring_wait));
+  }
+
+  std::vector<std::vector<uint32_t>> active(shard_count);
+  for (const uint32_t id : config.active_instruments) active[ShardOf(id)].push_back(id);
+  for (size_t s = 0; s < shard_count; ++s) {
+    Shard& shard = *shards_[s];
+    shard.book.Initialize(active[s]);
+    const auto& known = shard.book.GetMarketSnapshots();
+    for (const auto& instr : config.traded_instruments) {
+      if (known.contains(instr.instrument_id)) {
+        shard.traded.emplace_back(instr.instrument_id, instr.tick_size);
+      }
+    }
+  }
+  for (auto& shard : shards_) {
+    shard->thread = std::thread(&InstrumentShards::WorkerLoop, this, std::ref(*shard));
+  }
+}
+
+InstrumentShards::~InstrumentShards() {
+  Detach(0);
+  for (auto& shard : shards_) {
+    shard->input_ready.NotifyNow();  // the router is gone by now
+    if (shard->thread.joinable()) shard->thread.join();
+  }
+}
+
+// MARK: Router
+bool InstrumentShards::Route(const EventUnion& ev) {
+  const auto s = static_cast<uint16_t>(ShardOf(MarketInstrumentId(ev)));
+  Shard& shard = *shards_[s];
+  EventUnion* slot = shard.input->PrepareWrite();
+  if (!slot) {
+    FlushRouter();
+    shard.input_space.Wait([&] {  // that shard's worker is behind
+      return shard.input->PrepareWrite() != nullptr ||
+             detached_.load(std::memory_order_acquire) ||
+             shard.failed.load(std::memory_order_acquire);
+    });
+    slot = shard.input->PrepareWrite();
+    if (!slot) return false;
+  }
+  *slot = ev;
+  shard.input->CommitWrite();
+  shard.input_ready.Notify();
+
+  uint16_t* route = route_->PrepareWrite();
+  if (!route) {
+    FlushRouter();
+    route_space_.Wait([&] {  // the reader is a full route ring behind
+      return route_->PrepareWrite() != nullptr || detached_.load(std::memory_order_acquire);
+    });
+    route = route_->PrepareWrite();
+    if (!route) return false;
+  }
+  *route = s;
+  route_->CommitWrite();
+  route_ready_.Notify();
+  return true;
+}
+
+void InstrumentShards::Close() {
+  closed_.store(true, std::memory_order_release);
+  FlushRouter();
+}
+
+void InstrumentShards::Fail() {
+  failed_.store(true, std::memory_order_relaxed);
+  Close();  // the release store publishes failed_ to a reader that sees the close
+}
+
+void InstrumentShards::FlushRouter() {
+  route_ready_.NotifyNow();
+  for (auto& shard : shards_) shard->input_ready.NotifyNow();
+}
+
+void InstrumentShards::Join() {
+  for (auto& shard : shards_) {
+    if (shard->thread.joinable()) shard->thread.join();
+  }
+  for (size_t s = 0; s < shards_.size(); ++s) {
+    spdlog::info("Book shard {}: {} events, {} traded instruments", s, shards_[s]->events,
+                 shards_[s]->traded.size());
+  }
+  for (auto& shard : shards_) {
+    if (shard->error) std::rethrow_exception(shard->error);
+  }
+}
+
+// MARK: Worker
+void InstrumentShards::WorkerLoop(Shard& shard) {
+  try {
+    while (true) {
+      const EventUnion* ev = shard.input->PeekRead();
+      if (!ev) {
+        FlushWorker(shard);
+        shard.input_ready.Wait([&] {
+          return shard.input->PeekRead() != nullptr || closed_.load(std::memory_order_acquire) ||
+                 detached_.load(std::memory_order_acquire);
+        });
+        // re-check: the router may have routed its last event right before the flag
+        ev = shard.input->PeekRead();
+        if (!ev) break;
+      }
+
+      MarketFrame* frame = shard.output->PrepareWrite();
+      if (!frame) {
+        FlushWorker(shard);
+        shard.output_space.Wait([&] {  // the reader is busy with other shards' frames
+          return shard.output->PrepareWrite() != nullptr ||
+                 detached_.load(std::memory_order_acquire);
+        });
+        frame = shard.output->PrepareWrite();
+        if (!frame) break;
+      }
+      BT_PROFILE_STAGE(Stage::kBookApply);
+      ApplyToFrame(shard.book, *ev, shard.traded, *frame);
+      shard.input->CommitRead();
+      shard.input_space.Notify();
+      shard.output->CommitWrite();
+      shard.output_ready.Notify();
+      ++shard.events;
+    }
+  } catch (...) {
+    shard.error = std::current_exception();
+    shard.failed.store(true, std::memory_order_release);
+  }
+  FlushWorker(shard);  // the reader or the router may be waiting on this shard
+}
+
+void InstrumentShards::FlushWorker(Shard& shard) {
+  shard.output_ready.NotifyNow();
+  shard.input_space.NotifyNow();
+}
+
+// MARK: Reader
+const MarketFrame* InstrumentShards::WaitRead(size_t /*reader*/) {
+  const uint16_t* route = route_->PeekRead();
+  if (!route) {
+    FlushReader();
+    route_ready_.Wait([&] {
+      return route_->PeekRead() != nullptr || closed_.load(std::memory_order_acquire);
+    });
+    route = route_->PeekRead();  // re-check after the flag, as above
+    if (!route) return nullptr;
+  }
+  reading_ = *route;
+  Shard& shard = *shards_[reading_];
+  const MarketFrame* frame = shard.output->PeekRead();
+  if (!frame) {
+    FlushReader();
+    shard.output_ready.Wait([&] {
+      return shard.output->PeekRead() != nullptr || shard.failed.load(std::memory_order_acquire);
+    });
+    frame = shard.output->PeekRead();  // nullptr if the worker failed first
+  }
+  return frame;
+}
+
+void InstrumentShards::CommitRead(size_t /*reader*/) {
+  Shard& shard = *shards_[reading_];
+  shard.output->CommitRead();
+  shard.output_space.Notify();
+  route_->CommitRead();
+  route_space_.Notify();
+}
+
+void InstrumentShards::Detach(size_t /*reader*/) {
+  detached_.store(true, std::memory_order_release);
+  FlushReader();
+}
+
+bool InstrumentShards::Failed() const {
+  if (failed_.load(std::memory_order_acquire)) return true;
+  for (const auto& shard : shards_) {
+    if (shard->failed.load(std::memory_order_acquire)) return true;
+  }
+  return false;
+}
+
+void InstrumentShards::FlushReader() {
+  route_space_.NotifyNow();
+  for (auto& shard : shards_) shard->output_space.NotifyNow();
+}
+
+}  // namespace backtester
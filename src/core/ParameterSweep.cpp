@@ -0,0 +1,271 @@
+#include "core/ParameterSweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+#include "core/Backtester.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+// MARK: Grid
+std::vector<std::vector<int>> ExpandSweepGrid(const SweepConfig& sweep) {
+  std::vector<std::vector<int>> combos;
+  if (sweep.axes.empty()) return combos;
+  std::vector<size_t> digits(sweep.axes.size(), 0);
+  while (true) {
+    std::vector<int>& combo = combos.emplace_back();
+    for (size_t a = 0; a < sweep.axes.size(); ++a) {
+      combo.push_back(sweep.axes[a].values[digits[a]]);
+    }
+    // Odometer step, last axis fastest
+    size_t a = sweep.axes.size();
+    while (a > 0) {
+      --a;
+      if (++digits[a] < sweep.axes[a].values.size()) break;
+      digits[a] = 0;
+      if (a == 0) return combos;
+    }
+  }
+}
+
+AppConfig ApplySweepCombo(const AppConfig& base, const std::vector<int>& values,
+                          const std::string& report_dir) {
+  AppConfig config = base;
+  for (size_t a = 0; a < base.sweep.axes.size() && a < values.size(); ++a) {
+    const SweepAxis& axis = base.sweep.axes[a];
+    config.strategies[axis.strategy_index].params[axis.param_index] = values[a];
+  }
+  config.report_output_dir = report_dir;
+  return config;
+}
+
+// MARK: Run
+bool ParameterSweep::Run() {
+  const auto combos = ExpandSweepGrid(config_.sweep);
+  if (combos.empty()) {
+    spdlog::error("ParameterSweep: no sweep grid configured");
+    return false;
+  }
+
+  const auto arena = EventArena::Build(config_.data_configs, config_.start_time);
+  if (!arena) return false;
+
+  const std::string sweep_dir = config_.report_output_dir + "/sweep";
+  results_.assign(combos.size(), {});
+  for (size_t i = 0; i < combos.size(); ++i) {
+    results_[i].combo = i;
+    results_[i].values = combos[i];
+    results_[i].report_dir = fmt::format("{}/combo_{:04}", sweep_dir, i);
+  }
+
+  uint32_t threads = config_.sweep.threads;
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<uint32_t>(std::min<size_t>(threads, combos.size()));
+
+  const auto t0 = std::chrono::steady_clock::now();
+  if (config_.sweep.share_book) {
+    spdlog::info("ParameterSweep: {} combinations, {} replicas per shared book pass",
+                 combos.size(), threads);
+    for (size_t first = 0; first < results_.size(); first += threads) {
+      const size_t n = std::min<size_t>(threads, results_.size() - first);
+      RunSharedPass(std::span<SweepResult>(results_).subspan(first, n), arena);
+    }
+  } else {
+    spdlog::info("ParameterSweep: {} combinations on {} threads", combos.size(), threads);
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+      for (size_t i = next.fetch_add(1); i < results_.size(); i = next.fetch_add(1)) {
+        RunCombo(results_[i], arena);
+      }
+    };
+    std::vector<std::thread> pool;
+    for (uint32_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();  // the calling thread is a worker too
+    for (auto& thread : pool) thread.join();
+  }
+
+  const double secs =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  const auto failed = std::count_if(results_.begin(), results_.end(),
+                                    [](const SweepResult& r) { return !r.ok; });
+  spdlog::info("ParameterSweep: {} combinations in {:.3f}s, {} failed", results_.size(), secs,
+               failed);
+
+  const std::string ranking_path = config_.report_output_dir + "/sweep_ranking.csv";
+  if (!WriteRanking(ranking_path, config_, Rank(results_))) return false;
+  return failed == 0;
+}
+
+void ParameterSweep::RunCombo(SweepResult& result,
+                              const std::shared_ptr<const EventArena>& arena) const {
+  // Every component holds a reference to its config, so the copy lives for the whole run
+  const AppConfig config = ApplySweepCombo(config_, result.values, result.report_dir);
+  try {
+    EventQueue event_queue;
+    DataReaderManager data_reader_manager;
+    data_reader_manager.UseArena(arena);
+    if (!data_reader_manager.RegisterAndInitStreams(config.data_configs, config.start_time)) {
+      spdlog::error("ParameterSweep: combination {} could not open its data", result.combo);
+      return;
+    }
+    MarketStateManager market_state_manager;
+    market_state_manager.Initialize(config.active_instruments);
+    PortfolioManager portfolio_manager(config, market_state_manager);
+    ReportGenerator report_generator(config);
+    ExecutionHandler execution_handler(event_queue, config, market_state_manager);
+    StrategyManager strategy_manager(config);
+    strategy_manager.InitializeStrategies(market_state_manager);
+
+    // The event ring lives inline in Backtester and is too large for a worker's stack
+    auto backtester = std::make_unique<Backtester>(
+        event_queue, data_reader_manager, market_state_manager, portfolio_manager,
+        report_generator, execution_handler, strategy_manager, config);
+    if (backtester->RunLoopSingleThreaded() != 0) return;
+    result.summary = report_generator.Summary();
+    result.ok = true;
+  } catch (const std::exception& e) {
+    spdlog::error("ParameterSweep: combination {} failed: {}", result.combo, e.what());
+  }
+}
+
+// MARK: Shared Pass
+namespace {
+
+// Strategy stack of one combination in a shared-book pass, reading the market through its
+// own snapshot view. Every component holds a reference to `config`, so they live together.
+struct Replica {
+  Replica(AppConfig cfg, DataReaderManager& drm, MarketStateManager& book)
+      : config(std::move(cfg)),
+        view(config.traded_instruments),
+        portfolio_manager(config, view),
+        report_generator(config),
+        execution_handler(event_queue, config, view),
+        strategy_manager(config) {
+    strategy_manager.InitializeStrategies(view);
+    backtester = std::make_unique<Backtester>(event_queue, drm, book, portfolio_manager,
+                                              report_generator, execution_handler,
+                                              strategy_manager, config);
+  }
+
+  AppConfig config;
+  EventQueue event_queue;
+  SnapshotMarketDataProvider view;
+  PortfolioManager portfolio_manager;
+  ReportGenerator report_generator;
+  ExecutionHandler execution_handler;
+  StrategyManager strategy_manager;
+  std::unique_ptr<Backtester> backtester;
+};
+
+}  // namespace
+
+void ParameterSweep::RunSharedPass(std::span<SweepResult> batch,
+                                   const std::shared_ptr<const EventArena>& arena) const {
+  DataReaderManager data_reader_manager;
+  data_reader_manager.UseArena(arena);
+  if (!data_reader_manager.RegisterAndInitStreams(config_.data_configs, config_.start_time)) {
+    spdlog::error("ParameterSweep: shared pass could not open its data");
+    return;
+  }
+  MarketStateManager book;
+  book.Initialize(config_.active_instruments);
+
+  std::vector<std::unique_ptr<Replica>> replicas;
+  std::vector<SweepResult*> owners;
+  for (auto& result : batch) {
+    try {
+      replicas.push_back(std::make_unique<Replica>(
+          ApplySweepCombo(config_, result.values, result.report_dir), data_reader_manager, book));
+      owners.push_back(&result);
+    } catch (const std::exception& e) {
+      spdlog::error("ParameterSweep: combination {} failed: {}", result.combo, e.what());
+    }
+  }
+  if (replicas.empty()) return;
+
+  auto frames = std::make_unique<Backtester::FrameRing>(replicas.size(), config_.ring_wait);
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    pool.emplace_back([&, i]() {
+      try {
+        if (replicas[i]->backtester->RunReplica(*frames, i, replicas[i]->view) != 0) return;
+        owners[i]->summary = replicas[i]->report_generator.Summary();
+        owners[i]->ok = true;
+      } catch (const std::exception& e) {
+        frames->Detach(i);  // don't hold the book thread back
+        spdlog::error("ParameterSweep: combination {} failed: {}", owners[i]->combo, e.what());
+      }
+    });
+  }
+  // Any replica's Backtester can build the book: publishing touches only its sources and book
+  bool book_ok = true;
+  try {
+    replicas.front()->backtester->PublishFrames(*frames);
+  } catch (const std::exception& e) {
+    book_ok = false;
+    frames->Fail();  // let the replicas drain and stop without writing reports
+    spdlog::error("ParameterSweep: shared book failed: {}", e.what());
+  }
+  for (auto& thread : pool) thread.join();
+  if (!book_ok) {
+    for (auto* owner : owners) owner->ok = false;
+  }
+}
+
+// MARK: Ranking
+std::vector<SweepResult> ParameterSweep::Rank(const std::vector<SweepResult>& results) {
+  std::vector<SweepResult> ranked;
+  std::copy_if(results.begin(), results.end(), std::back_inserter(ranked),
+               [](const SweepResult& r) { return r.ok; });
+  std::stable_sort(ranked.begin(), ranked.end(), [](const SweepResult& a, const SweepResult& b) {
+    if (a.summary.sharpe_ratio != b.summary.sharpe_ratio) {
+      return a.summary.sharpe_ratio > b.summary.sharpe_ratio;
+    }
+    if (a.summary.total_pnl != b.summary.total_pnl) {
+      return a.summary.total_pnl > b.summary.total_pnl;
+    }
+    return a.combo < b.combo;
+  });
+  return ranked;
+}
+
+bool ParameterSweep::WriteRanking(const std::string& filepath, const AppConfig& config,
+                                  const std::vector<SweepResult>& ranked) {
+  const auto parent = std::filesystem::path(filepath).parent_path();
+  if (!parent.empty()) std::filesystem::create_directories(parent);
+  std::ofstream file(filepath);
+  if (!file.is_open()) {
+    spdlog::error("ParameterSweep: Failed to open {}", filepath);
+    return false;
+  }
+
+  // One column per axis, named <strategy>.p<slot>
+  file << "rank,combo";
+  for (const auto& axis : config.sweep.axes) {
+    file << "," << config.strategies[axis.strategy_index].name << ".p" << axis.param_index;
+  }
+  file << ",total_pnl,total_return_pct,sharpe_ratio,sortino_ratio,max_drawdown_pct,"
+          "total_trades,win_rate_pct,report_dir\n";
+
+  file << std::fixed << std::setprecision(4);
+  for (size_t rank = 0; rank < ranked.size(); ++rank) {
+    const SweepResult& r = ranked[rank];
+    const PerformanceSummary& s = r.summary;
+    file << rank + 1 << "," << r.combo;
+    for (int value : r.values) file << "," << value;
+    file << "," << ReportGenerator::FormatScaledPrice(s.total_pnl) << ","
+         << s.total_return_pct * 100.0 << "," << s.sharpe_ratio << "," << s.sortino_ratio << ","
+         << s.max_drawdown_pct * 100.0 << "," << s.total_trades << ","
+         << s.win_rate_pct * 100.0 << "," << r.report_dir << "\n";
+  }
+  spdlog::info("ParameterSweep: ranking of {} combinations written to {}", ranked.size(),
+               filepath);
+  return true;
+}
+
+}  // namespace backtester
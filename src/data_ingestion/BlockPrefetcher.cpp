@@ -0,0 +1,148 @@
+#include "data_ingestion/BlockPrefetcher.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+BlockPrefetcher::BlockPrefetcher(size_t depth, size_t block_bytes)
+    : depth_(depth), block_bytes_(block_bytes > 0 ? block_bytes : kDefaultBlockBytes) {}
+
+BlockPrefetcher::~BlockPrefetcher() { Close(); }
+
+// MARK: OPEN
+bool BlockPrefetcher::Open(const std::string& filename, size_t offset) {
+  Close();
+  fd_ = ::open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) return false;
+  ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  start_offset_ = offset;
+  inline_offset_ = offset;
+  failed_ = false;
+
+  slots_.resize(depth_ > 0 ? depth_ : 1);
+  for (auto& slot : slots_) slot.data.resize(block_bytes_);
+
+  stop_ = false;
+  if (depth_ > 0) thread_ = std::thread(&BlockPrefetcher::ReaderLoop, this);
+  return true;
+}
+
+// MARK: CLOSE
+void BlockPrefetcher::Close() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stop_ = true;
+  }
+  free_cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  produced_ = 0;
+  released_ = 0;
+  taken_ = 0;
+  holding_ = false;
+  at_end_ = false;
+  stalls_ = 0;
+  inline_offset_ = 0;
+}
+
+// MARK: NEXT BLOCK
+std::span<const char> BlockPrefetcher::NextBlock() {
+  if (fd_ < 0 || at_end_) return {};
+
+  if (depth_ == 0) {
+    Slot& slot = slots_[0];
+    slot.size = ReadBlock(slot.data.data(), inline_offset_, slot.failed);
+    if (slot.failed) {
+      failed_ = true;
+      at_end_ = true;
+      return {};
+    }
+    inline_offset_ += slot.size;
+    at_end_ = slot.size == 0;
+    return {slot.data.data(), slot.size};
+  }
+
+  Slot* slot;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (holding_) {
+      ++released_;
+      holding_ = false;
+      free_cv_.notify_one();
+    }
+    if (produced_ == taken_) {
+      ++stalls_;
+      filled_cv_.wait(lk, [this] { return produced_ > taken_; });
+    }
+    slot = &slots_[taken_ % depth_];
+    ++taken_;
+    holding_ = true;
+  }
+
+  if (slot->failed || slot->size == 0) {
+    failed_ = slot->failed;
+    at_end_ = true;
+    return {};
+  }
+  return {slot->data.data(), slot->size};
+}
+
+// MARK: READER LOOP
+// Publishes every block of the file followed by one empty block that marks the end, or
+// stops at the first block whose read failed.
+void BlockPrefetcher::ReaderLoop() {
+  size_t offset = start_offset_;
+  while (true) {
+    Slot* slot;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      free_cv_.wait(lk, [this] { return stop_ || produced_ - released_ < depth_; });
+      if (stop_) return;
+      slot = &slots_[produced_ % depth_];
+    }
+
+    slot->size = ReadBlock(slot->data.data(), offset, slot->failed);
+    offset += slot->size;
+    const bool last = slot->failed || slot->size == 0;
+
+    {
+      std::lock_guard<std::mutex> lk(mutex_);
+      ++produced_;
+    }
+    filled_cv_.notify_one();
+    if (last) return;
+  }
+}
+
+// Fills up to one block starting at `offset`; short only at end of file. A read error is
+// logged and sets `failed`, and the caller drops the block.
+size_t BlockPrefetcher::ReadBlock(char* dst, size_t offset, bool& failed) const {
+  failed = false;
+  size_t got = 0;
+  while (got < block_bytes_) {
+    const ssize_t n = ::pread(fd_, dst + got, block_bytes_ - got,
+                              static_cast<off_t>(offset + got));
+    if (n == 0) break;
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      spdlog::error("BlockPrefetcher: read failed at offset {}: {}", offset + got,
+                    std::strerror(errno));
+      failed = true;
+      break;
+    }
+    got += static_cast<size_t>(n);
+  }
+  return got;
+}
+
+}  // namespace backtester
@@ -0,0 +1,163 @@
+#include "data_ingestion/CsvReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "core/Constants.h"
+#include "data_ingestion/MboCsvParser.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+// Prefetch this far ahead of the cursor, one window at a time. Also the SIMD parse step.
+constexpr size_t kReadAheadBytes = size_t{8} << 20;
+}  // namespace
+
+CsvReader::~CsvReader() { Close(); }
+
+// MARK: OPEN
+bool CsvReader::Open(const std::string& filename) {
+  Close();
+
+  fd_ = ::open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    Close();
+    return false;
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ == 0) return true;  // valid, just empty
+
+  void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (map == MAP_FAILED) {
+    spdlog::error("CsvReader: mmap failed for {}", filename);
+    Close();
+    return false;
+  }
+  data_ = static_cast<const char*>(map);
+
+  ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  ::madvise(map, size_, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+  ::madvise(map, size_, MADV_HUGEPAGE);  // honoured only where the fs supports file THP
+#endif
+  ReadAhead();
+
+  if (ProducesEvents()) {
+    // Event mode checks its own header; line mode leaves it to DataReaderManager.
+    std::string_view header;
+    if (!ReadLineView(header) || header != kExpectedMboHeader) {
+      spdlog::error("CsvReader: unexpected header in {}", filename);
+      Close();
+      return false;
+    }
+    events_.reserve(kReadAheadBytes / 64);
+  }
+  return true;
+}
+
+// MARK: CLOSE
+void CsvReader::Close() {
+  if (data_) {
+    ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+  pos_ = 0;
+  next_readahead_ = 0;
+  events_.clear();
+  cursor_ = 0;
+}
+
+// MARK: READLINE
+bool CsvReader::ReadLine(std::string& line) {
+  std::string_view view;
+  if (!ReadLineView(view)) {
+    line.clear();
+    return false;
+  }
+  line.assign(view);
+  return true;
+}
+
+// MARK: SEEK
+bool CsvReader::Seek(uint64_t position) {
+  if (!data_ || position >= size_ || (position > 0 && data_[position - 1] != '\n')) {
+    return false;
+  }
+  pos_ = position;
+  events_.clear();
+  cursor_ = 0;
+  ReadAhead();
+  return true;
+}
+
+// MARK: READ AHEAD
+// Asks the kernel for the window after the one the cursor just entered, so page faults
+// on the mapping find the data already cached.
+void CsvReader::ReadAhead() {
+  const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t start = (pos_ / page) * page;
+  if (start >= size_) {
+    next_readahead_ = SIZE_MAX;
+    return;
+  }
+  const size_t len = std::min(2 * kReadAheadBytes, size_ - start);
+  ::madvise(const_cast<char*>(data_) + start, len, MADV_WILLNEED);
+  next_readahead_ = pos_ + kReadAheadBytes;
+}
+
+// MARK: READ EVENTS
+size_t CsvReader::ReadEvents(std::span<MarketByOrderEvent> out) {
+  if (!ProducesEvents()) return IDataReader::ReadEvents(out);
+
+  size_t n = 0;
+  while (n < out.size()) {
+    if (cursor_ >= events_.size() && !ParseNextWindow()) break;
+    const size_t take = std::min(out.size() - n, events_.size() - cursor_);
+    std::memcpy(out.data() + n, events_.data() + cursor_, take * sizeof(MarketByOrderEvent));
+    cursor_ += take;
+    n += take;
+  }
+  return n;
+}
+
+bool CsvReader::ParseNextWindow() {
+  events_.clear();
+  cursor_ = 0;
+  while (events_.empty() && pos_ < size_) {
+    const size_t end = std::min(size_, pos_ + kReadAheadBytes);
+    size_t consumed = ParseMboBlock({data_ + pos_, end - pos_}, config_, delims_, events_);
+    if (consumed == 0) {
+      if (end < size_) {
+        // Row longer than a window: parse through its newline
+        const auto* nl = static_cast<const char*>(std::memchr(data_ + end, '\n', size_ - end));
+        const size_t stop = nl ? static_cast<size_t>(nl - data_) + 1 : size_;
+        consumed = ParseMboBlock({data_ + pos_, stop - pos_}, config_, delims_, events_);
+      }
+      if (consumed == 0) {
+        // Final row without a trailing newline
+        std::string last(data_ + pos_, size_ - pos_);
+        last.push_back('\n');
+        ParseMboBlock(last, config_, delims_, events_);
+        consumed = size_ - pos_;
+      }
+    }
+    pos_ += consumed;
+    if (pos_ >= next_readahead_) ReadAhead();
+  }
+  return !events_.empty();
+}
+
+}  // namespace backtester
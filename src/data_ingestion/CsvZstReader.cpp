@@ -1,5 +1,8 @@
 #include "data_ingestion/CsvZstReader.h"
 
+#include <cstring>
+
+#include "data_ingestion/ZstdFraming.h"
 #include "spdlog/spdlog.h"
 
 namespace backtester {
@@ -14,11 +17,9 @@ bool CsvZstReader::Open(const std::string& filename) {
   output_pos_ = 0;
   output_size_ = 0;
   eof_reached_ = false;
+  filename_ = filename;
 
-  // Binary required for compressed data
-  file_.open(filename, std::ios::binary);
-
-  if (!file_.is_open()) return false;
+  if (!file_.Open(filename)) return false;
 
   // Create ZSTD decompression stream context
   dstream_ = ZSTD_createDStream();
@@ -30,13 +31,14 @@ bool CsvZstReader::Open(const std::string& filename) {
 }
 // MARK: CLOSE
 void CsvZstReader::Close() {
-  // Close file if it's open
-  if (file_.is_open()) file_.close();
+  // Close file and stop its prefetch thread
+  file_.Close();
   // Free ZSTD decompression context if it exists
   if (dstream_) {
     ZSTD_freeDStream(dstream_);
     dstream_ = nullptr;
   }
+  input_block_ = {};
   input_pos_ = 0;
   input_valid_size_ = 0;
   output_pos_ = 0;
@@ -44,45 +46,71 @@ void CsvZstReader::Close() {
   eof_reached_ = true;
 }
 
+// MARK: SEEK
+bool CsvZstReader::Seek(uint64_t position) {
+  if (!dstream_ || !IsZstdFrameAt(filename_, position)) return false;
+  if (!file_.Open(filename_, position)) return false;
+  ZSTD_DCtx_reset(dstream_, ZSTD_reset_session_only);
+  input_block_ = {};
+  input_pos_ = 0;
+  input_valid_size_ = 0;
+  output_pos_ = 0;
+  output_size_ = 0;
+  eof_reached_ = false;
+  carry_.clear();
+  return true;
+}
+
 // MARK: READLINE
 bool CsvZstReader::ReadLine(std::string& line) {
-  line.clear();
+  std::string_view view;
+  if (!ReadLineView(view)) {
+    line.clear();
+    return false;
+  }
+  line.assign(view);
+  return true;
+}
+
+// MARK: READLINEVIEW
+bool CsvZstReader::ReadLineView(std::string_view& line) {
+  carry_.clear();
 
   while (true) {
     // 1. Scan for newline
-    for (size_t i = output_pos_; i < output_size_; ++i) {
-      if (output_buffer_[i] == '\n') {
-        line.append(output_buffer_.data() + output_pos_, i - output_pos_);
-
-        if (!line.empty() && line.back() == '\r') {
-          line.pop_back();
-        }
-
-        output_pos_ = i + 1;
-        return true;
+    const char* begin = output_buffer_.data() + output_pos_;
+    const auto* nl =
+        static_cast<const char*>(std::memchr(begin, '\n', output_size_ - output_pos_));
+    if (nl) {
+      const size_t len = static_cast<size_t>(nl - begin);
+      output_pos_ += len + 1;
+      if (carry_.empty()) {
+        line = std::string_view(begin, len);
+      } else {
+        carry_.append(begin, len);
+        line = carry_;
       }
+      if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+      return true;
     }
 
-    // 2. No newline found - consume EVERYTHING remaining in buffer
-    if (output_pos_ < output_size_) {
-      line.append(output_buffer_.data() + output_pos_, output_size_ - output_pos_);
-
-      // Mark this data as consumed.
-      // If you don't do this, FillBuffer thinks the buffer is full of unread data,
-      // returns true immediately, and you append the same text again forever.
-      output_pos_ = output_size_;
-    }
+    // 2. No newline found - carry the partial line over the refill.
+    // Marking it consumed matters: FillBuffer returns early while output has unread data.
+    carry_.append(begin, output_size_ - output_pos_);
+    output_pos_ = output_size_;
 
     // 3. Buffer is exhausted, try to fill it with more data
     if (!FillBuffer()) {
-      // EOF reached. Return true if we have any data left in 'line'
-      return !line.empty();
+      // EOF reached. Return true if we have any data left in the carry
+      line = carry_;
+      if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+      return !carry_.empty();
     }
   }
 }
 
 // MARK: FILLBUFFER
-// Reads compressed data from file and decompresses it into output buffer
+// Takes compressed blocks from the prefetcher and decompresses them into output buffer
 bool CsvZstReader::FillBuffer() {
   if (!dstream_) return false;
   // If output still has data (rare logic case, but safe to check)
@@ -96,15 +124,12 @@ bool CsvZstReader::FillBuffer() {
 
   // Loop until we have produced some output or truly hit EOF
   while (output.pos == 0) {
-    // 1. REFILL INPUT: Only read from disk if we have consumed previous input
+    // 1. REFILL INPUT: Only take the next block once the previous one is consumed
     if (input_pos_ >= input_valid_size_) {
-      if (file_.eof()) {
-        eof_reached_ = true;
-        return false;
-      }
+      if (eof_reached_) return false;
 
-      file_.read(input_buffer_.data(), static_cast<int32_t>(input_buffer_.size()));
-      input_valid_size_ = static_cast<size_t>(file_.gcount());
+      input_block_ = file_.NextBlock();
+      input_valid_size_ = input_block_.size();
       input_pos_ = 0;  // Reset position to start of buffer
 
       if (input_valid_size_ == 0) {
@@ -114,7 +139,7 @@ bool CsvZstReader::FillBuffer() {
     }
 
     // 2. DECOMPRESS: Set up input pointing to CURRENT position
-    ZSTD_inBuffer input = {input_buffer_.data(), input_valid_size_, input_pos_};
+    ZSTD_inBuffer input = {input_block_.data(), input_valid_size_, input_pos_};
 
     size_t ret = ZSTD_decompressStream(dstream_, &output, &input);
 
@@ -145,7 +170,7 @@ bool CsvZstReader::FillBuffer() {
 //
 // Call fillBuffer() ← HERE
 //
-// Read compressed data from disk
+// Take the next compressed block (already read by the prefetch thread)
 //
 // Decompress into output buffer
 //
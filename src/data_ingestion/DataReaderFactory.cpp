@@ -0,0 +1,66 @@
+#include "data_ingestion/DataReaderFactory.h"
+
+#include "data_ingestion/CsvReader.h"
+#include "data_ingestion/CsvZstReader.h"
+#include "data_ingestion/DbnMboReader.h"
+#include "data_ingestion/MboCacheReader.h"
+#include "data_ingestion/MultiFileReader.h"
+#include "data_ingestion/ParallelCsvZstReader.h"
+#include "data_ingestion/SimdCsvZstReader.h"
+#include "data_ingestion/ZstdFraming.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+std::unique_ptr<IDataReader> MakeCsvZstReader(const DataSourceConfig& source) {
+  if (source.decode_threads > 1) {
+    if (CountZstdFrames(source.data_filepath) > 1) {
+      return std::make_unique<ParallelCsvZstReader>(source, source.decode_threads);
+    }
+    spdlog::warn("{} is a single zstd frame, decoding on one thread. Run 'reframe' first",
+                 source.data_filepath);
+  }
+  if (source.parser == CsvParser::SIMD) return std::make_unique<SimdCsvZstReader>(source);
+  return std::make_unique<CsvZstReader>(source.prefetch_blocks);
+}
+
+// Bars and MBP-10 rows are parsed row by row in DataReaderManager, so only the line readers
+// apply.
+std::unique_ptr<IDataReader> MakeLineReader(const DataSourceConfig& source) {
+  if (source.encoding != Encoding::CSV) {
+    spdlog::error("OHLCV/MBP-10 stream {} must be CSV encoded", source.data_source_name);
+    return nullptr;
+  }
+  if (source.compression == Compression::ZSTD) {
+    return std::make_unique<CsvZstReader>(source.prefetch_blocks);
+  }
+  DataSourceConfig lines = source;
+  lines.parser = CsvParser::SCALAR;
+  return std::make_unique<CsvReader>(lines);
+}
+
+}  // namespace
+
+// MARK: MakeDataReader
+std::unique_ptr<IDataReader> MakeDataReader(const DataSourceConfig& source) {
+  if (source.data_files.size() > 1) return std::make_unique<MultiFileReader>(source);
+  if (source.schema != DataSchema::MBO) return MakeLineReader(source);
+
+  switch (source.encoding) {
+    case Encoding::MBOCACHE:
+      return std::make_unique<MboCacheReader>();
+    case Encoding::DBN:
+      return std::make_unique<DbnMboReader>(source);
+    case Encoding::CSV:
+      if (source.compression == Compression::NONE) return std::make_unique<CsvReader>(source);
+      return MakeCsvZstReader(source);
+    case Encoding::JSON:
+      break;
+  }
+  spdlog::error("No reader for the encoding/compression of stream {}", source.data_source_name);
+  return nullptr;
+}
+
+}  // namespace backtester
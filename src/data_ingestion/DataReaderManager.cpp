@@ -1,48 +1,135 @@
 #include "data_ingestion/DataReaderManager.h"
 
-#include <charconv>
+#include <array>
 #include <filesystem>
+#include <iostream>
 
 #include "core/EventQueue.h"
 #include "core/Types.h"
+#include "data_ingestion/EventArena.h"
+#include "data_ingestion/TimestampIndex.h"
 #include "spdlog/spdlog.h"
-#include "utils/TimeUtils.h"
+#include "utils/StageProfiler.h"
 
 namespace backtester {
 
-// MARK: Register&InitSteams
+namespace {
 
-bool DataReaderManager::RegisterAndInitStreams(const std::vector<DataSourceConfig>& data_sources) {
-  for (DataSourceConfig source : data_sources) {
-    std::string source_name = source.data_source_name;
-    std::string data_filepath = source.data_filepath;
+// The read stage of the stage profiler; parsing the line is timed by the caller
+inline bool ReadLine(IDataReader& reader, std::string_view& line) {
+  BT_PROFILE_STAGE(Stage::kRead);
+  return reader.ReadLineView(line);
+}
 
-    if (!std::filesystem::exists(data_filepath)) {
-      std::cerr << "Error: File not found: " << data_filepath << std::endl;
-      return false;
+// MARK: SeekToStart
+// Moves a reader that has just passed the header to the last recovery point before
+// `start_time`. Without a usable index, or with a reader that cannot seek, the source is
+// replayed from its first row as before.
+void SeekToStart(IDataReader& reader, const DataSourceConfig& source, timestamp_t start_time) {
+  const auto kind = IndexPositionFor(source);
+  TimestampIndex index;
+  if (!kind || !index.Load(TimestampIndexPathFor(source.data_filepath), source.data_filepath,
+                           *kind)) {
+    spdlog::warn("No timestamp index for {}, replaying from the start. Run 'index' first",
+                 source.data_source_name);
+    return;
+  }
+  const TimestampIndexEntry* entry = index.RecoveryPointBefore(start_time);
+  if (!entry) {
+    spdlog::info("{} has no recovery point before start_time", source.data_source_name);
+    return;
+  }
+  if (entry->position > 0 && !reader.Seek(entry->position)) {
+    spdlog::warn("Reader for {} cannot seek, replaying from the start", source.data_source_name);
+    return;
+  }
+
+  // Rows between the seek position and the recovery point; blank lines are not rows
+  size_t skipped = 0;
+  if (reader.ProducesEvents()) {
+    std::array<MarketByOrderEvent, 256> scratch;
+    while (skipped < entry->skip_rows) {
+      const size_t want = std::min<size_t>(scratch.size(), entry->skip_rows - skipped);
+      const size_t n = reader.ReadEvents({scratch.data(), want});
+      if (n == 0) break;
+      skipped += n;
+    }
+  } else {
+    std::string_view line;
+    while (skipped < entry->skip_rows && reader.ReadLineView(line)) {
+      if (!line.empty()) ++skipped;
     }
+  }
+  spdlog::info("{} resumes at {} (position {}, {} rows skipped)", source.data_source_name,
+               entry->ts, entry->position, skipped);
+}
 
-    std::unique_ptr<CsvZstReader> reader = std::make_unique<CsvZstReader>();
+// MARK: OpenSource
+// Reader for the source's data file, positioned at its first row (or its recovery point).
+std::unique_ptr<IDataReader> OpenSource(const DataSourceConfig& source, timestamp_t start_time) {
+  const std::string& source_name = source.data_source_name;
+  const std::string& data_filepath = source.data_filepath;
 
-    if (!reader->Open(data_filepath)) {
-      std::string failure = "Failed to open reader for: " + source_name;
-      std::cerr << failure << std::endl;
-      spdlog::error(failure + "at " + data_filepath);
-      return false;
-    }
+  if (!std::filesystem::exists(data_filepath)) {
+    std::cerr << "Error: File not found: " << data_filepath << std::endl;
+    return nullptr;
+  }
 
-    // Verify Header
-    std::string header_line;
-    reader->ReadLine(header_line);
+  std::unique_ptr<IDataReader> reader = MakeDataReader(source);
+  if (!reader) return nullptr;
 
-    if (header_line != kExpectedMboHeader) {
-      std::string failure = "Incorrect header format for " + source_name;
-      std::cerr << failure << std::endl;
-      spdlog::error(failure + "at " + data_filepath);
-      return false;
+  if (!reader->Open(data_filepath)) {
+    std::string failure = "Failed to open reader for: " + source_name;
+    std::cerr << failure << std::endl;
+    spdlog::error(failure + "at " + data_filepath);
+    return nullptr;
+  }
+
+  // Verify Header (binary readers validate their own header on Open)
+  std::string_view header_line;
+  if (!reader->ProducesEvents()) reader->ReadLineView(header_line);
+  const std::string& expected_header =
+      source.schema == DataSchema::OHLCV   ? kExpectedOhlcvHeader
+      : source.schema == DataSchema::MBP10 ? kExpectedMBP10Header
+                                           : kExpectedMboHeader;
+
+  if (!reader->ProducesEvents() && header_line != expected_header) {
+    std::string failure = "Incorrect header format for " + source_name;
+    std::cerr << failure << std::endl;
+    spdlog::error(failure + "at " + data_filepath);
+    return nullptr;
+  }
+  if (source.seek_to_start && start_time > 0) SeekToStart(*reader, source, start_time);
+  return reader;
+}
+
+}  // namespace
+
+// MARK: Register&InitSteams
+
+bool DataReaderManager::RegisterAndInitStreams(const std::vector<DataSourceConfig>& data_sources,
+                                               timestamp_t start_time) {
+  for (DataSourceConfig source : data_sources) {
+    std::unique_ptr<IDataReader> reader;
+    if (arena_ && arena_->Contains(source.data_source_id)) {
+      // Decoded, filtered and seeked when the arena was built
+      reader = std::make_unique<ArenaReader>(arena_->Events(source.data_source_id));
+      source.instrument_filter.clear();
+    } else {
+      reader = OpenSource(source, start_time);
+      if (!reader) return false;
     }
+
     // Store the active reader
+    if (stream_by_id_.size() <= source.data_source_id) {
+      stream_by_id_.resize(size_t{source.data_source_id} + 1, -1);
+    }
+    stream_by_id_[source.data_source_id] = static_cast<int32_t>(readers_.size());
     readers_.push_back({std::move(reader), source});
+    mbp10_decoders_.push_back(source.schema == DataSchema::MBP10
+                                  ? std::make_unique<Mbp10CsvDecoder>(source)
+                                  : nullptr);
+    filters_.emplace_back(source.instrument_filter);
   }
   spdlog::info("Data readers initialized");
   return true;
@@ -51,203 +138,125 @@ bool DataReaderManager::RegisterAndInitStreams(const std::vector<DataSourceConfi
 // MARK: LoadNextEventForSymbol
 
 bool DataReaderManager::LoadNextEventFromSource(uint16_t source_id, MarketByOrderEvent& out) {
-  auto it = std::find_if(readers_.begin(), readers_.end(), [source_id](DataStream& stream) {
-    return stream.config.data_source_id == source_id;
-  });
-  if (it == readers_.end()) {
+  DataStream* stream = StreamFor(source_id);
+  if (!stream) {
     return false;
   }
 
-  std::string raw_line;
+  InstrumentFilter& filter = filters_[static_cast<size_t>(stream_by_id_[source_id])];
 
-  if (!it->reader->ReadLine(raw_line)) {
-    spdlog::info("End of data for symbol: " + it->config.data_source_name);
-    // readers_.erase(symbol); TODO
-    it->reader->Close();
+  if (stream->reader->ProducesEvents()) {
+    while (stream->reader->ReadEvent(out)) {
+      if (filter.Keep(std::span<MarketByOrderEvent>(&out, 1)) == 0) continue;
+      out.data_source_id = stream->config.data_source_id;
+      return true;
+    }
+    EndOfData(*stream);
     return false;
   }
 
-  if (it->config.schema == DataSchema::MBO) {
-    if (ParseMboLineToEvent(it, raw_line, out)) return true;
-    // } else if (readers_[symbol].schema == DataSchema::OHLCV){ // TODO
-    //     event_ptr = ParseOhlcvLineToEvent(symbol, raw_line);
-  } else {
-    throw std::runtime_error("Invalid data schema ");
+  if (stream->config.schema != DataSchema::MBO) {
+    throw std::runtime_error("Invalid data schema ");  // others go through LoadNextMarketEvents
   }
 
-  return false;
+  const size_t column = InstrumentColumnFor(stream->config.schema);
+  std::string_view raw_line;
+  do {
+    if (!stream->reader->ReadLineView(raw_line)) {
+      EndOfData(*stream);
+      return false;
+    }
+  } while (!filter.AcceptsRow(raw_line, column));
+
+  return ParseMboLine(raw_line, stream->config, out);
 };
 
-// MARK:  ParseMboLineToEvent
-
-bool DataReaderManager::ParseMboLineToEvent(const std::vector<backtester::DataStream>::iterator it,
-                                            const std::string& line, MarketByOrderEvent& out) {
-  std::string_view current_view(line);
-  size_t pos = 0;
-
-  uint64_t ts_recv, ts_event, order_id;
-  uint32_t instrument_id, size, sequence;
-  uint16_t publisher_id;
-  EventType action;
-  OrderSide side;
-  uint8_t flags;
-  int32_t ts_in_delta;
-  int64_t price;
-
-  for (int i = 1; i <= 15; ++i) {
-    std::string_view token = GetNextToken(pos, current_view);
-
-    switch (i) {
-      case 1:  // ts_recv (uint64_t / iso8601)
-        if (token.empty()) throw std::runtime_error("Field 1 empty.");
-        if (it->config.ts_format == TmStampFormat::UNIX) {
-          auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), ts_recv);
-          if (ec != std::errc{}) {
-            std::error_code err = std::make_error_code(ec);
-            spdlog::error("Error parsing ts_recv: {}, {}", err.message(), token);
-          }
-        } else {
-          auto result = backtester::time::ParseIsoToUnix(token);
-          if (!result.success) {
-            spdlog::error("Error parsing ts_recv: {}", result.error_msg);
-            auto error = "Error parsing ts_recv" + std::string(token) + result.error_msg;
-            throw std::runtime_error(error);
-          }
-          ts_recv = result.unix_nanos;
-        }
-        break;
-
-      case 2:  // ts_event (uint64_t)
-        if (token.empty()) throw std::runtime_error("Field 2 empty.");
-        if (it->config.ts_format == TmStampFormat::UNIX) {
-          std::from_chars(token.data(), token.data() + token.size(), ts_event);
-        } else {
-          auto result = backtester::time::ParseIsoToUnix(token);
-          if (!result.success) {
-            spdlog::error("Error parsing ts_event: {}", result.error_msg);
-            auto error = "Error parsing ts_event" + std::string(token) + result.error_msg;
-            throw std::runtime_error(error);
-          }
-          ts_event = result.unix_nanos;
-        }
-        break;
-
-      case 3:  // rtype (uint16_t)
-        break;
-
-      case 4:  // publisher_id (uint16_t)
-        if (token.empty()) throw std::runtime_error("Field 4 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), publisher_id);
-        break;
-
-      case 5:  // instrument_id (uint32_t)
-        if (token.empty()) throw std::runtime_error("Field 5 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), instrument_id);
-        break;
-
-      case 6:  // action (char)
-        if (token.size() != 1) throw std::runtime_error("Field 6 malformed.");
-        action = ActionToEventTyp(token[0]);
-        break;
-
-      case 7:  // side (char)
-        if (token.size() != 1) throw std::runtime_error("Field 7 malformed.");
-        side = CharToOrderSide(token[0]);
-        break;
-
-      case 8:  // price (int64_t)
-        if (action == EventType::kMarketOrderClear) {
-          price = 0;
-          break;
-        }
-        if (token.empty()) throw std::runtime_error("Field 8 empty.");
-
-        if (it->config.price_format == PriceFormat::DECIMAL) {
-          double raw_price;
-          std::from_chars(token.data(), token.data() + token.size(), raw_price);
-          raw_price *= 1000000000;
-          if (BT_UNLIKELY(raw_price < 0)) {
-            throw std::runtime_error("Price below zero in data");
-          }
-          price = static_cast<price_t>(raw_price);
-          break;
-        } else {
-          std::from_chars(token.data(), token.data() + token.size(), price);
-          break;
-        }
-
-      case 9:  // size (uint32_t)
-        if (token.empty()) throw std::runtime_error("Field 9 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), size);
-        break;
-
-      case 10:  // channel_id (uint32_t)
-        break;
-
-      case 11:  // order_id (uint64_t)
-        if (token.empty()) throw std::runtime_error("Field 11 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), order_id);
-        break;
-
-      case 12:  // flags (uint8_t)
-        if (token.empty()) throw std::runtime_error("Field 12 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), flags);
-        break;
-
-      case 13:  // ts_in_delta (int32_t)
-        if (token.empty()) throw std::runtime_error("Field 13 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), ts_in_delta);
-        break;
-
-      case 14:  // sequence (uint32_t)
-        if (token.empty()) throw std::runtime_error("Field 14 empty.");
-        std::from_chars(token.data(), token.data() + token.size(), sequence);
-        break;
-
-      case 15:  // potentially symbol added
-        break;
-
-      default:
-        // Should never happen if loop count is correct
-        throw std::runtime_error("Unexpected field index.");
+// MARK: LoadNextBatch
+
+size_t DataReaderManager::LoadNextBatch(uint16_t source_id, std::span<MarketByOrderEvent> out) {
+  DataStream* stream = StreamFor(source_id);
+  if (!stream) return 0;
+
+  InstrumentFilter& filter = filters_[static_cast<size_t>(stream_by_id_[source_id])];
+  size_t n = 0;
+  if (stream->reader->ProducesEvents()) {
+    // Decoded events are filtered after the fact; refill until something survives
+    size_t got;
+    do {
+      BT_PROFILE_STAGE(Stage::kRead);  // binary decode: nothing left to parse
+      got = stream->reader->ReadEvents(out);
+      n = filter.Keep(out.first(got));
+    } while (n == 0 && got > 0);
+    for (size_t i = 0; i < n; ++i) out[i].data_source_id = stream->config.data_source_id;
+  } else {
+    if (stream->config.schema != DataSchema::MBO) throw std::runtime_error("Invalid data schema ");
+    const size_t column = InstrumentColumnFor(stream->config.schema);
+    std::string_view raw_line;
+    while (n < out.size() && ReadLine(*stream->reader, raw_line)) {
+      BT_PROFILE_STAGE(Stage::kParse);
+      if (!filter.AcceptsRow(raw_line, column)) continue;
+      if (ParseMboLine(raw_line, stream->config, out[n])) ++n;
     }
   }
 
-  out = {
-      .header = {.timestamp = ts_event, .type = action},
-      .ts_recv = ts_recv,
-      .order_id = order_id,
-      .price = price,
-      .size = size,
-      .sequence = sequence,
-      .instrument_id = instrument_id,
-      .ts_in_delta = ts_in_delta,
-      .data_source_id = it->config.data_source_id,
-      .publisher_id = publisher_id,
-      .side = side,
-      .flags = flags,
-  };
+  if (n == 0) EndOfData(*stream);
+  return n;
+}
 
-  return true;
-};
+// MARK: LoadNextMarketEvents
+
+size_t DataReaderManager::LoadNextMarketEvents(uint16_t source_id, std::span<EventUnion> out) {
+  DataStream* stream = StreamFor(source_id);
+  if (!stream) return 0;
+
+  const size_t idx = static_cast<size_t>(stream_by_id_[source_id]);
+  InstrumentFilter& filter = filters_[idx];
+  const size_t column = InstrumentColumnFor(stream->config.schema);
+  size_t n = 0;
+  std::string_view raw_line;
+  if (stream->config.schema == DataSchema::OHLCV) {
+    while (n < out.size() && ReadLine(*stream->reader, raw_line)) {
+      BT_PROFILE_STAGE(Stage::kParse);
+      if (!filter.AcceptsRow(raw_line, column)) continue;
+      if (ParseOhlcvLine(raw_line, stream->config, out[n].bar)) ++n;
+    }
+  } else if (stream->config.schema == DataSchema::MBP10) {
+    constexpr size_t kRow = Mbp10CsvDecoder::kMaxEventsPerRow;
+    if (BT_UNLIKELY(out.size() < kRow)) {
+      throw std::invalid_argument("LoadNextMarketEvents: MBP-10 batch smaller than one row");
+    }
+    Mbp10CsvDecoder& decoder = *mbp10_decoders_[idx];
+    while (out.size() - n >= kRow && ReadLine(*stream->reader, raw_line)) {
+      BT_PROFILE_STAGE(Stage::kParse);
+      if (!filter.AcceptsRow(raw_line, column)) continue;
+      n += decoder.DecodeLine(raw_line, out.subspan(n).first<kRow>());
+    }
+  } else {
+    throw std::runtime_error("Invalid data schema ");  // MBO goes through LoadNextBatch
+  }
 
-// MARK: Get Next Token
+  if (n == 0) EndOfData(*stream);
+  return n;
+}
 
-std::string_view DataReaderManager::GetNextToken(size_t& start_pos,
-                                                 std::string_view& current_view) {
-  size_t delim_pos = current_view.find(',', start_pos);
-  std::string_view token;
+uint64_t DataReaderManager::SkippedMessages(uint16_t source_id) const {
+  if (source_id >= stream_by_id_.size() || stream_by_id_[source_id] < 0) return 0;
+  return filters_[static_cast<size_t>(stream_by_id_[source_id])].Skipped();
+}
 
-  if (delim_pos == std::string_view::npos) {
-    // Last token in the line
-    token = current_view.substr(start_pos);
-    start_pos = current_view.size();  // Advance position to the end
-  } else {
-    // Found a token
-    token = current_view.substr(start_pos, delim_pos - start_pos);
-    start_pos = delim_pos + 1;  // Advance past the comma
+void DataReaderManager::EndOfData(DataStream& stream) {
+  if (stream.reader->Failed()) {
+    spdlog::error("Source {} stopped on a read error; its data is incomplete",
+                  stream.config.data_source_name);
+    failed_.store(true, std::memory_order_release);
   }
-  return token;
-};
+  spdlog::info("End of data for symbol: " + stream.config.data_source_name);
+  const InstrumentFilter& filter = filters_[static_cast<size_t>(&stream - readers_.data())];
+  if (filter.Enabled()) {
+    spdlog::info("{} skipped {} messages for instruments it does not trade",
+                 stream.config.data_source_name, filter.Skipped());
+  }
+  stream.reader->Close();
+}
 
 }  // namespace backtester
@@ -0,0 +1,152 @@
+#include "data_ingestion/DbnMboReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+constexpr size_t kReadBytes = size_t{1} << 20;
+}  // namespace
+
+DbnMboReader::~DbnMboReader() { Close(); }
+
+// MARK: OPEN
+bool DbnMboReader::Open(const std::string& filename) {
+  Close();
+  if (!file_.Open(filename)) return false;
+  eof_ = false;
+
+  if (config_.compression == Compression::ZSTD) {
+    dstream_ = ZSTD_createDStream();
+    if (!dstream_ || ZSTD_isError(ZSTD_initDStream(dstream_))) return false;
+  }
+
+  // Prelude
+  if (!Fill(kDbnPreludeSize) || std::memcmp(buffer_.data(), kDbnMagic, sizeof(kDbnMagic)) != 0) {
+    spdlog::error("DbnMboReader: {} is not a DBN file", filename);
+    return false;
+  }
+  version_ = static_cast<uint8_t>(buffer_[3]);
+  uint32_t metadata_len;
+  std::memcpy(&metadata_len, buffer_.data() + 4, sizeof(metadata_len));
+  if (version_ == 0 || version_ > kDbnMaxVersion) {
+    spdlog::error("DbnMboReader: unsupported DBN version {} in {}", version_, filename);
+    return false;
+  }
+  begin_ += kDbnPreludeSize;
+
+  // Metadata: only the schema is checked, symbology is taken from the config
+  if (!Fill(metadata_len) || metadata_len < kDbnDatasetLen + sizeof(uint16_t)) {
+    spdlog::error("DbnMboReader: truncated metadata in {}", filename);
+    return false;
+  }
+  uint16_t schema;
+  std::memcpy(&schema, buffer_.data() + begin_ + kDbnDatasetLen, sizeof(schema));
+  if (schema != kDbnSchemaMbo && schema != kDbnSchemaMixed) {
+    spdlog::error("DbnMboReader: {} holds schema {}, expected MBO", filename, schema);
+    return false;
+  }
+  begin_ += metadata_len;
+
+  spdlog::info("DbnMboReader: opened DBN v{} file {}", version_, filename);
+  return true;
+}
+
+// MARK: CLOSE
+void DbnMboReader::Close() {
+  file_.Close();
+  if (dstream_) {
+    ZSTD_freeDStream(dstream_);
+    dstream_ = nullptr;
+  }
+  input_ = {};
+  input_pos_ = 0;
+  input_size_ = 0;
+  eof_ = true;
+  begin_ = 0;
+  end_ = 0;
+}
+
+// MARK: READ EVENTS
+size_t DbnMboReader::ReadEvents(std::span<MarketByOrderEvent> out) {
+  size_t n = 0;
+  while (n < out.size()) {
+    if (Available() < sizeof(DbnRecordHeader) && !Fill(sizeof(DbnRecordHeader))) break;
+
+    DbnRecordHeader hd;
+    std::memcpy(&hd, buffer_.data() + begin_, sizeof(hd));
+    const size_t record_len = size_t{hd.length} * 4;
+    if (BT_UNLIKELY(record_len < sizeof(DbnRecordHeader))) {
+      spdlog::error("DbnMboReader: corrupt record length {}", record_len);
+      Close();
+      break;
+    }
+    if (Available() < record_len && !Fill(record_len)) break;
+
+    if (BT_LIKELY(hd.rtype == kDbnRtypeMbo && record_len >= sizeof(DbnMboMsg))) {
+      DbnMboMsg msg;
+      std::memcpy(&msg, buffer_.data() + begin_, sizeof(msg));
+      DecodeDbnMbo(msg, config_.data_source_id, out[n++]);
+    } else {
+      ++skipped_;
+    }
+    begin_ += record_len;
+  }
+  return n;
+}
+
+// MARK: FILL
+// Makes at least `min_bytes` unread bytes available, compacting the buffer first.
+// Returns false at end of file with fewer than that left.
+bool DbnMboReader::Fill(size_t min_bytes) {
+  if (begin_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  while (end_ < min_bytes) {
+    if (buffer_.size() < std::max(min_bytes, end_ + kReadBytes)) {
+      buffer_.resize(std::max(min_bytes, end_ + kReadBytes));
+    }
+    const size_t got = ReadRaw(buffer_.data() + end_, buffer_.size() - end_);
+    if (got == 0) return false;
+    end_ += got;
+  }
+  return true;
+}
+
+size_t DbnMboReader::ReadRaw(char* dst, size_t capacity) {
+  ZSTD_outBuffer output = {dst, capacity, 0};
+  while (output.pos == 0) {
+    if (input_pos_ >= input_size_) {
+      if (eof_) return 0;
+      input_ = file_.NextBlock();
+      input_size_ = input_.size();
+      input_pos_ = 0;
+      if (input_size_ == 0) {
+        eof_ = true;
+        return 0;
+      }
+    }
+    if (!dstream_) {
+      const size_t take = std::min(capacity, input_size_ - input_pos_);
+      std::memcpy(dst, input_.data() + input_pos_, take);
+      input_pos_ += take;
+      return take;
+    }
+    ZSTD_inBuffer input = {input_.data(), input_size_, input_pos_};
+    const size_t ret = ZSTD_decompressStream(dstream_, &output, &input);
+    if (ZSTD_isError(ret)) {
+      spdlog::warn("zstd error in DbnMboReader: {}", ZSTD_getErrorName(ret));
+      eof_ = true;
+      return 0;
+    }
+    input_pos_ = input.pos;
+  }
+  return output.pos;
+}
+
+}  // namespace backtester
@@ -0,0 +1,160 @@
+#include "data_ingestion/EventArena.h"
+
+#include <filesystem>
+#include <functional>
+
+#include "data_ingestion/DataReaderManager.h"
+#include "data_ingestion/MboCacheWriter.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+std::vector<DataSourceConfig> MboSources(const std::vector<DataSourceConfig>& sources) {
+  std::vector<DataSourceConfig> mbo;
+  for (const auto& source : sources) {
+    if (source.schema == DataSchema::MBO) mbo.push_back(source);
+  }
+  return mbo;
+}
+
+// Decodes `source` in batches and hands each batch to `sink`. False if the source fails to
+// open or read to its end, or the sink refuses a batch.
+bool DecodeSource(const DataSourceConfig& source, timestamp_t start_time,
+                  const std::function<bool(std::span<const MarketByOrderEvent>)>& sink) {
+  DataReaderManager manager;
+  if (!manager.RegisterAndInitStreams({source}, start_time)) return false;
+  std::vector<MarketByOrderEvent> batch(4096);
+  while (size_t n = manager.LoadNextBatch(source.data_source_id, batch)) {
+    if (!sink({batch.data(), n})) return false;
+  }
+  return !manager.Failed();
+}
+
+}  // namespace
+
+// MARK: Build
+std::shared_ptr<const EventArena> EventArena::Build(const std::vector<DataSourceConfig>& sources,
+                                                    timestamp_t start_time) {
+  auto arena = std::make_shared<EventArena>();
+  for (const auto& source : MboSources(sources)) {
+    Source& slot = arena->sources_.emplace_back();
+    slot.data_source_id = source.data_source_id;
+    const bool ok = DecodeSource(source, start_time, [&slot](auto batch) {
+      slot.events.insert(slot.events.end(), batch.begin(), batch.end());
+      return true;
+    });
+    if (!ok) {
+      spdlog::error("EventArena: could not decode {}", source.data_source_name);
+      return nullptr;
+    }
+    slot.events.shrink_to_fit();
+    slot.view = slot.events;
+    spdlog::info("EventArena: {} events for {} in memory", slot.events.size(),
+                 source.data_source_name);
+  }
+  return arena;
+}
+
+// MARK: Shared
+std::string EventArena::SharedPathFor(const DataSourceConfig& source, const std::string& dir,
+                                      timestamp_t start_time) {
+  // Everything that changes the decoded events. std::hash is only stable within one build,
+  // which is all sibling processes of one binary need.
+  std::string key = fmt::format("{}|{}|{}|{}|{}|", static_cast<int>(source.encoding),
+                                static_cast<int>(source.compression),
+                                static_cast<int>(source.price_format),
+                                static_cast<int>(source.ts_format),
+                                source.seek_to_start ? start_time : 0);
+  const std::vector<std::string> files =
+      source.data_files.empty() ? std::vector<std::string>{source.data_filepath}
+                                : source.data_files;
+  for (const auto& file : files) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(file, ec);
+    const auto mtime = std::filesystem::last_write_time(file, ec).time_since_epoch().count();
+    key += fmt::format("{}:{}:{}|", file, size, mtime);
+  }
+  for (uint32_t id : source.instrument_filter) key += fmt::format("{},", id);
+
+  return (std::filesystem::path(dir) / fmt::format("bt-arena-{}-{:016x}.bin",
+                                                   source.data_source_name,
+                                                   std::hash<std::string>{}(key)))
+      .string();
+}
+
+std::shared_ptr<const EventArena> EventArena::BuildShared(
+    const std::vector<DataSourceConfig>& sources, const std::string& dir,
+    timestamp_t start_time) {
+  for (const auto& source : MboSources(sources)) {
+    const std::string path = SharedPathFor(source, dir, start_time);
+    if (std::filesystem::exists(path)) {
+      spdlog::info("EventArena: reusing {} for {}", path, source.data_source_name);
+      continue;
+    }
+    // Written under a temporary name and renamed, so readers never map a partial arena
+    const std::string tmp_path = path + ".tmp";
+    MboCacheWriter writer;
+    if (!writer.Open(tmp_path)) return nullptr;
+    const bool ok = DecodeSource(source, start_time, [&writer](auto batch) {
+      for (const auto& ev : batch) {
+        if (!writer.Append(ev)) return false;
+      }
+      return true;
+    });
+    std::error_code ec;
+    if (!ok || !writer.Finalize()) {
+      spdlog::error("EventArena: could not write {} for {}", path, source.data_source_name);
+      std::filesystem::remove(tmp_path, ec);
+      return nullptr;
+    }
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+      spdlog::error("EventArena: could not move {} into place: {}", path, ec.message());
+      return nullptr;
+    }
+    spdlog::info("EventArena: {} events for {} at {}", writer.RecordCount(),
+                 source.data_source_name, path);
+  }
+  return OpenShared(sources, dir, start_time);
+}
+
+std::shared_ptr<const EventArena> EventArena::OpenShared(
+    const std::vector<DataSourceConfig>& sources, const std::string& dir,
+    timestamp_t start_time) {
+  auto arena = std::make_shared<EventArena>();
+  for (const auto& source : MboSources(sources)) {
+    const std::string path = SharedPathFor(source, dir, start_time);
+    if (!std::filesystem::exists(path)) {
+      spdlog::info("EventArena: no arena for {} in {}, reading its data files",
+                   source.data_source_name, dir);
+      continue;
+    }
+    // The rename in BuildShared guarantees a complete file; skip the checksum pass
+    auto reader = std::make_unique<MboCacheReader>(false);
+    if (!reader->Open(path)) continue;
+    Source& slot = arena->sources_.emplace_back();
+    slot.data_source_id = source.data_source_id;
+    slot.view = reader->Events();
+    slot.mapped = std::move(reader);
+  }
+  return arena;
+}
+
+// MARK: Lookup
+bool EventArena::Contains(uint16_t data_source_id) const {
+  for (const auto& source : sources_) {
+    if (source.data_source_id == data_source_id) return true;
+  }
+  return false;
+}
+
+std::span<const MarketByOrderEvent> EventArena::Events(uint16_t data_source_id) const {
+  for (const auto& source : sources_) {
+    if (source.data_source_id == data_source_id) return source.view;
+  }
+  return {};
+}
+
+}  // namespace backtester
@@ -0,0 +1,108 @@
+#include "data_ingestion/MboCacheReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+MboCacheReader::~MboCacheReader() { Close(); }
+
+// MARK: OPEN
+bool MboCacheReader::Open(const std::string& filename) {
+  Close();
+
+  fd_ = ::open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < kMboCacheRecordsOffset) {
+    spdlog::error("MboCacheReader: {} is too small to be an MBO cache", filename);
+    Close();
+    return false;
+  }
+  map_size_ = static_cast<size_t>(st.st_size);
+
+  map_ = ::mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (map_ == MAP_FAILED) {
+    map_ = nullptr;
+    spdlog::error("MboCacheReader: mmap failed for {}", filename);
+    Close();
+    return false;
+  }
+  ::madvise(map_, map_size_, MADV_SEQUENTIAL);
+
+  if (!Validate(filename)) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+// MARK: CLOSE
+void MboCacheReader::Close() {
+  if (map_) {
+    ::munmap(map_, map_size_);
+    map_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  map_size_ = 0;
+  pos_ = 0;
+  header_ = {};
+  records_ = {};
+  instruments_ = {};
+  publishers_ = {};
+}
+
+// MARK: VALIDATE
+bool MboCacheReader::Validate(const std::string& filename) {
+  const auto* base = static_cast<const unsigned char*>(map_);
+  std::memcpy(&header_, base, sizeof(header_));
+
+  if (std::memcmp(header_.magic, kMboCacheMagic, sizeof(kMboCacheMagic)) != 0) {
+    spdlog::error("MboCacheReader: bad magic in {}", filename);
+    return false;
+  }
+  if (header_.version != kMboCacheVersion || header_.record_size != sizeof(MarketByOrderEvent)) {
+    spdlog::error("MboCacheReader: {} has version {} / record size {}, expected {} / {}", filename,
+                  header_.version, header_.record_size, kMboCacheVersion,
+                  sizeof(MarketByOrderEvent));
+    return false;
+  }
+
+  const uint64_t records_bytes = header_.record_count * sizeof(MarketByOrderEvent);
+  const uint64_t index_bytes =
+      (uint64_t{header_.instrument_count} + header_.publisher_count) * sizeof(MboCacheIndexEntry);
+  if (header_.records_offset != kMboCacheRecordsOffset ||
+      header_.index_offset != header_.records_offset + records_bytes ||
+      header_.index_offset + index_bytes != map_size_) {
+    spdlog::error("MboCacheReader: {} is truncated or has inconsistent offsets", filename);
+    return false;
+  }
+
+  records_ = {reinterpret_cast<const MarketByOrderEvent*>(base + header_.records_offset),
+              header_.record_count};
+  instruments_ = {reinterpret_cast<const MboCacheIndexEntry*>(base + header_.index_offset),
+                  header_.instrument_count};
+  publishers_ = {instruments_.data() + instruments_.size(), header_.publisher_count};
+
+  if (verify_checksum_) {
+    uint64_t sum = MboCacheChecksum(records_.data(), records_bytes, kMboChecksumSeed);
+    sum = MboCacheChecksum(instruments_.data(), index_bytes, sum);
+    if (sum != header_.checksum) {
+      spdlog::error("MboCacheReader: checksum mismatch in {}", filename);
+      return false;
+    }
+  }
+
+  spdlog::info("MboCacheReader: mapped {} records from {}", header_.record_count, filename);
+  return true;
+}
+
+}  // namespace backtester
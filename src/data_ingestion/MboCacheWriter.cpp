@@ -0,0 +1,106 @@
+#include "data_ingestion/MboCacheWriter.h"
+
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+MboCacheWriter::~MboCacheWriter() {
+  if (file_.is_open()) file_.close();
+}
+
+// MARK: OPEN
+bool MboCacheWriter::Open(const std::string& filename) {
+  filename_ = filename;
+  file_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    spdlog::error("MboCacheWriter: could not open {}", filename);
+    return false;
+  }
+
+  header_ = {};
+  std::memcpy(header_.magic, kMboCacheMagic, sizeof(kMboCacheMagic));
+  header_.version = kMboCacheVersion;
+  header_.record_size = sizeof(MarketByOrderEvent);
+  header_.records_offset = kMboCacheRecordsOffset;
+  checksum_ = kMboChecksumSeed;
+  instrument_counts_.clear();
+  publisher_counts_.clear();
+
+  // Placeholder header + padding, rewritten by Finalize()
+  const std::vector<char> zeros(kMboCacheRecordsOffset, 0);
+  file_.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+  return static_cast<bool>(file_);
+}
+
+// MARK: APPEND
+bool MboCacheWriter::Append(const MarketByOrderEvent& event) {
+  // Copy field by field into a zeroed record so struct padding hashes deterministically.
+  MarketByOrderEvent rec;
+  std::memset(&rec, 0, sizeof(rec));
+  rec.header.timestamp = event.header.timestamp;
+  rec.header.type = event.header.type;
+  rec.ts_recv = event.ts_recv;
+  rec.order_id = event.order_id;
+  rec.price = event.price;
+  rec.size = event.size;
+  rec.sequence = event.sequence;
+  rec.instrument_id = event.instrument_id;
+  rec.ts_in_delta = event.ts_in_delta;
+  rec.data_source_id = event.data_source_id;
+  rec.publisher_id = event.publisher_id;
+  rec.side = event.side;
+  rec.flags = event.flags;
+
+  file_.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+  if (!file_) return false;
+
+  checksum_ = MboCacheChecksum(&rec, sizeof(rec), checksum_);
+  if (header_.record_count == 0) header_.first_ts = rec.header.timestamp;
+  header_.last_ts = rec.header.timestamp;
+  ++header_.record_count;
+  ++instrument_counts_[rec.instrument_id];
+  ++publisher_counts_[rec.publisher_id];
+  return true;
+}
+
+// MARK: FINALIZE
+bool MboCacheWriter::Finalize() {
+  if (!file_.is_open()) return false;
+
+  header_.index_offset =
+      header_.records_offset + header_.record_count * sizeof(MarketByOrderEvent);
+  header_.instrument_count = static_cast<uint32_t>(instrument_counts_.size());
+  header_.publisher_count = static_cast<uint32_t>(publisher_counts_.size());
+
+  if (!WriteIndex(instrument_counts_) || !WriteIndex(publisher_counts_)) {
+    spdlog::error("MboCacheWriter: failed writing index tables to {}", filename_);
+    return false;
+  }
+  header_.checksum = checksum_;
+
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+  file_.close();
+  if (file_.fail()) {
+    spdlog::error("MboCacheWriter: failed writing header to {}", filename_);
+    return false;
+  }
+
+  spdlog::info("MboCacheWriter: wrote {} records ({} instruments, {} publishers) to {}",
+               header_.record_count, header_.instrument_count, header_.publisher_count,
+               filename_);
+  return true;
+}
+
+bool MboCacheWriter::WriteIndex(const std::map<uint32_t, uint64_t>& counts) {
+  for (const auto& [id, count] : counts) {
+    const MboCacheIndexEntry entry{.id = id, .reserved = 0, .record_count = count};
+    file_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    checksum_ = MboCacheChecksum(&entry, sizeof(entry), checksum_);
+  }
+  return static_cast<bool>(file_);
+}
+
+}  // namespace backtester
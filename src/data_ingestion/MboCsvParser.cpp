@@ -0,0 +1,340 @@
+#include "data_ingestion/MboCsvParser.h"
+
+#include <array>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "spdlog/spdlog.h"
+#include "utils/SimdScan.h"
+#include "utils/TimeUtils.h"
+
+namespace backtester {
+
+// MARK:  ParseMboLine
+
+bool ParseMboLine(std::string_view line, const DataSourceConfig& config, MarketByOrderEvent& out) {
+  std::string_view current_view(line);
+  size_t pos = 0;
+
+  // Zeroed so a value std::from_chars rejects reads as 0 rather than as stack garbage
+  uint64_t ts_recv = 0, ts_event = 0, order_id = 0;
+  uint32_t instrument_id = 0, size = 0, sequence = 0;
+  uint16_t publisher_id = 0;
+  EventType action;
+  OrderSide side;
+  uint8_t flags = 0;
+  int32_t ts_in_delta = 0;
+  int64_t price = 0;
+
+  for (int i = 1; i <= 15; ++i) {
+    std::string_view token = GetNextToken(pos, current_view);
+
+    switch (i) {
+      case 1:  // ts_recv (uint64_t / iso8601)
+        if (token.empty()) throw std::runtime_error("Field 1 empty.");
+        if (config.ts_format == TmStampFormat::UNIX) {
+          auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), ts_recv);
+          if (ec != std::errc{}) {
+            std::error_code err = std::make_error_code(ec);
+            spdlog::error("Error parsing ts_recv: {}, {}", err.message(), token);
+          }
+        } else {
+          auto result = backtester::time::ParseIsoToUnix(token);
+          if (!result.success) {
+            spdlog::error("Error parsing ts_recv: {}", result.error_msg);
+            auto error = "Error parsing ts_recv" + std::string(token) + result.error_msg;
+            throw std::runtime_error(error);
+          }
+          ts_recv = result.unix_nanos;
+        }
+        break;
+
+      case 2:  // ts_event (uint64_t)
+        if (token.empty()) throw std::runtime_error("Field 2 empty.");
+        if (config.ts_format == TmStampFormat::UNIX) {
+          std::from_chars(token.data(), token.data() + token.size(), ts_event);
+        } else {
+          auto result = backtester::time::ParseIsoToUnix(token);
+          if (!result.success) {
+            spdlog::error("Error parsing ts_event: {}", result.error_msg);
+            auto error = "Error parsing ts_event" + std::string(token) + result.error_msg;
+            throw std::runtime_error(error);
+          }
+          ts_event = result.unix_nanos;
+        }
+        break;
+
+      case 3:  // rtype (uint16_t)
+        break;
+
+      case 4:  // publisher_id (uint16_t)
+        if (token.empty()) throw std::runtime_error("Field 4 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), publisher_id);
+        break;
+
+      case 5:  // instrument_id (uint32_t)
+        if (token.empty()) throw std::runtime_error("Field 5 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), instrument_id);
+        break;
+
+      case 6:  // action (char)
+        if (token.size() != 1) throw std::runtime_error("Field 6 malformed.");
+        action = ActionToEventTyp(token[0]);
+        break;
+
+      case 7:  // side (char)
+        if (token.size() != 1) throw std::runtime_error("Field 7 malformed.");
+        side = CharToOrderSide(token[0]);
+        break;
+
+      case 8:  // price (int64_t)
+        if (action == EventType::kMarketOrderClear) {
+          price = 0;
+          break;
+        }
+        if (token.empty()) throw std::runtime_error("Field 8 empty.");
+
+        if (config.price_format == PriceFormat::DECIMAL) {
+          double raw_price;
+          std::from_chars(token.data(), token.data() + token.size(), raw_price);
+          raw_price *= 1000000000;
+          if (BT_UNLIKELY(raw_price < 0)) {
+            throw std::runtime_error("Price below zero in data");
+          }
+          price = static_cast<price_t>(raw_price);
+          break;
+        } else {
+          std::from_chars(token.data(), token.data() + token.size(), price);
+          break;
+        }
+
+      case 9:  // size (uint32_t)
+        if (token.empty()) throw std::runtime_error("Field 9 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), size);
+        break;
+
+      case 10:  // channel_id (uint32_t)
+        break;
+
+      case 11:  // order_id (uint64_t)
+        if (token.empty()) throw std::runtime_error("Field 11 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), order_id);
+        break;
+
+      case 12:  // flags (uint8_t)
+        if (token.empty()) throw std::runtime_error("Field 12 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), flags);
+        break;
+
+      case 13:  // ts_in_delta (int32_t)
+        if (token.empty()) throw std::runtime_error("Field 13 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), ts_in_delta);
+        break;
+
+      case 14:  // sequence (uint32_t)
+        if (token.empty()) throw std::runtime_error("Field 14 empty.");
+        std::from_chars(token.data(), token.data() + token.size(), sequence);
+        break;
+
+      case 15:  // potentially symbol added
+        break;
+
+      default:
+        // Should never happen if loop count is correct
+        throw std::runtime_error("Unexpected field index.");
+    }
+  }
+
+  out = {
+      .header = {.timestamp = ts_event, .type = action},
+      .ts_recv = ts_recv,
+      .order_id = order_id,
+      .price = price,
+      .size = size,
+      .sequence = sequence,
+      .instrument_id = instrument_id,
+      .ts_in_delta = ts_in_delta,
+      .data_source_id = config.data_source_id,
+      .publisher_id = publisher_id,
+      .side = side,
+      .flags = flags,
+  };
+
+  return true;
+}
+
+// MARK: ParseMboBlock
+
+namespace {
+
+constexpr size_t kMboFieldCount = 15;
+
+// Parses a token of plain decimal digits. False when it holds anything else or does not fit
+// in T, for the row to be re-read by ParseMboLine.
+template <typename T>
+inline bool ParseDigits(std::string_view token, T& value) {
+  if (BT_UNLIKELY(token.empty() || token.size() > std::numeric_limits<uint64_t>::digits10)) {
+    return false;
+  }
+  uint64_t v = 0;
+  for (char c : token) {
+    const auto digit = static_cast<unsigned>(c - '0');
+    if (BT_UNLIKELY(digit > 9)) return false;
+    v = v * 10 + digit;
+  }
+  if (BT_UNLIKELY(v > std::numeric_limits<T>::max())) return false;
+  value = static_cast<T>(v);
+  return true;
+}
+
+template <typename T>
+inline bool ParseSignedDigits(std::string_view token, T& value) {
+  const bool negative = !token.empty() && token[0] == '-';
+  if (negative) token.remove_prefix(1);
+  std::make_unsigned_t<T> magnitude;
+  if (!ParseDigits(token, magnitude) ||
+      magnitude > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max())) {
+    return false;
+  }
+  value = negative ? static_cast<T>(-static_cast<T>(magnitude)) : static_cast<T>(magnitude);
+  return true;
+}
+
+inline std::string_view Required(std::string_view token, const char* msg) {
+  if (BT_UNLIKELY(token.empty())) throw std::runtime_error(msg);
+  return token;
+}
+
+inline bool ParseTimestampField(std::string_view token, const DataSourceConfig& config,
+                                const char* name, uint64_t& value) {
+  if (config.ts_format == TmStampFormat::UNIX) return ParseDigits(token, value);
+  auto result = backtester::time::ParseIsoToUnix(token);
+  if (!result.success) {
+    spdlog::error("Error parsing {}: {}", name, result.error_msg);
+    throw std::runtime_error("Error parsing " + std::string(name) + std::string(token) +
+                             result.error_msg);
+  }
+  value = result.unix_nanos;
+  return true;
+}
+
+// Row [start, ends[n - 1]) split at ends[]; fields past `field_count` read as empty. False
+// when a numeric field is not plain digits that fit its type; `out` is then left unset.
+bool ParseMboFields(const char* base, size_t start,
+                    const std::array<uint32_t, kMboFieldCount>& ends, size_t field_count,
+                    const DataSourceConfig& config, MarketByOrderEvent& out) {
+  std::array<std::string_view, kMboFieldCount> f{};
+  const size_t n = std::min(field_count, kMboFieldCount);
+  for (size_t i = 0; i < n; ++i) {
+    f[i] = std::string_view(base + start, ends[i] - start);
+    start = ends[i] + 1;
+  }
+
+  uint64_t ts_recv = 0, ts_event = 0, order_id = 0;
+  uint32_t instrument_id = 0, size = 0, sequence = 0;
+  uint16_t publisher_id = 0;
+  uint8_t flags = 0;
+  int32_t ts_in_delta = 0;
+  bool ok = ParseTimestampField(Required(f[0], "Field 1 empty."), config, "ts_recv", ts_recv);
+  ok &= ParseTimestampField(Required(f[1], "Field 2 empty."), config, "ts_event", ts_event);
+  ok &= ParseDigits(Required(f[3], "Field 4 empty."), publisher_id);
+  ok &= ParseDigits(Required(f[4], "Field 5 empty."), instrument_id);
+  if (f[5].size() != 1) throw std::runtime_error("Field 6 malformed.");
+  const EventType action = ActionToEventTyp(f[5][0]);
+  if (f[6].size() != 1) throw std::runtime_error("Field 7 malformed.");
+  const OrderSide side = CharToOrderSide(f[6][0]);
+
+  int64_t price = 0;
+  if (action != EventType::kMarketOrderClear) {
+    const std::string_view token = Required(f[7], "Field 8 empty.");
+    if (config.price_format == PriceFormat::DECIMAL) {
+      double raw_price;
+      std::from_chars(token.data(), token.data() + token.size(), raw_price);
+      raw_price *= 1000000000;
+      if (BT_UNLIKELY(raw_price < 0)) throw std::runtime_error("Price below zero in data");
+      price = static_cast<price_t>(raw_price);
+    } else {
+      ok &= ParseSignedDigits(token, price);
+    }
+  }
+
+  ok &= ParseDigits(Required(f[8], "Field 9 empty."), size);
+  ok &= ParseDigits(Required(f[10], "Field 11 empty."), order_id);
+  ok &= ParseDigits(Required(f[11], "Field 12 empty."), flags);
+  ok &= ParseSignedDigits(Required(f[12], "Field 13 empty."), ts_in_delta);
+  ok &= ParseDigits(Required(f[13], "Field 14 empty."), sequence);
+  if (BT_UNLIKELY(!ok)) return false;
+
+  out = {
+      .header = {.timestamp = ts_event, .type = action},
+      .ts_recv = ts_recv,
+      .order_id = order_id,
+      .price = price,
+      .size = size,
+      .sequence = sequence,
+      .instrument_id = instrument_id,
+      .ts_in_delta = ts_in_delta,
+      .data_source_id = config.data_source_id,
+      .publisher_id = publisher_id,
+      .side = side,
+      .flags = flags,
+  };
+  return true;
+}
+
+}  // namespace
+
+size_t ParseMboBlock(std::string_view block, const DataSourceConfig& config,
+                     std::vector<uint32_t>& delims, std::vector<MarketByOrderEvent>& out) {
+  const char* base = block.data();
+  const size_t count = simd_scan::FindCsvDelimiters(base, block.size(), delims);
+  const uint32_t* d = delims.data();
+
+  std::array<uint32_t, kMboFieldCount> ends;
+  size_t line_start = 0;
+  size_t fields = 0;
+  for (size_t k = 0; k < count; ++k) {
+    const uint32_t pos = d[k];
+    if (base[pos] == ',') {
+      if (fields < kMboFieldCount) ends[fields] = pos;
+      ++fields;
+      continue;
+    }
+
+    uint32_t line_end = pos;
+    if (line_end > line_start && base[line_end - 1] == '\r') --line_end;
+    if (fields < kMboFieldCount) ends[fields] = line_end;
+    if (line_end > line_start || fields > 0) {
+      MarketByOrderEvent& ev = out.emplace_back();
+      if (BT_UNLIKELY(!ParseMboFields(base, line_start, ends, fields + 1, config, ev))) {
+        // A field the digit loop cannot read exactly: take the scalar parse for this row
+        ParseMboLine({base + line_start, line_end - line_start}, config, ev);
+      }
+    }
+    line_start = pos + 1;
+    fields = 0;
+  }
+  return line_start;
+}
+
+// MARK: Get Next Token
+
+std::string_view GetNextToken(size_t& start_pos, std::string_view current_view) {
+  size_t delim_pos = current_view.find(',', start_pos);
+  std::string_view token;
+
+  if (delim_pos == std::string_view::npos) {
+    // Last token in the line
+    token = current_view.substr(start_pos);
+    start_pos = current_view.size();  // Advance position to the end
+  } else {
+    // Found a token
+    token = current_view.substr(start_pos, delim_pos - start_pos);
+    start_pos = delim_pos + 1;  // Advance past the comma
+  }
+  return token;
+}
+
+}  // namespace backtester
@@ -0,0 +1,142 @@
+#include "data_ingestion/Mbp10CsvParser.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+#include "data_ingestion/MboCsvParser.h"
+#include "utils/TimeUtils.h"
+
+namespace backtester {
+
+namespace {
+
+constexpr size_t kLevelFieldsStart = 13;
+constexpr size_t kFieldsPerLevel = 6;  // bid_px, ask_px, bid_sz, ask_sz, bid_ct, ask_ct
+constexpr size_t kMbp10FieldCount = kLevelFieldsStart + kMbp10Depth * kFieldsPerLevel;
+
+inline std::string_view Required(std::string_view token, size_t field) {
+  if (BT_UNLIKELY(token.empty())) {
+    throw std::runtime_error("MBP-10 field " + std::to_string(field) + " empty.");
+  }
+  return token;
+}
+
+template <typename T>
+inline T ParseInt(std::string_view token) {
+  T value{};
+  std::from_chars(token.data(), token.data() + token.size(), value);
+  return value;
+}
+
+inline uint64_t ParseTimestamp(std::string_view token, TmStampFormat format, size_t field) {
+  Required(token, field);
+  if (format == TmStampFormat::UNIX) return ParseInt<uint64_t>(token);
+  auto result = backtester::time::ParseIsoToUnix(token);
+  if (!result.success) {
+    throw std::runtime_error("Error parsing MBP-10 timestamp" + std::string(token) +
+                             result.error_msg);
+  }
+  return result.unix_nanos;
+}
+
+// Same conversion as ParseMboLine; an empty field is an empty level.
+inline int64_t ParsePrice(std::string_view token, PriceFormat format) {
+  if (token.empty()) return kUndefPrice;
+  if (format == PriceFormat::FIXPNTINT) return ParseInt<int64_t>(token);
+  double raw_price;
+  std::from_chars(token.data(), token.data() + token.size(), raw_price);
+  raw_price *= 1000000000;
+  if (BT_UNLIKELY(raw_price < 0)) throw std::runtime_error("Price below zero in data");
+  return static_cast<int64_t>(raw_price);
+}
+
+inline bool SameLevel(const PriceLevel& a, const PriceLevel& b) {
+  return a.price == b.price && a.size == b.size && a.count == b.count;
+}
+
+}  // namespace
+
+Mbp10CsvDecoder::Mbp10CsvDecoder(const DataSourceConfig& config)
+    : price_format_(config.price_format),
+      ts_format_(config.ts_format),
+      data_source_id_(config.data_source_id) {}
+
+// MARK: DecodeLine
+
+size_t Mbp10CsvDecoder::DecodeLine(std::string_view line,
+                                   std::span<EventUnion, kMaxEventsPerRow> out) {
+  if (line.empty()) return 0;
+
+  std::string_view fields[kMbp10FieldCount];
+  size_t pos = 0;
+  for (size_t i = 0; i < kMbp10FieldCount; ++i) fields[i] = GetNextToken(pos, line);
+
+  const uint64_t ts_recv = ParseTimestamp(fields[0], ts_format_, 1);
+  const uint64_t ts_event = ParseTimestamp(fields[1], ts_format_, 2);
+  const auto publisher_id = ParseInt<uint16_t>(Required(fields[3], 4));
+  const auto instrument_id = ParseInt<uint32_t>(Required(fields[4], 5));
+  if (fields[5].size() != 1) throw std::runtime_error("MBP-10 field 6 malformed.");
+  if (fields[6].size() != 1) throw std::runtime_error("MBP-10 field 7 malformed.");
+  const EventType action = ActionToEventTyp(fields[5][0]);
+  const OrderSide side = CharToOrderSide(fields[6][0]);
+  const auto sequence = ParseInt<uint32_t>(fields[12]);
+
+  size_t n = 0;
+  Levels& last = last_levels_[(uint64_t{instrument_id} << 16) | publisher_id];
+  auto emit_if_changed = [&](PriceLevel& prev, const PriceLevel& now, OrderSide level_side,
+                             size_t depth) {
+    if (SameLevel(prev, now)) return;
+    prev = now;
+    out[n++].level = {
+        .header = {.timestamp = ts_event, .type = EventType::kMarketLevelUpdate},
+        .price = now.price,
+        .size = now.size,
+        .count = now.count,
+        .instrument_id = instrument_id,
+        .sequence = sequence,
+        .data_source_id = data_source_id_,
+        .publisher_id = publisher_id,
+        .side = level_side,
+        .depth = static_cast<uint8_t>(depth),
+    };
+  };
+
+  for (size_t d = 0; d < kMbp10Depth; ++d) {
+    const std::string_view* lvl = &fields[kLevelFieldsStart + d * kFieldsPerLevel];
+    PriceLevel bid{ParsePrice(lvl[0], price_format_), ParseInt<uint32_t>(lvl[2]),
+                   ParseInt<uint32_t>(lvl[4])};
+    PriceLevel ask{ParsePrice(lvl[1], price_format_), ParseInt<uint32_t>(lvl[3]),
+                   ParseInt<uint32_t>(lvl[5])};
+    if (bid.price == kUndefPrice) bid = {};
+    if (ask.price == kUndefPrice) ask = {};
+    emit_if_changed(last.bids[d], bid, OrderSide::kBid, d);
+    emit_if_changed(last.asks[d], ask, OrderSide::kAsk, d);
+  }
+
+  const size_t action_idx = n++;
+  out[action_idx].mbo = {
+      .header = {.timestamp = ts_event, .type = action},
+      .ts_recv = ts_recv,
+      .order_id = 0,
+      .price = action == EventType::kMarketOrderClear ? 0 : ParsePrice(fields[8], price_format_),
+      .size = ParseInt<uint32_t>(fields[9]),
+      .sequence = sequence,
+      .instrument_id = instrument_id,
+      .ts_in_delta = ParseInt<int32_t>(fields[11]),
+      .data_source_id = data_source_id_,
+      .publisher_id = publisher_id,
+      .side = side,
+      .flags = ParseInt<uint8_t>(fields[10]),
+  };
+
+  if (action == EventType::kMarketTrade && side != OrderSide::kNone) {
+    out[n].mbo = out[action_idx].mbo;
+    out[n].mbo.header.type = EventType::kMarketFill;
+    out[n].mbo.side = side == OrderSide::kBid ? OrderSide::kAsk : OrderSide::kBid;
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace backtester
@@ -0,0 +1,151 @@
+#include "data_ingestion/MultiFileReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "data_ingestion/DataReaderFactory.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+MultiFileReader::MultiFileReader(const DataSourceConfig& source)
+    : source_(source), files_(source.data_files) {
+  source_.data_files.clear();  // each file is opened as a single-file source
+}
+
+MultiFileReader::~MultiFileReader() { Close(); }
+
+// MARK: OPEN
+bool MultiFileReader::Open(const std::string& filename) {
+  Close();
+  auto it = std::find(files_.begin(), files_.end(), filename);
+  if (it == files_.end()) {
+    spdlog::error("MultiFileReader: {} is not a file of source {}", filename,
+                  source_.data_source_name);
+    return false;
+  }
+  file_idx_ = static_cast<size_t>(it - files_.begin());
+  failed_ = false;
+
+  OpenedFile first = OpenFile(source_, filename);
+  if (!first.reader) return false;
+  current_ = std::move(first.reader);
+  produces_events_ = current_->ProducesEvents();
+  header_ = std::move(first.first_line);
+  replay_header_ = !produces_events_;
+  PrefetchNext();
+  return true;
+}
+
+// MARK: CLOSE
+void MultiFileReader::Close() {
+  if (next_.valid()) {
+    try {
+      OpenedFile unused = next_.get();
+    } catch (const std::exception& e) {
+      spdlog::warn("MultiFileReader: discarding unread file: {}", e.what());
+    }
+  }
+  current_.reset();
+  replay_header_ = false;
+  stalls_ = 0;
+}
+
+// MARK: READ
+bool MultiFileReader::ReadLine(std::string& line) {
+  std::string_view view;
+  if (!ReadLineView(view)) return false;
+  line.assign(view);
+  return true;
+}
+
+bool MultiFileReader::ReadLineView(std::string_view& line) {
+  if (BT_UNLIKELY(replay_header_)) {
+    replay_header_ = false;
+    line = header_;
+    return true;
+  }
+  while (current_) {
+    if (current_->ReadLineView(line)) return true;
+    if (!AdvanceFile()) return false;
+  }
+  return false;
+}
+
+bool MultiFileReader::ReadEvent(MarketByOrderEvent& out) {
+  while (current_) {
+    if (current_->ReadEvent(out)) return true;
+    if (!AdvanceFile()) return false;
+  }
+  return false;
+}
+
+size_t MultiFileReader::ReadEvents(std::span<MarketByOrderEvent> out) {
+  while (current_) {
+    const size_t n = current_->ReadEvents(out);
+    if (n > 0) return n;
+    if (!AdvanceFile()) return 0;
+  }
+  return 0;
+}
+
+// MARK: FILE SWITCHING
+
+// Runs on the prefetch thread. Reading the header line pulls in and decompresses the first
+// block of the file, which is the part of a switch that would otherwise stall the caller.
+MultiFileReader::OpenedFile MultiFileReader::OpenFile(DataSourceConfig source,
+                                                      const std::string& path) {
+  source.data_filepath = path;
+  OpenedFile opened{MakeDataReader(source), {}};
+  if (!opened.reader || !opened.reader->Open(path)) {
+    spdlog::error("MultiFileReader: failed to open {}", path);
+    return {};
+  }
+  std::string_view first_line;
+  if (!opened.reader->ProducesEvents() && opened.reader->ReadLineView(first_line)) {
+    opened.first_line.assign(first_line);
+  }
+  return opened;
+}
+
+void MultiFileReader::PrefetchNext() {
+  if (file_idx_ + 1 >= files_.size()) return;
+  next_ = std::async(std::launch::async, &MultiFileReader::OpenFile, source_,
+                     files_[file_idx_ + 1]);
+}
+
+bool MultiFileReader::AdvanceFile() {
+  if (current_->Failed()) return Fail("reading " + files_[file_idx_] + " failed");
+  current_->Close();
+  current_.reset();
+  if (!next_.valid()) return false;  // that was the last file
+
+  if (next_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) ++stalls_;
+  OpenedFile opened;
+  ++file_idx_;
+  try {
+    opened = next_.get();
+  } catch (const std::exception& e) {
+    return Fail(fmt::format("failed to open {}: {}", files_[file_idx_], e.what()));
+  }
+  if (!opened.reader) return Fail("failed to open " + files_[file_idx_]);
+  if (!produces_events_ && opened.first_line != header_) {
+    return Fail("header of " + files_[file_idx_] + " differs from " + files_.front());
+  }
+  current_ = std::move(opened.reader);
+  spdlog::info("Source {} switched to file {}/{}: {}", source_.data_source_name, file_idx_ + 1,
+               files_.size(), files_[file_idx_]);
+  PrefetchNext();
+  return true;
+}
+
+// Runs on whichever thread reads the source, so the error ends the stream instead of being
+// thrown there; DataReaderManager sees Failed() at the end of data and the run reports it.
+bool MultiFileReader::Fail(const std::string& why) {
+  spdlog::error("MultiFileReader: {}; source {} stops here", why, source_.data_source_name);
+  failed_ = true;
+  return false;
+}
+
+}  // namespace backtester
@@ -0,0 +1,77 @@
+#include "data_ingestion/OhlcvCsvParser.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+#include "data_ingestion/MboCsvParser.h"
+#include "utils/TimeUtils.h"
+
+namespace backtester {
+
+namespace {
+
+constexpr size_t kOhlcvFieldCount = 10;
+
+inline std::string_view Required(std::string_view token, size_t field) {
+  if (BT_UNLIKELY(token.empty())) {
+    throw std::runtime_error("OHLCV field " + std::to_string(field) + " empty.");
+  }
+  return token;
+}
+
+template <typename T>
+inline T ParseInt(std::string_view token) {
+  T value{};
+  std::from_chars(token.data(), token.data() + token.size(), value);
+  return value;
+}
+
+// Same conversion as ParseMboLine so bar and MBO prices of one instrument compare equal
+inline int64_t ParsePrice(std::string_view token, const DataSourceConfig& config) {
+  if (config.price_format == PriceFormat::FIXPNTINT) return ParseInt<int64_t>(token);
+  double raw_price;
+  std::from_chars(token.data(), token.data() + token.size(), raw_price);
+  raw_price *= 1000000000;
+  if (BT_UNLIKELY(raw_price < 0)) throw std::runtime_error("Price below zero in data");
+  return static_cast<int64_t>(raw_price);
+}
+
+}  // namespace
+
+// MARK:  ParseOhlcvLine
+
+bool ParseOhlcvLine(std::string_view line, const DataSourceConfig& config, OhlcvBarEvent& out) {
+  if (line.empty()) return false;
+
+  std::string_view fields[kOhlcvFieldCount];
+  size_t pos = 0;
+  for (size_t i = 0; i < kOhlcvFieldCount; ++i) fields[i] = GetNextToken(pos, line);
+
+  uint64_t ts_event;
+  const std::string_view ts = Required(fields[0], 1);
+  if (config.ts_format == TmStampFormat::UNIX) {
+    ts_event = ParseInt<uint64_t>(ts);
+  } else {
+    auto result = backtester::time::ParseIsoToUnix(ts);
+    if (!result.success) {
+      throw std::runtime_error("Error parsing ts_event" + std::string(ts) + result.error_msg);
+    }
+    ts_event = result.unix_nanos;
+  }
+
+  out = {
+      .header = {.timestamp = ts_event + config.bar_interval_ns, .type = EventType::kMarketBar},
+      .open = ParsePrice(Required(fields[4], 5), config),
+      .high = ParsePrice(Required(fields[5], 6), config),
+      .low = ParsePrice(Required(fields[6], 7), config),
+      .close = ParsePrice(Required(fields[7], 8), config),
+      .volume = ParseInt<uint64_t>(Required(fields[8], 9)),
+      .instrument_id = ParseInt<uint32_t>(Required(fields[3], 4)),
+      .data_source_id = config.data_source_id,
+      .publisher_id = ParseInt<uint16_t>(Required(fields[2], 3)),
+  };
+  return true;
+}
+
+}  // namespace backtester
@@ -0,0 +1,315 @@
+#include "data_ingestion/ParallelCsvZstReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/Constants.h"
+#include "data_ingestion/MboCsvParser.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+constexpr size_t kChunksPerWorker = 2;
+
+inline std::string_view StripCr(std::string_view line) {
+  if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+  return line;
+}
+}  // namespace
+
+ParallelCsvZstReader::ParallelCsvZstReader(const DataSourceConfig& config, unsigned threads)
+    : config_(config),
+      thread_count_(std::max(1u, threads)),
+      window_(std::max<size_t>(1, thread_count_) * kChunksPerWorker) {}
+
+ParallelCsvZstReader::~ParallelCsvZstReader() { Close(); }
+
+// MARK: OPEN
+bool ParallelCsvZstReader::Open(const std::string& filename) {
+  Close();
+
+  fd_ = ::open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd_, &st) != 0 || st.st_size == 0) {
+    Close();
+    return false;
+  }
+  map_size_ = static_cast<size_t>(st.st_size);
+  map_ = ::mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (map_ == MAP_FAILED) {
+    map_ = nullptr;
+    Close();
+    return false;
+  }
+  ::madvise(map_, map_size_, MADV_SEQUENTIAL);
+
+  frames_ = ScanZstdFrames(map_, map_size_);
+  if (frames_.empty() || !VerifyHeader()) {
+    spdlog::error("ParallelCsvZstReader: {} is not a readable MBO csv.zst", filename);
+    Close();
+    return false;
+  }
+
+  StartWorkers();
+  spdlog::info("ParallelCsvZstReader: {} frames across {} decode threads for {}", frames_.size(),
+               thread_count_, filename);
+  return true;
+}
+
+// MARK: CLOSE
+void ParallelCsvZstReader::Close() {
+  StopWorkers();
+
+  if (map_) {
+    ::munmap(map_, map_size_);
+    map_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  map_size_ = 0;
+  frames_.clear();
+  slots_.clear();
+  next_dispatch_ = 0;
+  next_emit_ = 0;
+  current_.clear();
+  cursor_ = 0;
+  carry_.clear();
+  has_stitched_ = false;
+  header_pending_ = true;
+}
+
+// MARK: SEEK
+bool ParallelCsvZstReader::Seek(uint64_t position) {
+  const auto it = std::find_if(frames_.begin(), frames_.end(),
+                               [position](const ZstdFrameSpan& f) { return f.offset == position; });
+  if (it == frames_.end()) return false;
+
+  StopWorkers();
+  next_dispatch_ = static_cast<size_t>(it - frames_.begin());
+  next_emit_ = next_dispatch_;
+  current_.clear();
+  cursor_ = 0;
+  carry_.clear();
+  has_stitched_ = false;
+  header_pending_ = false;  // the frame's first line is a row
+  StartWorkers();
+  return true;
+}
+
+void ParallelCsvZstReader::StartWorkers() {
+  slots_.assign(window_, Chunk{});
+  stop_ = false;
+  for (unsigned i = 0; i < thread_count_; ++i) {
+    workers_.emplace_back(&ParallelCsvZstReader::WorkerLoop, this);
+  }
+}
+
+void ParallelCsvZstReader::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& t : workers_) {
+    if (t.joinable()) t.join();
+  }
+  workers_.clear();
+}
+
+// MARK: VERIFY HEADER
+// Streams just enough of the file to compare the header row, so a wrong file fails at
+// Open like it does for CsvZstReader. The header may itself span several tiny frames.
+bool ParallelCsvZstReader::VerifyHeader() {
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  std::string first_line;
+  std::vector<char> buf(4096);
+  ZSTD_inBuffer in = {map_, map_size_, 0};
+  bool found = false;
+
+  while (!found && in.pos < in.size) {
+    ZSTD_outBuffer out = {buf.data(), buf.size(), 0};
+    const size_t ret = ZSTD_decompressStream(dctx, &out, &in);
+    if (ZSTD_isError(ret)) break;
+    const auto* nl = static_cast<const char*>(std::memchr(buf.data(), '\n', out.pos));
+    const size_t n = nl ? static_cast<size_t>(nl - buf.data()) : out.pos;
+    first_line.append(buf.data(), n);
+    found = nl != nullptr;
+  }
+  ZSTD_freeDCtx(dctx);
+
+  return StripCr(first_line) == kExpectedMboHeader;
+}
+
+// MARK: WORKER LOOP
+void ParallelCsvZstReader::WorkerLoop() {
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  std::string text;
+  std::vector<uint32_t> delims;
+
+  while (true) {
+    size_t k;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      work_cv_.wait(lk, [this] {
+        return stop_ || next_dispatch_ >= frames_.size() ||
+               next_dispatch_ < next_emit_ + window_;
+      });
+      if (stop_ || next_dispatch_ >= frames_.size()) break;
+      k = next_dispatch_++;
+    }
+
+    Chunk chunk;
+    try {
+      DecodeChunk(dctx, frames_[k], text, delims, chunk);
+    } catch (...) {
+      chunk.error = std::current_exception();
+    }
+    chunk.ready = true;
+
+    {
+      std::lock_guard<std::mutex> lk(mutex_);
+      slots_[k % window_] = std::move(chunk);
+    }
+    ready_cv_.notify_all();
+  }
+  ZSTD_freeDCtx(dctx);
+}
+
+// MARK: DECODE CHUNK
+void ParallelCsvZstReader::DecodeChunk(ZSTD_DCtx* dctx, const ZstdFrameSpan& frame,
+                                       std::string& text, std::vector<uint32_t>& delims,
+                                       Chunk& out) const {
+  const char* src = static_cast<const char*>(map_) + frame.offset;
+  text.clear();
+
+  uint32_t magic = 0;
+  std::memcpy(&magic, src, std::min(frame.size, sizeof(magic)));
+  if ((magic & ZSTD_MAGIC_SKIPPABLE_MASK) == ZSTD_MAGIC_SKIPPABLE_START) return;
+
+  const unsigned long long content_size = ZSTD_getFrameContentSize(src, frame.size);
+  if (content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != ZSTD_CONTENTSIZE_ERROR) {
+    text.resize(content_size);
+    const size_t n = ZSTD_decompressDCtx(dctx, text.data(), text.size(), src, frame.size);
+    if (ZSTD_isError(n)) throw std::runtime_error(ZSTD_getErrorName(n));
+    text.resize(n);
+  } else {
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+    ZSTD_inBuffer in = {src, frame.size, 0};
+    const size_t step = ZSTD_DStreamOutSize();
+    size_t ret = 1;
+    while (ret != 0 && in.pos < in.size) {
+      const size_t used = text.size();
+      text.resize(used + step);
+      ZSTD_outBuffer o = {text.data() + used, step, 0};
+      ret = ZSTD_decompressStream(dctx, &o, &in);
+      if (ZSTD_isError(ret)) throw std::runtime_error(ZSTD_getErrorName(ret));
+      text.resize(used + o.pos);
+    }
+  }
+
+  const std::string_view view(text);
+  const size_t first_nl = view.find('\n');
+  if (first_nl == std::string_view::npos) {
+    out.head.assign(view);
+    return;
+  }
+  const size_t last_nl = view.rfind('\n');
+  out.has_newline = true;
+  out.head.assign(view.substr(0, first_nl));
+  out.tail.assign(view.substr(last_nl + 1));
+
+  out.events.reserve((last_nl - first_nl) / 96);  // ~100 bytes per MBO row
+  if (config_.parser == CsvParser::SIMD) {
+    ParseMboBlock(view.substr(first_nl + 1, last_nl - first_nl), config_, delims, out.events);
+    return;
+  }
+  size_t pos = first_nl + 1;
+  while (pos <= last_nl) {
+    const size_t nl = view.find('\n', pos);
+    MarketByOrderEvent ev;
+    if (ParseMboLine(StripCr(view.substr(pos, nl - pos)), config_, ev)) out.events.push_back(ev);
+    pos = nl + 1;
+  }
+}
+
+// MARK: READ EVENTS
+size_t ParallelCsvZstReader::ReadEvents(std::span<MarketByOrderEvent> out) {
+  size_t n = 0;
+  while (n < out.size()) {
+    if (has_stitched_) {
+      has_stitched_ = false;
+      out[n++] = stitched_;
+      continue;
+    }
+    if (cursor_ >= current_.size()) {
+      if (!NextChunk()) break;
+      continue;
+    }
+    const size_t take = std::min(out.size() - n, current_.size() - cursor_);
+    std::memcpy(out.data() + n, current_.data() + cursor_, take * sizeof(MarketByOrderEvent));
+    cursor_ += take;
+    n += take;
+  }
+  return n;
+}
+
+// MARK: NEXT CHUNK
+// Consumer side: takes the next decoded chunk in file order and resolves the line that
+// straddles the boundary with the previous one.
+bool ParallelCsvZstReader::NextChunk() {
+  while (true) {
+    current_.clear();
+    cursor_ = 0;
+
+    if (next_emit_ >= frames_.size()) {
+      if (carry_.empty()) return false;
+      const std::string last = std::move(carry_);
+      carry_.clear();
+      return ParseStitched(last);
+    }
+
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      Chunk& slot = slots_[next_emit_ % window_];
+      ready_cv_.wait(lk, [&slot] { return slot.ready; });
+      chunk = std::move(slot);
+      slot = Chunk{};
+      ++next_emit_;
+    }
+    work_cv_.notify_all();
+
+    if (chunk.error) std::rethrow_exception(chunk.error);
+
+    carry_ += chunk.head;
+    if (!chunk.has_newline) continue;  // whole frame is the middle of one long line
+
+    const std::string line = std::move(carry_);
+    carry_ = std::move(chunk.tail);
+    current_ = std::move(chunk.events);
+    ParseStitched(line);
+    if (has_stitched_ || !current_.empty()) return true;
+  }
+}
+
+bool ParallelCsvZstReader::ParseStitched(std::string_view line) {
+  line = StripCr(line);
+  if (header_pending_) {
+    header_pending_ = false;  // checked in VerifyHeader
+    return false;
+  }
+  has_stitched_ = ParseMboLine(line, config_, stitched_);
+  return has_stitched_;
+}
+
+}  // namespace backtester
@@ -0,0 +1,153 @@
+#include "data_ingestion/SimdCsvZstReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "core/Constants.h"
+#include "data_ingestion/MboCsvParser.h"
+#include "data_ingestion/ZstdFraming.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+// Decompressed bytes per parse pass. Large enough that the per-block scan and the
+// events_ refill are amortized over thousands of rows.
+constexpr size_t kBlockBytes = size_t{1} << 20;
+}  // namespace
+
+SimdCsvZstReader::~SimdCsvZstReader() { Close(); }
+
+// MARK: OPEN
+bool SimdCsvZstReader::Open(const std::string& filename) {
+  Close();
+  filename_ = filename;
+  if (!file_.Open(filename)) return false;
+
+  dstream_ = ZSTD_createDStream();
+  if (!dstream_ || ZSTD_isError(ZSTD_initDStream(dstream_))) return false;
+  input_eof_ = false;
+
+  // Header row, which may arrive over several decompress calls
+  const char* nl = nullptr;
+  while (true) {
+    if (text_end_ > 0) nl = static_cast<const char*>(std::memchr(text_.data(), '\n', text_end_));
+    if (nl || !Decompress()) break;
+  }
+  if (!nl) return false;
+
+  std::string_view header(text_.data(), static_cast<size_t>(nl - text_.data()));
+  if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+  if (header != kExpectedMboHeader) {
+    spdlog::error("SimdCsvZstReader: unexpected header in {}", filename);
+    return false;
+  }
+  text_begin_ = static_cast<size_t>(nl - text_.data()) + 1;
+  events_.reserve(kBlockBytes / 64);
+  return true;
+}
+
+// MARK: CLOSE
+void SimdCsvZstReader::Close() {
+  file_.Close();
+  if (dstream_) {
+    ZSTD_freeDStream(dstream_);
+    dstream_ = nullptr;
+  }
+  input_ = {};
+  input_pos_ = 0;
+  input_size_ = 0;
+  input_eof_ = true;
+  text_begin_ = 0;
+  text_end_ = 0;
+  events_.clear();
+  cursor_ = 0;
+}
+
+// MARK: SEEK
+bool SimdCsvZstReader::Seek(uint64_t position) {
+  if (!dstream_ || !IsZstdFrameAt(filename_, position)) return false;
+  if (!file_.Open(filename_, position)) return false;
+  ZSTD_DCtx_reset(dstream_, ZSTD_reset_session_only);
+  input_ = {};
+  input_pos_ = 0;
+  input_size_ = 0;
+  input_eof_ = false;
+  text_begin_ = 0;
+  text_end_ = 0;
+  events_.clear();
+  cursor_ = 0;
+  return true;
+}
+
+// MARK: READ EVENTS
+size_t SimdCsvZstReader::ReadEvents(std::span<MarketByOrderEvent> out) {
+  size_t n = 0;
+  while (n < out.size()) {
+    if (cursor_ >= events_.size() && !Refill()) break;
+    const size_t take = std::min(out.size() - n, events_.size() - cursor_);
+    std::memcpy(out.data() + n, events_.data() + cursor_, take * sizeof(MarketByOrderEvent));
+    cursor_ += take;
+    n += take;
+  }
+  return n;
+}
+
+// MARK: DECOMPRESS
+// Appends up to kBlockBytes of decompressed text after the unparsed remainder. Returns
+// false once the input is exhausted and nothing new was produced.
+bool SimdCsvZstReader::Decompress() {
+  if (!dstream_) return false;
+
+  if (text_begin_ > 0) {
+    std::memmove(text_.data(), text_.data() + text_begin_, text_end_ - text_begin_);
+    text_end_ -= text_begin_;
+    text_begin_ = 0;
+  }
+  if (text_.size() < text_end_ + kBlockBytes) text_.resize(text_end_ + kBlockBytes);
+
+  ZSTD_outBuffer output = {text_.data() + text_end_, kBlockBytes, 0};
+  while (output.pos < output.size) {
+    if (input_pos_ >= input_size_) {
+      if (input_eof_) break;
+      input_ = file_.NextBlock();
+      input_size_ = input_.size();
+      input_pos_ = 0;
+      if (input_size_ == 0) {
+        input_eof_ = true;
+        break;
+      }
+    }
+    ZSTD_inBuffer input = {input_.data(), input_size_, input_pos_};
+    const size_t ret = ZSTD_decompressStream(dstream_, &output, &input);
+    if (ZSTD_isError(ret)) {
+      spdlog::warn("zstd error in SimdCsvZstReader: {}", ZSTD_getErrorName(ret));
+      input_eof_ = true;
+      break;
+    }
+    input_pos_ = input.pos;
+  }
+  text_end_ += output.pos;
+  return output.pos > 0;
+}
+
+// MARK: REFILL
+bool SimdCsvZstReader::Refill() {
+  events_.clear();
+  cursor_ = 0;
+  while (events_.empty()) {
+    if (!Decompress()) {
+      if (text_begin_ == text_end_) return false;
+      // Last row without a trailing newline
+      if (text_.size() == text_end_) text_.push_back('\n');
+      else text_[text_end_] = '\n';
+      ++text_end_;
+    }
+    const std::string_view block(text_.data() + text_begin_, text_end_ - text_begin_);
+    text_begin_ += ParseMboBlock(block, config_, delims_, events_);
+  }
+  return true;
+}
+
+}  // namespace backtester
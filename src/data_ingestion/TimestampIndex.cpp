@@ -0,0 +1,430 @@
+#include "data_ingestion/TimestampIndex.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "data_ingestion/MboCacheReader.h"
+#include "data_ingestion/MboCsvParser.h"
+#include "data_ingestion/Mbp10CsvParser.h"
+#include "data_ingestion/OhlcvCsvParser.h"
+#include "data_ingestion/ZstdFraming.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+// Read-only mapping of a whole file, unmapped on scope exit
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) return;
+    struct stat st;
+    if (::fstat(fd_, &st) != 0 || st.st_size == 0) return;
+    size_ = static_cast<size_t>(st.st_size);
+    void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (map == MAP_FAILED) {
+      size_ = 0;
+      return;
+    }
+    data_ = static_cast<const char*>(map);
+    ::madvise(map, size_, MADV_SEQUENTIAL);
+  }
+  ~MappedFile() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0) ::close(fd_);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// MARK: IndexRecorder
+// Turns rows, in file order, into index entries. Each row comes with the position a reader
+// can seek to and the number of rows between that position and the row.
+class IndexRecorder {
+ public:
+  explicit IndexRecorder(timestamp_t interval_ns) : interval_ns_(interval_ns) {}
+
+  static uint64_t BookKey(uint32_t instrument_id, uint16_t publisher_id) {
+    return (uint64_t{instrument_id} << 16) | publisher_id;
+  }
+
+  // MBP-10 and OHLCV rows. Each interval entry opens a candidate, which recovers once every
+  // book seen before it has had a row of its own since: each of those rows rebuilds its book
+  // whole. The recovery entry carries the time of the row that completed it, so a seek for a
+  // later start finds every book already restored.
+  void OnRow(uint64_t book, timestamp_t ts, uint64_t position, uint32_t skip) {
+    if (IntervalDue(ts)) {
+      Add(ts, position, skip, kIndexInterval);
+      pending_.push_back({ts, position, skip, rows_, last_row_.size(), 0});
+    }
+    const auto [last, first_row] = last_row_.try_emplace(book, rows_);
+    if (!first_row) {
+      // This row is the book's first since every candidate opened after its previous one
+      for (auto c = pending_.rbegin(); c != pending_.rend() && c->row > last->second; ++c) {
+        ++c->covered;
+      }
+      last->second = rows_;
+    }
+    ++rows_;
+    // A later candidate's books include an earlier one's, so they complete in order
+    while (!pending_.empty() && pending_.front().covered == pending_.front().need) {
+      Add(ts, pending_.front().position, pending_.front().skip, kIndexRecovery);
+      pending_.pop_front();
+    }
+  }
+
+  void OnMbo(const MarketByOrderEvent& ev, uint64_t position, uint32_t skip) {
+    const timestamp_t ts = ev.header.timestamp;
+    const uint64_t key = BookKey(ev.instrument_id, ev.publisher_id);
+
+    if (ev.header.type == EventType::kMarketOrderClear) {
+      if (!in_run_ || ts != run_ts_) {
+        // A clear at a new timestamp opens a candidate snapshot. It recovers once every
+        // book seen before it has been cleared at that timestamp.
+        in_run_ = true;
+        run_ts_ = ts;
+        run_position_ = position;
+        run_skip_ = skip;
+        run_start_row_ = rows_;
+        run_need_ = first_seen_.size();
+        run_cleared_.clear();
+        run_done_ = false;
+      }
+      const auto seen = first_seen_.find(key);
+      if (seen != first_seen_.end() && seen->second < run_start_row_) run_cleared_.insert(key);
+      if (!run_done_ && run_cleared_.size() == run_need_) {
+        run_done_ = true;
+        Add(run_ts_, run_position_, run_skip_, kIndexRecovery);
+      }
+    }
+    first_seen_.emplace(key, rows_);
+    ++rows_;
+
+    if (IntervalDue(ts)) Add(ts, position, skip, kIndexInterval);
+  }
+
+  // Entries in file order; a recovery entry is only known once its snapshot completes,
+  // after interval entries that may follow its row.
+  std::vector<TimestampIndexEntry> Finish() {
+    std::stable_sort(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+      return a.position != b.position ? a.position < b.position : a.skip_rows < b.skip_rows;
+    });
+    // Merge entries recorded twice for one row at one time
+    std::vector<TimestampIndexEntry> out;
+    for (const auto& e : entries_) {
+      if (!out.empty() && out.back().position == e.position &&
+          out.back().skip_rows == e.skip_rows && out.back().ts == e.ts) {
+        out.back().flags |= e.flags;
+      } else {
+        out.push_back(e);
+      }
+    }
+    return out;
+  }
+
+ private:
+  timestamp_t interval_ns_;
+  timestamp_t next_interval_ = 0;
+  std::vector<TimestampIndexEntry> entries_;
+
+  uint64_t rows_ = 0;
+
+  // MBP-10 / OHLCV candidates
+  struct Candidate {
+    timestamp_t ts;
+    uint64_t position;
+    uint32_t skip;
+    uint64_t row;
+    size_t need;     // books seen before the candidate's row
+    size_t covered;  // of those, books with a row since
+  };
+  std::deque<Candidate> pending_;
+  std::unordered_map<uint64_t, uint64_t> last_row_;  // book key -> last row
+
+  // MBO snapshot tracking
+  std::unordered_map<uint64_t, uint64_t> first_seen_;  // book key -> first row
+  bool in_run_ = false;
+  bool run_done_ = false;
+  timestamp_t run_ts_ = 0;
+  uint64_t run_position_ = 0;
+  uint32_t run_skip_ = 0;
+  uint64_t run_start_row_ = 0;
+  size_t run_need_ = 0;
+  std::unordered_set<uint64_t> run_cleared_;
+
+  bool IntervalDue(timestamp_t ts) {
+    if (ts < next_interval_) return false;
+    next_interval_ = (ts / interval_ns_ + 1) * interval_ns_;
+    return true;
+  }
+
+  void Add(timestamp_t ts, uint64_t position, uint32_t skip, uint8_t flags) {
+    TimestampIndexEntry e{};
+    e.ts = ts;
+    e.position = position;
+    e.skip_rows = skip;
+    e.flags = flags;
+    entries_.push_back(e);
+  }
+};
+
+using RowFn = std::function<void(std::string_view row, uint64_t position, uint32_t skip)>;
+
+// Calls `on_row` with every line of `text` and its byte offset in `text`. A trailing partial
+// line is left for the next call unless `final_chunk`. Returns the bytes consumed.
+size_t ForEachRow(std::string_view text, bool final_chunk, const RowFn& on_row) {
+  size_t pos = 0;
+  while (pos < text.size()) {
+    const size_t nl = text.find('\n', pos);
+    if (nl == std::string_view::npos && !final_chunk) break;
+    const size_t end = nl == std::string_view::npos ? text.size() : nl;
+    std::string_view row = text.substr(pos, end - pos);
+    if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+    on_row(row, pos, 0);
+    pos = end + 1;
+  }
+  return std::min(pos, text.size());
+}
+
+// MARK: Format walkers
+// Each one hands rows to `on_row` with a seek position and the rows to skip after it.
+
+bool WalkPlainCsv(const std::string& path, const RowFn& on_row) {
+  MappedFile file(path);
+  if (!file.Data()) return false;
+  const std::string_view text(file.Data(), file.Size());
+  const size_t first_row = text.find('\n');
+  if (first_row == std::string_view::npos) return true;
+  ForEachRow(text.substr(first_row + 1), true,
+             [&](std::string_view row, uint64_t offset, uint32_t /*skip*/) {
+               if (!row.empty()) on_row(row, first_row + 1 + offset, 0);
+             });
+  return true;
+}
+
+// Rows of a frame that starts on a line boundary seek to that frame; rows of other frames
+// skip forward from the last such frame.
+bool WalkCsvZst(const std::string& path, const RowFn& on_row) {
+  MappedFile file(path);
+  if (!file.Data()) return false;
+  const auto frames = ScanZstdFrames(file.Data(), file.Size());
+  if (frames.empty()) return false;
+
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  std::string text;  // undelivered tail of the previous frames plus the current one
+  std::vector<char> out(ZSTD_DStreamOutSize());
+  bool header_pending = true;
+  uint64_t seek_position = 0;
+  uint32_t skip = 0;
+  bool ok = true;
+
+  auto deliver = [&](bool final_chunk) {
+    const size_t used = ForEachRow(text, final_chunk,
+                                   [&](std::string_view row, uint64_t, uint32_t) {
+                                     if (header_pending) {
+                                       header_pending = false;
+                                     } else if (!row.empty()) {
+                                       on_row(row, seek_position, skip++);
+                                     }
+                                   });
+    text.erase(0, used);
+  };
+
+  for (size_t k = 0; ok && k < frames.size(); ++k) {
+    if (k > 0 && text.empty()) {
+      seek_position = frames[k].offset;
+      skip = 0;
+    }
+    ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+    ZSTD_inBuffer in = {file.Data() + frames[k].offset, frames[k].size, 0};
+    while (in.pos < in.size) {
+      ZSTD_outBuffer o = {out.data(), out.size(), 0};
+      const size_t ret = ZSTD_decompressStream(dctx, &o, &in);
+      if (ZSTD_isError(ret)) {
+        spdlog::error("BuildTimestampIndex: {} in {}", ZSTD_getErrorName(ret), path);
+        ok = false;
+        break;
+      }
+      text.append(out.data(), o.pos);
+      deliver(false);
+      if (ret == 0) break;
+    }
+  }
+  if (ok) deliver(true);
+  ZSTD_freeDCtx(dctx);
+  return ok;
+}
+
+int64_t DataMtime(const std::string& data_filepath) {
+  std::error_code ec;
+  const auto mtime = std::filesystem::last_write_time(data_filepath, ec);
+  return ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+}
+
+}  // namespace
+
+// MARK: Paths
+std::string TimestampIndexPathFor(const std::string& data_filepath) {
+  return data_filepath + ".tsidx";
+}
+
+std::optional<IndexPosition> IndexPositionFor(const DataSourceConfig& source) {
+  if (source.encoding == Encoding::MBOCACHE) return IndexPosition::kRecord;
+  if (source.encoding != Encoding::CSV) return std::nullopt;
+  return source.compression == Compression::ZSTD ? IndexPosition::kFrameOffset
+                                                 : IndexPosition::kByteOffset;
+}
+
+// MARK: Build
+bool BuildTimestampIndex(const DataSourceConfig& source, const std::string& data_filepath,
+                         timestamp_t interval_ns) {
+  const auto kind = IndexPositionFor(source);
+  if (!kind) {
+    spdlog::error("BuildTimestampIndex: no index for the encoding of {}", data_filepath);
+    return false;
+  }
+  if (interval_ns == 0) interval_ns = kDefaultIndexIntervalNs;
+
+  IndexRecorder recorder(interval_ns);
+  bool ok = true;
+  if (*kind == IndexPosition::kRecord) {
+    MboCacheReader reader(false);
+    ok = reader.Open(data_filepath);
+    if (ok) {
+      const auto events = reader.Events();
+      for (size_t i = 0; i < events.size(); ++i) recorder.OnMbo(events[i], i, 0);
+    }
+  } else {
+    MarketByOrderEvent mbo;
+    OhlcvBarEvent bar;
+    Mbp10CsvDecoder mbp10(source);
+    std::array<EventUnion, Mbp10CsvDecoder::kMaxEventsPerRow> mbp10_out;
+    const RowFn on_row = [&](std::string_view row, uint64_t position, uint32_t skip) {
+      switch (source.schema) {
+        case DataSchema::MBO:
+          if (ParseMboLine(row, source, mbo)) recorder.OnMbo(mbo, position, skip);
+          break;
+        case DataSchema::OHLCV:
+          if (ParseOhlcvLine(row, source, bar)) {
+            recorder.OnRow(IndexRecorder::BookKey(bar.instrument_id, bar.publisher_id),
+                           bar.header.timestamp, position, skip);
+          }
+          break;
+        case DataSchema::MBP10:
+          if (size_t n = mbp10.DecodeLine(row, mbp10_out)) {
+            const MarketLevelEvent& level = mbp10_out[n - 1].level;
+            recorder.OnRow(IndexRecorder::BookKey(level.instrument_id, level.publisher_id),
+                           level.header.timestamp, position, skip);
+          }
+          break;
+      }
+    };
+    ok = *kind == IndexPosition::kByteOffset ? WalkPlainCsv(data_filepath, on_row)
+                                             : WalkCsvZst(data_filepath, on_row);
+  }
+  if (!ok) {
+    spdlog::error("BuildTimestampIndex: could not read {}", data_filepath);
+    return false;
+  }
+
+  const std::vector<TimestampIndexEntry> entries = recorder.Finish();
+  TimestampIndexHeader header{};
+  std::memcpy(header.magic, kTimestampIndexMagic, sizeof(header.magic));
+  header.version = kTimestampIndexVersion;
+  header.position_kind = *kind;
+  header.interval_ns = interval_ns;
+  header.data_size = std::filesystem::file_size(data_filepath);
+  header.data_mtime = DataMtime(data_filepath);
+  header.entry_count = entries.size();
+
+  const std::string out_path = TimestampIndexPathFor(data_filepath);
+  std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(entries.data()),
+            static_cast<std::streamsize>(entries.size() * sizeof(TimestampIndexEntry)));
+  if (!out) {
+    spdlog::error("BuildTimestampIndex: failed writing {}", out_path);
+    return false;
+  }
+  const size_t recovery = static_cast<size_t>(std::count_if(
+      entries.begin(), entries.end(), [](const auto& e) { return e.flags & kIndexRecovery; }));
+  spdlog::info("BuildTimestampIndex: {} entries ({} recovery points) for {}", entries.size(),
+               recovery, data_filepath);
+  return true;
+}
+
+// MARK: Load
+bool TimestampIndex::Load(const std::string& index_path, const std::string& data_filepath,
+                          IndexPosition expected) {
+  header_ = {};
+  entries_.clear();
+
+  std::ifstream in(index_path, std::ios::binary);
+  if (!in.is_open()) return false;
+  in.read(reinterpret_cast<char*>(&header_), sizeof(header_));
+  if (!in || std::memcmp(header_.magic, kTimestampIndexMagic, sizeof(header_.magic)) != 0 ||
+      header_.version != kTimestampIndexVersion) {
+    spdlog::warn("TimestampIndex: {} is not a version {} index", index_path,
+                 kTimestampIndexVersion);
+    return false;
+  }
+  if (header_.position_kind != expected) {
+    spdlog::warn("TimestampIndex: {} was built for another encoding", index_path);
+    return false;
+  }
+  std::error_code ec;
+  const auto data_size = std::filesystem::file_size(data_filepath, ec);
+  if (ec || data_size != header_.data_size || DataMtime(data_filepath) != header_.data_mtime) {
+    spdlog::warn("TimestampIndex: {} is stale, rebuild it with 'index'", index_path);
+    return false;
+  }
+  const auto index_size = std::filesystem::file_size(index_path, ec);
+  if (ec || header_.entry_count != (index_size - sizeof(header_)) / sizeof(TimestampIndexEntry)) {
+    spdlog::warn("TimestampIndex: {} does not hold the {} entries its header claims", index_path,
+                 header_.entry_count);
+    return false;
+  }
+
+  entries_.resize(header_.entry_count);
+  in.read(reinterpret_cast<char*>(entries_.data()),
+          static_cast<std::streamsize>(entries_.size() * sizeof(TimestampIndexEntry)));
+  if (!in) {
+    spdlog::warn("TimestampIndex: {} is truncated", index_path);
+    entries_.clear();
+    return false;
+  }
+  return true;
+}
+
+const TimestampIndexEntry* TimestampIndex::RecoveryPointBefore(timestamp_t ts) const {
+  const TimestampIndexEntry* best = nullptr;
+  for (const auto& e : entries_) {
+    if ((e.flags & kIndexRecovery) && e.ts < ts) best = &e;
+  }
+  return best;
+}
+
+}  // namespace backtester
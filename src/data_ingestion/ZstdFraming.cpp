@@ -0,0 +1,115 @@
+#include "data_ingestion/ZstdFraming.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <fstream>
+
+#include "data_ingestion/CsvZstReader.h"
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+// MARK: Scan Frames
+std::vector<ZstdFrameSpan> ScanZstdFrames(const void* data, size_t size) {
+  std::vector<ZstdFrameSpan> frames;
+  const auto* base = static_cast<const char*>(data);
+  size_t offset = 0;
+  while (offset < size) {
+    const size_t frame_size = ZSTD_findFrameCompressedSize(base + offset, size - offset);
+    if (ZSTD_isError(frame_size) || frame_size == 0) return {};
+    frames.push_back({offset, frame_size});
+    offset += frame_size;
+  }
+  return frames;
+}
+
+size_t CountZstdFrames(const std::string& filename) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return 0;
+
+  struct stat st;
+  size_t count = 0;
+  if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      count = ScanZstdFrames(map, size).size();
+      ::munmap(map, size);
+    }
+  }
+  ::close(fd);
+  return count;
+}
+
+bool IsZstdFrameAt(const std::string& filename, size_t offset) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  uint32_t magic = 0;
+  const ssize_t n = ::pread(fd, &magic, sizeof(magic), static_cast<off_t>(offset));
+  ::close(fd);
+  return n == static_cast<ssize_t>(sizeof(magic)) && magic == ZSTD_MAGICNUMBER;
+}
+
+// MARK: Reframe
+bool ReframeCsvZst(const std::string& in_path, const std::string& out_path, size_t frame_bytes) {
+  CsvZstReader reader;
+  if (!reader.Open(in_path)) {
+    spdlog::error("ReframeCsvZst: could not open {}", in_path);
+    return false;
+  }
+  std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    spdlog::error("ReframeCsvZst: could not open {}", out_path);
+    return false;
+  }
+
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  std::string block;
+  std::vector<char> compressed;
+  std::string_view line;
+  size_t frame_count = 0;
+  bool ok = true;
+
+  auto flush = [&]() {
+    if (block.empty()) return;
+    compressed.resize(ZSTD_compressBound(block.size()));
+    const size_t n = ZSTD_compressCCtx(cctx, compressed.data(), compressed.size(), block.data(),
+                                       block.size(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(n)) {
+      spdlog::error("ReframeCsvZst: {}", ZSTD_getErrorName(n));
+      ok = false;
+    } else {
+      out.write(compressed.data(), static_cast<std::streamsize>(n));
+      ++frame_count;
+    }
+    block.clear();
+  };
+
+  block.reserve(frame_bytes + 4096);
+  while (ok && reader.ReadLineView(line)) {
+    block.append(line);
+    block.push_back('\n');
+    if (block.size() >= frame_bytes) flush();
+  }
+  if (ok) flush();
+  ZSTD_freeCCtx(cctx);
+
+  if (!ok || !out) return false;
+  spdlog::info("ReframeCsvZst: wrote {} frames to {}", frame_count, out_path);
+  return true;
+}
+
+std::string FramedPathFor(const std::string& data_filepath) {
+  static const std::string kCsvZst = ".csv.zst";
+  if (data_filepath.size() > kCsvZst.size() &&
+      data_filepath.compare(data_filepath.size() - kCsvZst.size(), kCsvZst.size(), kCsvZst) == 0) {
+    return data_filepath.substr(0, data_filepath.size() - kCsvZst.size()) + ".framed" + kCsvZst;
+  }
+  return data_filepath + ".framed";
+}
+
+}  // namespace backtester
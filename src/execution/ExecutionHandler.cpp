@@ -154,6 +154,12 @@ void ExecutionHandler::OnMarketEvent(const MarketByOrderEvent& mbo_event) {
   RunFillModel(mbo_event.header.timestamp, &mbo_event);
 }
 
+void ExecutionHandler::OnBarEvent(const OhlcvBarEvent& bar) {
+  if (BT_UNLIKELY(!IsBarDriven(bar.instrument_id))) bar_instruments_.push_back(bar.instrument_id);
+  if (pending_orders_.empty()) return;
+  CheckFillsBar(bar);
+}
+
 // =============================================================================
 // MARK: Queue Position Fill Model
 // =============================================================================
@@ -183,6 +189,7 @@ void ExecutionHandler::CheckFillsQueuePosition(timestamp_t now,
 
   for (size_t i = 0; i < pending_orders_.size(); i++) {
     auto& pending = pending_orders_[i];
+    if (BT_UNLIKELY(IsBarDriven(pending.instrument_id))) continue;  // see CheckFillsBar
     if (pending.state == OrderState::PendingLive) {
       if (!pending.IsLive(now)) continue;
       if (GoLive(pending, mbo_event)) {
@@ -275,6 +282,7 @@ void ExecutionHandler::CheckFillsTopOfBook(timestamp_t now, const MarketByOrderE
   BidAskPair bbo;
   for (size_t i = 0; i < pending_orders_.size(); i++) {
     auto& pending = pending_orders_[i];
+    if (BT_UNLIKELY(IsBarDriven(pending.instrument_id))) continue;  // see CheckFillsBar
     if (pending.state == OrderState::PendingLive) {
       if (!pending.IsLive(now)) continue;
       if (GoLive(pending, mbo_event)) {
@@ -310,6 +318,36 @@ void ExecutionHandler::CheckFillsTopOfBook(timestamp_t now, const MarketByOrderE
   }
 }
 
+// =============================================================================
+// MARK: Bar Fill Model
+// =============================================================================
+// A bar only tells us the range traded after the order went live, not the queue,
+// so a reached limit fills in full at the limit price (never better).
+
+void ExecutionHandler::CheckFillsBar(const OhlcvBarEvent& bar) {
+  filled_idxs_.clear();
+  const timestamp_t now = bar.header.timestamp;
+
+  for (size_t i = 0; i < pending_orders_.size(); i++) {
+    auto& pending = pending_orders_[i];
+    if (pending.instrument_id != bar.instrument_id || !pending.IsLive(now)) continue;
+    pending.state = OrderState::Live;
+
+    const bool reached = pending.side == OrderSide::kBid ? bar.low <= pending.price
+                                                         : bar.high >= pending.price;
+    if (!reached) continue;
+
+    spdlog::info("Execution: Order {} filled (bar). low={} high={} order_price={}",
+                 pending.order_id, bar.low, bar.high, pending.price);
+    EmitFill(pending, pending.price, pending.remaining_qty, now);
+    filled_idxs_.push_back(i);
+  }
+
+  for (auto it = filled_idxs_.rbegin(); it != filled_idxs_.rend(); ++it) {
+    pending_orders_.erase(pending_orders_.begin() + static_cast<int64_t>(*it));
+  }
+}
+
 // =============================================================================
 // MARK: Helpers
 // =============================================================================
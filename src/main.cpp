@@ -2,9 +2,16 @@
 
 #include "core/Backtester.h"
 #include "core/ConfigParser.h"
+#include "core/DayShardedBacktest.h"
+#include "core/ParameterSweep.h"
 #include "core/Types.h"
+#include "data_ingestion/EventArena.h"
+#include "data_ingestion/MboCacheWriter.h"
+#include "data_ingestion/TimestampIndex.h"
+#include "data_ingestion/ZstdFraming.h"
 #include "execution/ExecutionHandler.h"
 #include "market_state/MarketStateManager.h"
+#include "market_state/SnapshotMarketDataProvider.h"
 #include "portfolio/PortfolioManager.h"
 #include "reporting/ReportGenerator.h"
 #include "spdlog/sinks/basic_file_sink.h"
@@ -27,11 +34,84 @@ void SetupLogging(std::string log_path) {
   spdlog::flush_on(spdlog::level::info);
 }
 
+// Decodes every configured source once and writes it next to the original as a packed
+// MBO cache (see MboCacheFormat.h). Point a data stream at the .bin with
+// "encoding": "mbocache" to replay it without any text parsing.
+int BuildMboCaches(const backtester::AppConfig& config,
+                   backtester::DataReaderManager& data_reader_manager) {
+  for (const auto& dc : config.data_configs) {
+    if (dc.encoding == backtester::Encoding::MBOCACHE) {
+      spdlog::warn("Source {} is already an MBO cache, skipping", dc.data_source_name);
+      continue;
+    }
+    if (dc.schema != backtester::DataSchema::MBO) {
+      spdlog::warn("Source {} is not MBO, skipping", dc.data_source_name);
+      continue;
+    }
+    const std::string out_path = backtester::MboCachePathFor(dc.data_filepath);
+    backtester::MboCacheWriter writer;
+    if (!writer.Open(out_path)) return 1;
+
+    MarketByOrderEvent mbo;
+    while (data_reader_manager.LoadNextEventFromSource(dc.data_source_id, mbo)) {
+      if (!writer.Append(mbo)) {
+        spdlog::error("Failed writing MBO cache record to {}", out_path);
+        return 1;
+      }
+    }
+    if (data_reader_manager.Failed()) return 1;  // a partial cache would pass for the source
+    if (!writer.Finalize()) return 1;
+    spdlog::info("Cached {} events for {} at {}", writer.RecordCount(), dc.data_source_name,
+                 out_path);
+  }
+  return 0;
+}
+
+// Rewrites each zstd source as many independent frames next to the original (see
+// ZstdFraming.h) so it can be decoded with "decode_threads" > 1.
+int ReframeSources(const backtester::AppConfig& config) {
+  for (const auto& dc : config.data_configs) {
+    if (dc.compression != backtester::Compression::ZSTD) {
+      spdlog::warn("Source {} is not zstd compressed, skipping", dc.data_source_name);
+      continue;
+    }
+    const std::vector<std::string> files =
+        dc.data_files.empty() ? std::vector<std::string>{dc.data_filepath} : dc.data_files;
+    for (const auto& file : files) {
+      const std::string out_path = backtester::FramedPathFor(file);
+      if (!backtester::ReframeCsvZst(file, out_path)) {
+        spdlog::error("Failed reframing {} to {}", file, out_path);
+        return 1;
+      }
+      spdlog::info("Reframed {} into {} frames at {}", dc.data_source_name,
+                   backtester::CountZstdFrames(out_path), out_path);
+    }
+  }
+  return 0;
+}
+
+// Writes a sparse timestamp index next to every data file (see TimestampIndex.h) so sources
+// with "seek_to_start" can skip the part of the file before start_time.
+int BuildTimestampIndexes(const backtester::AppConfig& config) {
+  for (const auto& dc : config.data_configs) {
+    if (!backtester::IndexPositionFor(dc)) {
+      spdlog::warn("Source {} has no index format, skipping", dc.data_source_name);
+      continue;
+    }
+    const std::vector<std::string> files =
+        dc.data_files.empty() ? std::vector<std::string>{dc.data_filepath} : dc.data_files;
+    for (const auto& file : files) {
+      if (!backtester::BuildTimestampIndex(dc, file)) return 1;
+    }
+  }
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
   spdlog::info("Backtester Program Started");
 
   if (argc != 2 && argc != 3) {
-    spdlog::error(R"(Usage: {} <path to config.json> <threaded | single>
+    spdlog::error(R"(Usage: {} <path to config.json> <threaded | single | pipelined | cache | reframe | index | arena | sweep | days>
             Try running the included demo from the build folder: 
             {} ../config/demo.json --threaded)",
                   argv[0], argv[0]);
@@ -41,8 +121,15 @@ int main(int argc, char* argv[]) {
   std::filesystem::path config_path;
   std::string arg = argv[1];
   if (arg == "-h" || arg == "--help") {
-    spdlog::info(R"(Usage: ./Backtester <path to config.json> <threaded | single>
-            Runs a backtest with the specified configuration and either single threaded or multi.)",
+    spdlog::info(R"(Usage: ./Backtester <path to config.json> <threaded | single | pipelined | cache | reframe | index | arena | sweep | days>
+            Runs a backtest with the specified configuration and either single threaded or multi.
+            'pipelined' also moves book building off the strategy thread onto a third one.
+            'cache' instead converts each data stream into a binary MBO cache for fast replay.
+            'reframe' splits each .csv.zst into independent frames for parallel decoding.
+            'index' writes a timestamp index per data file for "seek_to_start" sources.
+            'arena' decodes every MBO source once into "event_arena_dir" for later runs.
+            'sweep' runs one backtest per combination of the config's "sweep" grid.
+            'days' runs each UTC day of the window on its own and merges the reports.)",
                  arg[0]);
     return 0;
   }
@@ -66,34 +153,79 @@ int main(int argc, char* argv[]) {
   SetupLogging(config.log_file_path);
   spdlog::info("Logger Initialized");
 
+  std::string mode = (argc == 3) ? argv[2] : "threaded";  // default threaded
+
   backtester::EventQueue event_queue;
   backtester::DataReaderManager data_reader_manager;
   backtester::MarketStateManager market_state_manager;
   market_state_manager.Initialize(config.active_instruments);
 
-  backtester::PortfolioManager portfolio_manager(config, market_state_manager);
+  // A pipelined run builds the book on its own thread; the rest reads it through frames
+  const bool pipelined = mode == "pipelined";
+  backtester::SnapshotMarketDataProvider frame_view(config.traded_instruments);
+  const backtester::IMarketDataProvider& market =
+      pipelined ? static_cast<const backtester::IMarketDataProvider&>(frame_view)
+                : market_state_manager;
+
+  backtester::PortfolioManager portfolio_manager(config, market);
   backtester::ReportGenerator report_generator(config);
-  backtester::ExecutionHandler execution_handler(event_queue, config, market_state_manager);
+  backtester::ExecutionHandler execution_handler(event_queue, config, market);
   backtester::StrategyManager strategy_manager(config);
-  strategy_manager.InitializeStrategies(market_state_manager);
+  strategy_manager.InitializeStrategies(market);
 
-  if (!data_reader_manager.RegisterAndInitStreams(config.data_configs)) {
+  if (mode == "arena") {
+    if (config.event_arena_dir.empty()) {
+      spdlog::error("'arena' needs \"event_arena_dir\" in the config, e.g. /dev/shm");
+      return 1;
+    }
+    const auto arena = backtester::EventArena::BuildShared(
+        config.data_configs, config.event_arena_dir, config.start_time);
+    return arena ? 0 : 1;
+  }
+  if (mode == "sweep") {
+    if (config.sweep.axes.empty()) {
+      spdlog::error("'sweep' needs a \"sweep\" grid in the config");
+      return 1;
+    }
+    backtester::ParameterSweep sweep(config);
+    return sweep.Run() ? 0 : 1;
+  }
+  if (mode == "days") {
+    backtester::DayShardedBacktest days(config);
+    return days.Run() ? 0 : 1;
+  }
+  // Only a backtest may start mid-file; cache and the other tools need every row
+  const bool backtest = mode == "single" || mode == "threaded" || pipelined;
+  if (backtest && !config.event_arena_dir.empty()) {
+    data_reader_manager.UseArena(backtester::EventArena::OpenShared(
+        config.data_configs, config.event_arena_dir, config.start_time));
+  }
+  if (!data_reader_manager.RegisterAndInitStreams(config.data_configs,
+                                                  backtest ? config.start_time : 0)) {
     throw std::runtime_error("Problem parsing data configuration, check logs");
   };
 
   backtester::Backtester backtester(event_queue, data_reader_manager, market_state_manager,
                                     portfolio_manager, report_generator, execution_handler,
                                     strategy_manager, config);
-  
-  std::string mode = (argc == 3) ? argv[2] : "threaded";  // default threaded
-  if (mode == "single") {
-    backtester.RunLoopSingleThreaded();
+
+  if (mode == "reframe") {
+    return ReframeSources(config);
+  } else if (mode == "index") {
+    return BuildTimestampIndexes(config);
+  } else if (mode == "cache") {
+    return BuildMboCaches(config, data_reader_manager);
+  } else if (mode == "single") {
+    return backtester.RunLoopSingleThreaded();
   } else if (mode == "threaded") {
-    backtester.RunLoopThreaded();
+    return backtester.RunLoopThreaded();
+  } else if (pipelined) {
+    return backtester.RunLoopPipelined(frame_view);
   } else {
-    spdlog::error("Unknown mode '{}': use 'single' or 'threaded'", mode);
+    spdlog::error(
+        "Unknown mode '{}': use 'single', 'threaded', 'pipelined', 'cache', 'reframe', 'index', "
+        "'arena', 'sweep' or 'days'",
+        mode);
     return 1;
   }
-
-  return 0;
 }
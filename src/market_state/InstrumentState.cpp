@@ -1,14 +1,83 @@
 #include "market_state/InstrumentState.h"
 
+#include <algorithm>
+#include <limits>
 #include <span>
 
 #include "market_state/OrderBook.h"
 
 namespace backtester {
 
+namespace {
+
+// The book queries below are shared by OrderBook (MBO) and LevelBook (MBP-10) instruments.
+
+template <class Book>
+const Book* FindBook(const std::vector<Book>& books, uint16_t publisher_id) {
+  auto it = std::find_if(books.begin(), books.end(), [publisher_id](const Book& book) {
+    return publisher_id == book.publisher_id;
+  });
+  return (it != books.end()) ? &(*it) : nullptr;
+}
+
+template <class Book>
+BidAskPair AggregateBbo(const std::vector<Book>& books) {
+  BidAskPair agg;
+  for (auto& book : books) {
+    BidAskPair bbo = book.GetBbo();
+    if (bbo.bid.price != 0 && bbo.bid.price != kUndefPrice) {
+      if (bbo.bid.price > agg.bid.price || agg.bid.price == kUndefPrice) {
+        agg.bid = bbo.bid;
+      } else if (bbo.bid.price == agg.bid.price) {
+        agg.bid.size += bbo.bid.size;
+        agg.bid.count += bbo.bid.count;
+      }
+    }
+
+    if (bbo.ask.price != 0 && bbo.ask.price != kUndefPrice) {
+      if (bbo.ask.price < agg.ask.price) {
+        agg.ask = bbo.ask;
+      } else if (bbo.ask.price == agg.ask.price) {
+        agg.ask.size += bbo.ask.size;
+        agg.ask.count += bbo.ask.count;
+      }
+    }
+  }
+  return agg;
+}
+
+template <class Book, class GetLevel>
+void AggregateLevels(const std::vector<Book>& books, std::span<PriceLevel> snapshot,
+                     GetLevel get_level) {
+  // Each book's levels are merged in one pass, fetching the next level only on a match
+  for (const auto& book : books) {
+    size_t book_idx = 0;
+    PriceLevel level = get_level(book, book_idx);
+    for (auto& snap : snapshot) {
+      if (level.price != snap.price) continue;
+      snap.count += level.count;
+      snap.size += level.size;
+      level = get_level(book, ++book_idx);
+    }
+  }
+}
+
+template <class Book>
+int64_t QueueDepthByPx(const std::vector<Book>& books, OrderSide side, int64_t price) {
+  int64_t total_depth = 0;
+  for (auto& book : books) {
+    total_depth += book.GetLevelByPx(side, price).size;
+  }
+  return total_depth;
+}
+
+}  // namespace
+
 void InstrumentState::OnMarketEvent(const MarketByOrderEvent& event) {
-  OrderBook& book = GetOrInsertOrderBook(event.publisher_id);
-  book.Apply(event);
+  if (BT_LIKELY(!level_driven_)) {
+    OrderBook& book = GetOrInsertOrderBook(event.publisher_id);
+    book.Apply(event);
+  }
 
   if (event.price != std::numeric_limits<int64_t>::max()) {
     // Update VWAP - equation : cumulative_notional / cumulative_volume
@@ -24,101 +93,97 @@ void InstrumentState::OnMarketEvent(const MarketByOrderEvent& event) {
 
       snapshot_.session_high = std::max(event.price, snapshot_.session_high);
       snapshot_.session_low = std::min(event.price, snapshot_.session_low);
-    } else if (event.header.type != EventType::kMarketFill && event.flags & 0x80) {
+    } else if (!level_driven_ && event.header.type != EventType::kMarketFill &&
+               event.flags & 0x80) {
       UpdateInstrumentBbo();
-
-      // Update WMP - equation : (bid_price * ask_size + ask_price * bid_size) / (bid_size +
-      // ask_size)
-      int64_t total_size = instrument_Bbo_.bid.size + instrument_Bbo_.ask.size;
-      if (total_size > 0 && instrument_Bbo_.bid.price != kUndefPrice &&
-          instrument_Bbo_.ask.price != kUndefPrice) {
-        snapshot_.wmp = (instrument_Bbo_.bid.price * instrument_Bbo_.ask.size +
-                         instrument_Bbo_.ask.price * instrument_Bbo_.bid.size) /
-                        total_size;
-      }
+      UpdateWmp();
     }
   }
 }
 
-void InstrumentState::UpdateInstrumentBbo() {
-  instrument_Bbo_.bid = {};
-  instrument_Bbo_.ask = {};
-
-  for (auto& book : books_) {
-    BidAskPair bbo = book.GetBbo();
-    if (bbo.bid.price != 0 && bbo.bid.price != kUndefPrice) {
-      if (bbo.bid.price > instrument_Bbo_.bid.price || instrument_Bbo_.bid.price == kUndefPrice) {
-        instrument_Bbo_.bid = bbo.bid;
-      } else if (bbo.bid.price == instrument_Bbo_.bid.price) {
-        instrument_Bbo_.bid.size += bbo.bid.size;
-        instrument_Bbo_.bid.count += bbo.bid.count;
-      }
-    }
+void InstrumentState::OnLevelEvent(const MarketLevelEvent& level) {
+  level_driven_ = true;
+  GetOrInsertLevelBook(level.publisher_id).Apply(level);
+  if (level.depth == 0) {
+    UpdateInstrumentBbo();
+    UpdateWmp();
+  }
+}
 
-    if (bbo.ask.price != 0 && bbo.ask.price != kUndefPrice) {
-      if (bbo.ask.price < instrument_Bbo_.ask.price) {
-        instrument_Bbo_.ask = bbo.ask;
-      } else if (bbo.ask.price == instrument_Bbo_.ask.price) {
-        instrument_Bbo_.ask.size += bbo.ask.size;
-        instrument_Bbo_.ask.count += bbo.ask.count;
-      }
-    }
+void InstrumentState::OnBarEvent(const OhlcvBarEvent& bar) {
+  instrument_Bbo_.bid = {.price = bar.close, .size = 0, .count = 0};
+  instrument_Bbo_.ask = instrument_Bbo_.bid;
+  snapshot_.bbo = instrument_Bbo_;
+  snapshot_.wmp = bar.close;
+
+  if (bar.volume > 0) {
+    // VWAP from the bar's typical price, the best available without the trades
+    snapshot_.cumulative_volume += static_cast<int64_t>(bar.volume);
+    cumulative_notional_ += static_cast<__int128_t>((bar.high + bar.low + bar.close) / 3) *
+                            static_cast<__int128_t>(bar.volume);
+    snapshot_.vwap = static_cast<price_t>(cumulative_notional_ / snapshot_.cumulative_volume);
   }
+
+  snapshot_.last_trade.aggressor_side = OrderSide::kNone;
+  snapshot_.last_trade.price = bar.close;
+  snapshot_.last_trade.size =
+      static_cast<uint32_t>(std::min<uint64_t>(bar.volume, std::numeric_limits<uint32_t>::max()));
+  snapshot_.last_trade.timestamp = bar.header.timestamp;
+
+  snapshot_.session_high = std::max(bar.high, snapshot_.session_high);
+  snapshot_.session_low = std::min(bar.low, snapshot_.session_low);
+}
+
+void InstrumentState::UpdateInstrumentBbo() {
+  instrument_Bbo_ = level_driven_ ? AggregateBbo(level_books_) : AggregateBbo(books_);
   snapshot_.bbo = instrument_Bbo_;
 }
 
+void InstrumentState::UpdateWmp() {
+  // Update WMP - equation : (bid_price * ask_size + ask_price * bid_size) / (bid_size +
+  // ask_size)
+  int64_t total_size = instrument_Bbo_.bid.size + instrument_Bbo_.ask.size;
+  if (total_size > 0 && instrument_Bbo_.bid.price != kUndefPrice &&
+      instrument_Bbo_.ask.price != kUndefPrice) {
+    snapshot_.wmp = (instrument_Bbo_.bid.price * instrument_Bbo_.ask.size +
+                     instrument_Bbo_.ask.price * instrument_Bbo_.bid.size) /
+                    total_size;
+  }
+}
+
 const std::vector<BidAskPair> InstrumentState::GetOBSnapshotByPub(uint16_t publisher_id,
                                                                   std::size_t level_count) const {
   static const std::vector<BidAskPair> EMPTY_SNAPSHOT;
 
-  const OrderBook* book = GetOrderBook(publisher_id);
+  if (level_driven_) {
+    const LevelBook* book = FindBook(level_books_, publisher_id);
+    return book ? book->GetSnapshot(level_count) : EMPTY_SNAPSHOT;
+  }
+  const OrderBook* book = FindBook(books_, publisher_id);
   return book ? book->GetSnapshot(level_count) : EMPTY_SNAPSHOT;
 }
 
 void InstrumentState::GetAggOBBidsSnapshot(std::span<PriceLevel> snapshot) const {
-  size_t num_books = books_.size();
-  std::vector<size_t> book_indices(num_books, 0);
-  size_t snap_i = 0;
-  size_t book_i = 0;
-
-  while (snap_i < snapshot.size()) {
-    for (; book_i < num_books; book_i++) {
-      PriceLevel level = books_[book_i].GetBidLevel(book_indices[book_i]);
-      if (level.price != snapshot[snap_i].price) continue;
-      snapshot[snap_i].count += level.count;
-      snapshot[snap_i].size += level.size;
-      book_indices[book_i]++;
-    }
-    book_i = 0;
-    snap_i++;
+  auto bid_level = [](const auto& book, size_t idx) { return book.GetBidLevel(idx); };
+  if (level_driven_) {
+    AggregateLevels(level_books_, snapshot, bid_level);
+  } else {
+    AggregateLevels(books_, snapshot, bid_level);
   }
 }
 
 void InstrumentState::GetAggOBAsksSnapshot(std::span<PriceLevel> snapshot) const {
-  size_t num_books = books_.size();
-  std::vector<size_t> book_indices(num_books, 0);
-  size_t snap_i = 0;
-  size_t book_i = 0;
-
-  while (snap_i < snapshot.size()) {
-    for (; book_i < num_books; book_i++) {
-      PriceLevel level = books_[book_i].GetAskLevel(book_indices[book_i]);
-      if (level.price != snapshot[snap_i].price) continue;
-      snapshot[snap_i].count += level.count;
-      snapshot[snap_i].size += level.size;
-      book_indices[book_i]++;
-    }
-    book_i = 0;
-    snap_i++;
+  auto ask_level = [](const auto& book, size_t idx) { return book.GetAskLevel(idx); };
+  if (level_driven_) {
+    AggregateLevels(level_books_, snapshot, ask_level);
+  } else {
+    AggregateLevels(books_, snapshot, ask_level);
   }
 }
 
 int64_t InstrumentState::GetQueueDepthByPx(OrderSide side, int64_t price) const {
-  int64_t total_depth = 0;
-  for (auto& book : books_) {
-    total_depth += book.GetLevelByPx(side, price).size;
-  }
-  return total_depth;
+  return level_driven_ ? QueueDepthByPx(level_books_, side, price)
+                       : QueueDepthByPx(books_, side, price);
 }
 
 }  // namespace backtester
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "market_state/LevelBook.h"
+
+namespace backtester {
+LevelBook::LevelBook(uint16_t pub_id) : publisher_id(pub_id) {};
+
+// MARK: Getters
+PriceLevel LevelBook::GetBidLevel(std::size_t idx) const {
+  return idx < kDepth ? bids_[idx] : PriceLevel{};
+}
+
+PriceLevel LevelBook::GetAskLevel(std::size_t idx) const {
+  return idx < kDepth ? asks_[idx] : PriceLevel{};
+}
+
+PriceLevel LevelBook::GetLevelByPx(OrderSide side, int64_t price) const {
+  const auto& levels = side == OrderSide::kAsk ? asks_ : bids_;
+  for (const PriceLevel& level : levels) {
+    if (level.price == price) return level;
+  }
+  return PriceLevel{};
+}
+
+// MARK: GETSNAPSHOT
+const std::vector<BidAskPair> LevelBook::GetSnapshot(std::size_t level_count) const {
+  std::vector<BidAskPair> res;
+  res.reserve(level_count);
+  for (std::size_t i = 0; i < level_count; ++i) {
+    res.push_back({GetBidLevel(i), GetAskLevel(i)});
+  }
+  return res;
+}
+
+// MARK: Apply
+void LevelBook::Apply(const MarketLevelEvent& level) {
+  if (BT_UNLIKELY(level.depth >= kDepth || level.side == OrderSide::kNone)) return;
+  auto& levels = level.side == OrderSide::kAsk ? asks_ : bids_;
+  if (level.price == kUndefPrice) {
+    levels[level.depth] = {};
+  } else {
+    levels[level.depth] = {level.price, level.size, level.count};
+  }
+}
+
+void LevelBook::Clear() {
+  bids_.fill({});
+  asks_.fill({});
+}
+
+}  // namespace backtester
@@ -25,6 +25,14 @@ void MarketStateManager::OnMarketEvent(const MarketByOrderEvent& event) {
   GetOrCreateInstrumentState(event.instrument_id)->OnMarketEvent(event);
 }
 
+void MarketStateManager::OnBarEvent(const OhlcvBarEvent& bar) {
+  GetOrCreateInstrumentState(bar.instrument_id)->OnBarEvent(bar);
+}
+
+void MarketStateManager::OnLevelEvent(const MarketLevelEvent& level) {
+  GetOrCreateInstrumentState(level.instrument_id)->OnLevelEvent(level);
+}
+
 const BidAskPair MarketStateManager::GetInstrumentBbo(uint32_t instr_id) const {
   const auto& instr = GetInstrumentState(instr_id);
   if (instr != nullptr) {
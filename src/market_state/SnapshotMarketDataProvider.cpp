@@ -0,0 +1,164 @@
+#include "market_state/SnapshotMarketDataProvider.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+// Index of `price` in a ladder that starts at `best` and steps `step` per level, or -1 where
+// the book cannot have a level: an empty side, off the tick grid or better than the best.
+int64_t LadderIndex(int64_t best, int64_t price, int64_t step) {
+  if (best == kUndefPrice || step == 0) return -1;
+  const int64_t offset = price - best;
+  if (offset % step != 0) return -1;
+  const int64_t idx = offset / step;
+  if (idx < 0) return -1;
+  if (BT_UNLIKELY(idx >= static_cast<int64_t>(kFrameDepth))) {
+    throw std::runtime_error(fmt::format(
+        "Snapshot view: a depth query at {} is more than {} ticks from the best price {}; "
+        "run this backtest single or threaded",
+        price, kFrameDepth, best));
+  }
+  return idx;
+}
+
+// Same accumulation as InstrumentState's aggregation: the caller sets the prices, matching
+// levels add their size and count.
+void AddLadder(const std::array<LadderLevel, kFrameDepth>& ladder, uint16_t used, int64_t best,
+               int64_t step, std::span<PriceLevel> levels) {
+  for (auto& level : levels) {
+    const int64_t idx = LadderIndex(best, level.price, step);
+    if (idx < 0 || idx >= used) continue;
+    level.size += ladder[static_cast<size_t>(idx)].size;
+    level.count += ladder[static_cast<size_t>(idx)].count;
+  }
+}
+
+// Aggregates one side of a book into `ladder` through `aggregate`, one level per tick out from
+// `best`. Returns how many levels are used: up to the deepest one with size.
+template <class Aggregate>
+uint16_t CaptureLadder(int64_t best, int64_t step, Aggregate aggregate,
+                       std::array<LadderLevel, kFrameDepth>& ladder) {
+  if (best == kUndefPrice) return 0;
+  std::array<PriceLevel, kFrameDepth> levels;
+  for (size_t i = 0; i < kFrameDepth; ++i) {
+    levels[i].price = best + step * static_cast<int64_t>(i);
+  }
+  aggregate(std::span<PriceLevel>(levels));
+  size_t used = kFrameDepth;
+  while (used > 0 && levels[used - 1].size == 0 && levels[used - 1].count == 0) --used;
+  for (size_t i = 0; i < used; ++i) ladder[i] = {levels[i].size, levels[i].count};
+  return static_cast<uint16_t>(used);
+}
+
+}  // namespace
+
+SnapshotMarketDataProvider::SnapshotMarketDataProvider(
+    const std::vector<TradedInstrument>& traded) {
+  slots_.reserve(traded.size());
+  for (const auto& instr : traded) {
+    Slot& slot = slots_.emplace_back();
+    slot.instrument_id = instr.instrument_id;
+    slot.tick_size = instr.tick_size;
+    slot.state.snapshot.instrument_id = instr.instrument_id;
+  }
+  // Pointers into slots_ stay valid: it is never resized after this
+  for (const auto& slot : slots_) snapshots_[slot.instrument_id] = &slot.state.snapshot;
+}
+
+// MARK: Apply
+void SnapshotMarketDataProvider::Apply(const MarketFrame& frame) {
+  if (!frame.has_state) return;
+  const uint32_t id = MarketInstrumentId(frame.event);
+  for (auto& slot : slots_) {
+    if (slot.instrument_id == id) {
+      const InstrumentFrame& from = frame.state;
+      slot.state.snapshot = from.snapshot;
+      slot.state.bid_levels = from.bid_levels;
+      slot.state.ask_levels = from.ask_levels;
+      // Only the used prefix: past it both ladders are empty
+      std::copy_n(from.bids.begin(), from.bid_levels, slot.state.bids.begin());
+      std::copy_n(from.asks.begin(), from.ask_levels, slot.state.asks.begin());
+      return;
+    }
+  }
+}
+
+void SnapshotMarketDataProvider::Capture(const IMarketDataProvider& book, uint32_t instrument_id,
+                                         int64_t tick_size, InstrumentFrame& frame) {
+  frame.snapshot = *book.GetSnapshotByInstr(instrument_id);
+  frame.bid_levels = CaptureLadder(
+      frame.snapshot.bbo.bid.price, -tick_size,
+      [&](std::span<PriceLevel> levels) { book.GetAggOBBidsSnapshot(instrument_id, levels); },
+      frame.bids);
+  frame.ask_levels = CaptureLadder(
+      frame.snapshot.bbo.ask.price, tick_size,
+      [&](std::span<PriceLevel> levels) { book.GetAggOBAsksSnapshot(instrument_id, levels); },
+      frame.asks);
+}
+
+// MARK: Queries
+std::unordered_map<uint32_t, BidAskPair> SnapshotMarketDataProvider::GetTradedInstrsBbo() const {
+  std::unordered_map<uint32_t, BidAskPair> res;
+  for (const auto& slot : slots_) res[slot.instrument_id] = slot.state.snapshot.bbo;
+  return res;
+}
+
+const std::vector<BidAskPair> SnapshotMarketDataProvider::GetOBSnapshotByPub(
+    uint32_t /*instrument_id*/, uint16_t /*publisher_id*/, std::size_t /*level_count*/) const {
+  static const std::vector<BidAskPair> EMPTY_SNAPSHOT;
+  return EMPTY_SNAPSHOT;
+}
+
+int64_t SnapshotMarketDataProvider::GetQueueDepth(uint32_t instr_id, OrderSide side,
+                                                  int64_t price) const {
+  const Slot* slot = Find(instr_id);
+  if (!slot) {
+    spdlog::error("Tried to access unknown instrument with id: {}", instr_id);
+    return kUndefPrice;
+  }
+  const bool bid = side == OrderSide::kBid;
+  const auto& ladder = bid ? slot->state.bids : slot->state.asks;
+  const BidAskPair& bbo = slot->state.snapshot.bbo;
+  const int64_t best = bid ? bbo.bid.price : bbo.ask.price;
+  const int64_t step = bid ? -slot->tick_size : slot->tick_size;
+  const uint16_t used = bid ? slot->state.bid_levels : slot->state.ask_levels;
+  const int64_t idx = LadderIndex(best, price, step);
+  return (idx < 0 || idx >= used) ? 0 : ladder[static_cast<size_t>(idx)].size;
+}
+
+void SnapshotMarketDataProvider::GetAggOBBidsSnapshot(uint32_t instrument_id,
+                                                      std::span<PriceLevel> levels) const {
+  const Slot* slot = Find(instrument_id);
+  if (BT_UNLIKELY(!slot))
+    throw std::runtime_error(
+        fmt::format("GetAggOBBids tried to access an unknown instrument: {}", instrument_id));
+  AddLadder(slot->state.bids, slot->state.bid_levels, slot->state.snapshot.bbo.bid.price,
+            -slot->tick_size, levels);
+}
+
+void SnapshotMarketDataProvider::GetAggOBAsksSnapshot(uint32_t instrument_id,
+                                                      std::span<PriceLevel> levels) const {
+  const Slot* slot = Find(instrument_id);
+  if (BT_UNLIKELY(!slot))
+    throw std::runtime_error(
+        fmt::format("GetAggOBAsks tried to access an unknown instrument: {}", instrument_id));
+  AddLadder(slot->state.asks, slot->state.ask_levels, slot->state.snapshot.bbo.ask.price,
+            slot->tick_size, levels);
+}
+
+const MarketSnapshot* SnapshotMarketDataProvider::GetSnapshotByInstr(uint32_t instr_id) const {
+  const Slot* slot = Find(instr_id);
+  if (BT_UNLIKELY(!slot)) {
+    throw std::runtime_error(
+        fmt::format("GetSnapshotByInstr in snapshot view "
+                    "tried to find an unknown instrument: {}",
+                    instr_id));
+  }
+  return &slot->state.snapshot;
+}
+
+}  // namespace backtester
@@ -53,6 +53,11 @@ void ReportGenerator::RecordEquitySnapshot(uint64_t timestamp, int64_t equity, i
 
 void ReportGenerator::GenerateReport(const PortfolioManager& portfolio,
                                      std::vector<std::string> names) {
+  GenerateReport(portfolio.GetTradeHistory(), std::move(names));
+}
+
+void ReportGenerator::GenerateReport(const std::vector<TradeRecord>& trades,
+                                     std::vector<std::string> names) {
   spdlog::info("ReportGenerator: Computing performance metrics...");
 
   std::string output_dir = config_.report_output_dir;
@@ -61,17 +66,17 @@ void ReportGenerator::GenerateReport(const PortfolioManager& portfolio,
   }
 
   // 1. Overall summary
-  PerformanceSummary summary = ComputeSummary(portfolio);
+  PerformanceSummary summary = ComputeSummary(trades);
   WriteSummaryCsv(output_dir + "/summary.csv", summary);
 
   // 2. Trade log
-  WriteTradeLogCsv(output_dir + "/trade_log.csv", portfolio.GetTradeHistory(), names);
+  WriteTradeLogCsv(output_dir + "/trade_log.csv", trades, names);
 
   // 3. Equity curve
   WriteEquityCurveCsv(output_dir + "/equity_curve.csv");
 
   // 4. Per-strategy breakdown
-  auto breakdowns = ComputePerStrategySummary(portfolio, names);
+  auto breakdowns = ComputePerStrategySummary(trades, names);
   if (breakdowns.size() > 1) {
     WritePerStrategyBreakdownCsv(output_dir + "/strategy_breakdown.csv", breakdowns);
   }
@@ -82,15 +87,14 @@ void ReportGenerator::GenerateReport(const PortfolioManager& portfolio,
       "Sharpe={:.3f} | MaxDD={:.2f}% | Trades={}",
       FormatScaledPrice(summary.total_pnl), summary.total_return_pct * 100.0, summary.sharpe_ratio,
       summary.max_drawdown_pct * 100.0, summary.total_trades);
+  summary_ = summary;
 }
 
 // =============================================================================
 // MARK: Summary Computation
 // =============================================================================
 
-PerformanceSummary ReportGenerator::ComputeSummary(const PortfolioManager& portfolio) const {
-  const auto& trades = portfolio.GetTradeHistory();
-
+PerformanceSummary ReportGenerator::ComputeSummary(const std::vector<TradeRecord>& trades) const {
   money_t final_equity = config_.initial_cash;
   if (!equity_curve_.empty()) {
     final_equity = equity_curve_.back().equity;
@@ -280,9 +284,7 @@ PerformanceSummary ReportGenerator::ComputeSummaryFromTrades(const std::vector<T
 // =============================================================================
 
 std::unordered_map<std::string, PerformanceSummary> ReportGenerator::ComputePerStrategySummary(
-    const PortfolioManager& portfolio, const std::vector<std::string>& names) const {
-  const auto& all_trades = portfolio.GetTradeHistory();
-
+    const std::vector<TradeRecord>& all_trades, const std::vector<std::string>& names) const {
   // Group trades by strategy_id
   std::unordered_map<std::string, std::vector<TradeRecord>> by_strategy;
   for (const auto& trade : all_trades) {
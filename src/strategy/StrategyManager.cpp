@@ -47,6 +47,18 @@ std::vector<EventUnion>& StrategyManager::OnMarketEvent(const MarketByOrderEvent
   return collected_signals_;
 }
 
+std::vector<EventUnion>& StrategyManager::OnBarEvent(const OhlcvBarEvent& bar) {
+  collected_signals_.clear();
+
+  for (auto& strategy : active_strategies_) {
+    for (auto& signal : strategy->OnBarEvent(bar)) {
+      collected_signals_.push_back(EventUnion{.strat_signal_ev = signal});
+    }
+  }
+
+  return collected_signals_;
+}
+
 void StrategyManager::OnFillEvent(const StrategyFillEvent& fill) {
   for (auto& strategy : active_strategies_) {
     if (strategy->GetIndex() == fill.strategy_id) {
@@ -58,24 +58,15 @@ class MovAvgCross : public IStrategy {
   }
 
   virtual std::vector<StrategySignalEvent> OnMarketEvent(const MarketByOrderEvent& event) override {
-    signals_.clear();
     if (event.header.type != EventType::kMarketTrade || event.instrument_id != traded_instr_)
       return {};
+    return OnPrice(event.price, event.header.timestamp);
+  }
 
-    current_price_ = event.price;
-    const bool sampled = SamplePrice(event.header.timestamp);
-
-    if (!pending_order_ && !cur_pos_.IsFlat()) {
-      CheckExit(event.header.timestamp);
-      return signals_;
-    }
-
-    if (!sampled || pending_order_ || static_cast<int64_t>(price_history_.size()) < slow_window_) {
-      return {};
-    }
-
-    CheckCrossoverEntry(event.header.timestamp);
-    return signals_;
+  // Bar closes feed the same sampler as trades, so the strategy runs unchanged on OHLCV.
+  virtual std::vector<StrategySignalEvent> OnBarEvent(const OhlcvBarEvent& bar) override {
+    if (bar.instrument_id != traded_instr_) return {};
+    return OnPrice(bar.close, bar.header.timestamp);
   }
 
   virtual void OnFill(const StrategyFillEvent& fill) override {
@@ -139,6 +130,24 @@ class MovAvgCross : public IStrategy {
   int64_t fast_window_;
   CrossType last_cross_ = CrossType::kNone;
 
+  std::vector<StrategySignalEvent> OnPrice(int64_t price, uint64_t ts) {
+    signals_.clear();
+    current_price_ = price;
+    const bool sampled = SamplePrice(ts);
+
+    if (!pending_order_ && !cur_pos_.IsFlat()) {
+      CheckExit(ts);
+      return signals_;
+    }
+
+    if (!sampled || pending_order_ || static_cast<int64_t>(price_history_.size()) < slow_window_) {
+      return {};
+    }
+
+    CheckCrossoverEntry(ts);
+    return signals_;
+  }
+
   bool SamplePrice(uint64_t ts) {
     if (last_sample_ts_ != 0 && ts - last_sample_ts_ < kSampleIntervalNs) {
       return false;
@@ -0,0 +1,97 @@
+#include "utils/SimdScan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BT_SCAN_X86 1
+#endif
+
+namespace backtester {
+
+namespace simd_scan {
+
+namespace {
+
+inline void EnsureCapacity(size_t len, std::vector<uint32_t>& out) {
+  if (out.size() < len + 64) out.resize(len + 64);
+}
+
+inline size_t ScanTail(const char* data, size_t begin, size_t len, uint32_t* out, size_t n) {
+  for (size_t i = begin; i < len; ++i) {
+    const char c = data[i];
+    if (c == ',' || c == '\n') out[n++] = static_cast<uint32_t>(i);
+  }
+  return n;
+}
+
+#ifdef BT_SCAN_X86
+inline size_t EmitBits(uint32_t mask, uint32_t base, uint32_t* out, size_t n) {
+  while (mask) {
+    out[n++] = base + static_cast<uint32_t>(__builtin_ctz(mask));
+    mask &= mask - 1;
+  }
+  return n;
+}
+
+size_t ScanSse2(const char* data, size_t len, uint32_t* out) {
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i newline = _mm_set1_epi8('\n');
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline));
+    n = EmitBits(static_cast<uint32_t>(_mm_movemask_epi8(hits)), static_cast<uint32_t>(i), out,
+                 n);
+  }
+  return ScanTail(data, i, len, out, n);
+}
+
+__attribute__((target("avx2"))) size_t ScanAvx2(const char* data, size_t len, uint32_t* out) {
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i hits =
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, newline));
+    n = EmitBits(static_cast<uint32_t>(_mm256_movemask_epi8(hits)), static_cast<uint32_t>(i),
+                 out, n);
+  }
+  return ScanTail(data, i, len, out, n);
+}
+
+bool HasAvx2() {
+  static const bool has = __builtin_cpu_supports("avx2");
+  return has;
+}
+#endif
+
+}  // namespace
+
+size_t FindCsvDelimiters(const char* data, size_t len, std::vector<uint32_t>& out) {
+  EnsureCapacity(len, out);
+#ifdef BT_SCAN_X86
+  if (HasAvx2()) return ScanAvx2(data, len, out.data());
+  return ScanSse2(data, len, out.data());
+#else
+  return ScanTail(data, 0, len, out.data(), 0);
+#endif
+}
+
+size_t FindCsvDelimitersScalar(const char* data, size_t len, std::vector<uint32_t>& out) {
+  EnsureCapacity(len, out);
+  return ScanTail(data, 0, len, out.data(), 0);
+}
+
+const char* ActiveIsa() {
+#ifdef BT_SCAN_X86
+  return HasAvx2() ? "avx2" : "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace simd_scan
+
+}  // namespace backtester
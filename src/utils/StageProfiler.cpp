@@ -0,0 +1,160 @@
+#include "utils/StageProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+#include "spdlog/spdlog.h"
+
+namespace backtester {
+
+namespace {
+
+struct ClockPoint {
+  uint64_t ticks;
+  std::chrono::steady_clock::time_point time;
+};
+
+ClockPoint ClockNow() { return {StageClock(), std::chrono::steady_clock::now()}; }
+
+const ClockPoint kClockOrigin = ClockNow();
+
+// Profiles of threads that have exited, waiting for the next report
+std::mutex& ExitedMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+StageProfiler& Exited() {
+  static auto* exited = new StageProfiler();  // outlives threads exiting during shutdown
+  return *exited;
+}
+
+struct ThreadProfile {
+  std::unique_ptr<StageProfiler> profile = std::make_unique<StageProfiler>();
+  ~ThreadProfile() {
+    const std::lock_guard lock(ExitedMutex());
+    Exited().Merge(*profile);
+  }
+};
+
+}  // namespace
+
+const char* StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kRead:
+      return "read";
+    case Stage::kParse:
+      return "parse";
+    case Stage::kMerge:
+      return "merge";
+    case Stage::kRingWait:
+      return "ring wait";
+    case Stage::kBookApply:
+      return "book apply";
+    case Stage::kStrategy:
+      return "strategy";
+    case Stage::kFillModel:
+      return "fill model";
+    case Stage::kPortfolio:
+      return "portfolio";
+    case Stage::kSnapshot:
+      return "snapshot";
+    case Stage::kCount:
+      break;
+  }
+  return "?";
+}
+
+// MARK: Histogram
+uint64_t LatencyHistogram::BucketLowest(size_t bucket) {
+  const size_t group = bucket / kSubBuckets;
+  const uint64_t sub = bucket % kSubBuckets;
+  if (group == 0) return sub;
+  return (kSubBuckets + sub) << (group - 1);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t b = 0; b < kBucketCount; ++b) counts_[b] += other.counts_[b];
+  count_ += other.count_;
+  total_ += other.total_;
+  max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::ValueAtQuantile(double q) const {
+  if (count_ == 0) return 0;
+  const double clamped = std::clamp(q, 0.0, 1.0);
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t b = 0; b < kBucketCount; ++b) {
+    seen += counts_[b];
+    if (seen >= rank) {
+      const uint64_t highest = b + 1 < kBucketCount ? BucketLowest(b + 1) - 1 : kMaxValue;
+      return std::min(highest, max_);
+    }
+  }
+  return max_;
+}
+
+// MARK: Profiler
+StageProfiler& StageProfiler::ThisThread() {
+  thread_local ThreadProfile thread_profile;
+  return *thread_profile.profile;
+}
+
+void StageProfiler::Merge(const StageProfiler& other) {
+  for (size_t s = 0; s < histograms_.size(); ++s) histograms_[s].Merge(other.histograms_[s]);
+}
+
+void StageProfiler::Reset() {
+  for (auto& histogram : histograms_) histogram.Reset();
+}
+
+double StageProfiler::TicksPerNs() {
+  const ClockPoint now = ClockNow();
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time - kClockOrigin.time);
+  if (ns.count() <= 0) return 1.0;
+  return static_cast<double>(now.ticks - kClockOrigin.ticks) / static_cast<double>(ns.count());
+}
+
+std::string StageProfiler::Format(double ticks_per_ns) const {
+  uint64_t all_ticks = 0;
+  for (const auto& histogram : histograms_) all_ticks += histogram.Total();
+
+  auto ns = [&](uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_ns; };
+  std::string out = fmt::format("{:<11}{:>12}{:>11}{:>8}{:>9}{:>9}{:>9}{:>9}{:>10}{:>11}\n",
+                                "stage", "count", "total ms", "share", "mean", "p50", "p90",
+                                "p99", "p99.9", "max");
+  for (size_t s = 0; s < histograms_.size(); ++s) {
+    const LatencyHistogram& h = histograms_[s];
+    if (h.Count() == 0) continue;
+    out += fmt::format(
+        "{:<11}{:>12}{:>11.1f}{:>7.1f}%{:>9.0f}{:>9.0f}{:>9.0f}{:>9.0f}{:>10.0f}{:>11.0f}\n",
+        StageName(static_cast<Stage>(s)), h.Count(), ns(h.Total()) / 1e6,
+        all_ticks ? 100.0 * static_cast<double>(h.Total()) / static_cast<double>(all_ticks) : 0.0,
+        ns(h.Total()) / static_cast<double>(h.Count()), ns(h.ValueAtQuantile(0.5)),
+        ns(h.ValueAtQuantile(0.9)), ns(h.ValueAtQuantile(0.99)), ns(h.ValueAtQuantile(0.999)),
+        ns(h.Max()));
+  }
+  return out;
+}
+
+void StageProfiler::LogAndReset() {
+  StageProfiler& mine = ThisThread();
+  // Heap: a profile is ~100 KB of buckets
+  auto merged = std::make_unique<StageProfiler>();
+  {
+    const std::lock_guard lock(ExitedMutex());
+    merged->Merge(Exited());
+    Exited().Reset();
+  }
+  merged->Merge(mine);
+  mine.Reset();
+  spdlog::info("Stage profile (exclusive time in ns, share of all profiled time summed over "
+               "threads):\n{}",
+               merged->Format(TicksPerNs()));
+}
+
+}  // namespace backtester
@@ -0,0 +1,47 @@
+#pragma once
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace backtester {
+
+// Fixture base for tests that write files: paths are named after the running test under the
+// system temp directory, so tests never collide, and whatever was handed out is removed on
+// teardown.
+class TempPathTest : public ::testing::Test {
+ protected:
+  explicit TempPathTest(std::string prefix) : prefix_(std::move(prefix)) {}
+
+  // <temp>/<prefix>_<test name><suffix>
+  std::filesystem::path TempPath(const std::string& suffix = "") {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    auto path = std::filesystem::temp_directory_path() /
+                (prefix_ + "_" + std::string(info ? info->name() : "x") + suffix);
+    created_.push_back(path);
+    return path;
+  }
+
+  // TempPath() as a fresh, empty directory
+  std::filesystem::path TempDir() {
+    auto dir = TempPath();
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir);
+    return dir;
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    for (const auto& path : created_) std::filesystem::remove_all(path, ec);
+  }
+
+ private:
+  std::string prefix_;
+  std::vector<std::filesystem::path> created_;
+};
+
+}  // namespace backtester
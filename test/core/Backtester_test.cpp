@@ -0,0 +1,387 @@
+#include "core/Backtester.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "core/ConfigParser.h"
+#include "core/ParameterSweep.h"
+#include "strategy/StrategyRegistry.h"
+
+namespace backtester {
+
+namespace {
+
+constexpr uint32_t kInstruments[] = {1001, 1002, 1003};
+constexpr int64_t kTick = 250'000'000;  // 0.25 in fixpntint
+constexpr uint64_t kDayStart = 1'641'168'000'000'000'000ULL;  // 2022-01-03T00:00:00Z
+
+// Random MBO traffic around a slowly drifting mid per instrument: adds 1-20 ticks off the mid,
+// cancels, and trades against the touch, so a market maker quoting near the BBO gets filled.
+std::string MboFixture(size_t steps, bool duplicate_add = false) {
+  struct Order {
+    char side;
+    int64_t price;
+    uint32_t size;
+  };
+  struct Book {
+    int64_t mid;
+    std::unordered_map<uint64_t, Order> orders;
+    std::vector<uint64_t> ids;  // same orders, for picking one at random
+  };
+  std::mt19937_64 rng(7);
+  auto below = [&](uint64_t n) { return rng() % n; };
+
+  std::unordered_map<uint32_t, Book> books;
+  for (size_t k = 0; k < std::size(kInstruments); ++k) {
+    books[kInstruments[k]].mid = 4'000'000'000'000 + static_cast<int64_t>(k) * 100'000'000'000;
+  }
+
+  std::ostringstream csv;
+  csv << "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,channel_id,"
+         "order_id,flags,ts_in_delta,sequence,symbol\n";
+  uint64_t ts = kDayStart + 3'600'000'000'000ULL;
+  uint64_t sequence = 0;
+  uint64_t next_id = 1;
+  auto row = [&](uint32_t instr, char action, char side, int64_t price, uint32_t size,
+                 uint64_t id) {
+    csv << ts + 100 << ',' << ts << ",160,1," << instr << ',' << action << ',' << side << ','
+        << price << ',' << size << ",0," << id << ",128,0," << ++sequence << ",X\n";
+  };
+  auto remove = [](Book& book, size_t at) {
+    book.orders.erase(book.ids[at]);
+    book.ids[at] = book.ids.back();
+    book.ids.pop_back();
+  };
+
+  for (size_t step = 0; step < steps; ++step) {
+    ts += (1 + below(300)) * 1'000'000;
+    const uint32_t instr = kInstruments[below(std::size(kInstruments))];
+    Book& book = books[instr];
+    if (below(500) == 0) book.mid += below(2) ? kTick : -kTick;
+
+    const uint64_t r = below(10);
+    if (r < 5 || book.ids.size() < 10) {
+      const char side = below(2) ? 'A' : 'B';
+      const int64_t offset = static_cast<int64_t>(1 + below(20)) * kTick;
+      const Order order{side, side == 'A' ? book.mid + offset : book.mid - offset,
+                        static_cast<uint32_t>(1 + below(20))};
+      book.orders[next_id] = order;
+      book.ids.push_back(next_id);
+      row(instr, 'A', order.side, order.price, order.size, next_id++);
+    } else if (r < 9) {
+      const size_t at = below(book.ids.size());
+      const Order order = book.orders[book.ids[at]];
+      row(instr, 'C', order.side, order.price, order.size, book.ids[at]);
+      remove(book, at);
+    } else {
+      const char side = below(2) ? 'A' : 'B';  // resting side taken out at the touch
+      size_t best = book.ids.size();
+      for (size_t i = 0; i < book.ids.size(); ++i) {
+        const Order& o = book.orders[book.ids[i]];
+        if (o.side != side) continue;
+        const Order* b = best < book.ids.size() ? &book.orders[book.ids[best]] : nullptr;
+        if (!b || (side == 'A' ? o.price < b->price : o.price > b->price)) best = i;
+      }
+      if (best == book.ids.size()) continue;
+      Order& resting = book.orders[book.ids[best]];
+      const auto qty = static_cast<uint32_t>(1 + below(resting.size));
+      row(instr, 'T', side == 'A' ? 'B' : 'A', resting.price, qty, 0);
+      row(instr, 'F', side, resting.price, qty, book.ids[best]);
+      if (qty == resting.size) {
+        row(instr, 'C', side, resting.price, qty, book.ids[best]);
+        remove(book, best);
+      } else {
+        resting.size -= qty;
+      }
+    }
+  }
+  if (duplicate_add) {  // the book refuses an order id it already holds
+    const Book& book = books[kInstruments[0]];
+    ts += 1'000'000;
+    row(kInstruments[0], 'A', 'B', book.mid - kTick, 1, book.ids.front());
+  }
+  return csv.str();
+}
+
+// Works the book far from the touch, where a frame ladder too short would answer wrong: every
+// kIntervalNs it either sweeps kSweepTicks through the opposite side or rests kRestTicks (or
+// params[0]) behind its own best, so fills depend on deep book walks and deep queue positions.
+class DeepBookProbe : public IStrategy {
+ public:
+  static constexpr uint64_t kIntervalNs = 20'000'000'000;
+  static constexpr int64_t kSweepTicks = 30;
+  static constexpr int64_t kRestTicks = 25;
+  static constexpr qty_t kSweepQty = 400;
+
+  DeepBookProbe(const std::string& strategy_id, const IMarketDataProvider& market_data)
+      : IStrategy(strategy_id, market_data) {}
+
+  void Initialize(const Strategy& config) override {
+    instr_ = config.traded_instr_id;
+    tick_ = config.instr_tick_size;
+    if (!config.params.empty()) rest_ticks_ = config.params[0];
+  }
+
+  std::vector<StrategySignalEvent> OnMarketEvent(const MarketByOrderEvent& event) override {
+    if (event.instrument_id != instr_ || event.header.timestamp < next_ts_) return {};
+    const BidAskPair bbo = market_data_.GetSnapshotByInstr(instr_)->bbo;
+    if (bbo.bid.price == kUndefPrice || bbo.ask.price == kUndefPrice) return {};
+    next_ts_ = event.header.timestamp + kIntervalNs;
+
+    const uint64_t ts = event.header.timestamp;
+    switch (step_++ % 4) {
+      case 0:
+        return {MakeSignal(SignalType::kBuySignal, instr_, bbo.ask.price + kSweepTicks * tick_,
+                           kSweepQty, ts)};
+      case 1:
+        return {MakeSignal(SignalType::kSellSignal, instr_, bbo.bid.price - kSweepTicks * tick_,
+                           kSweepQty, ts)};
+      case 2:
+        return {MakeSignal(SignalType::kBuySignal, instr_, bbo.bid.price - rest_ticks_ * tick_, 1,
+                           ts)};
+      default:
+        return {MakeSignal(SignalType::kSellSignal, instr_, bbo.ask.price + rest_ticks_ * tick_, 1,
+                           ts)};
+    }
+  }
+
+  void OnFill(const StrategyFillEvent& /*fill*/) override {}
+  void OnRejection(const StrategyOrderRejectionEvent& /*msg*/) override {}
+  void OnEndOfDay(uint64_t /*timestamp*/) override {}
+
+ private:
+  uint32_t instr_ = 0;
+  int64_t tick_ = 0;
+  uint64_t next_ts_ = 0;
+  uint64_t step_ = 0;
+  int64_t rest_ticks_ = kRestTicks;
+};
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+REGISTER_STRATEGY(DeepBookProbe, "DeepBookProbe")
+
+// Whole backtests over a small multi-instrument MBO file, one market maker per instrument
+class BacktesterTest : public TempPathTest {
+ protected:
+  BacktesterTest() : TempPathTest("backtester") {}
+
+  void SetUp() override {
+    dir_ = TempDir();
+    std::ofstream(dir_ / "symbology.csv") << "raw_symbol,instrument_id,date\n"
+                                             "S1001,1001,2022-01-03\n"
+                                             "S1002,1002,2022-01-03\n"
+                                             "S1003,1003,2022-01-03\n";
+  }
+
+  void WriteData(const std::string& csv) { std::ofstream(dir_ / "data.csv") << csv; }
+
+  // One market maker per instrument, plus a DeepBookProbe per instrument when `deep`
+  AppConfig Config(const std::string& run, bool deep = false) const {
+    nlohmann::json strategies = nlohmann::json::array();
+    nlohmann::json traded = nlohmann::json::array();
+    for (const uint32_t id : kInstruments) {
+      strategies.push_back({{"name", "SimpleMarketMaker"},
+                            {"params", {1, 1, 5, 1}},
+                            {"traded_instr_id", id},
+                            {"max_lob_lvl", 1}});
+      if (deep) {
+        strategies.push_back(
+            {{"name", "DeepBookProbe"}, {"params", {DeepBookProbe::kRestTicks}},
+             {"traded_instr_id", id}, {"max_lob_lvl", 1}});
+      }
+      traded.push_back({{"instrument_id", id},
+                        {"instrument_type", "FUT"},
+                        {"tick_size", 0.25},
+                        {"tick_value", 12.5},
+                        {"init_margin_req", 100},
+                        {"main_margin_req", 100}});
+    }
+    const nlohmann::json j = {
+        {"start_time", "2022-01-03T00:00:00Z"},
+        {"initial_cash", deep ? 100'000'000 : 100'000},  // room for the probes' sweeps
+        {"end_time", "2022-01-03T23:00:00Z"},
+        {"report_output_dir", (dir_ / run).string()},
+        {"strategies", strategies},
+        {"traded_instruments", traded},
+        {"risk_limits",
+         {{"risk_mode", "PosSizeInDollars"},
+          {"max_position_size", deep ? 0 : 10},
+          {"max_drawdown_pct", 0.9}}},
+        {"data_streams",
+         {{{"data_source_name", "S0"},
+           {"symbology_filepath", (dir_ / "symbology.csv").string()},
+           {"data_filepath", (dir_ / "data.csv").string()},
+           {"encoding", "CSV"},
+           {"schema", "MBO"},
+           {"compression", "NONE"},
+           {"price_format", "fixpntint"},
+           {"timestamp_format", "unix"}}}}};
+    AppConfig config = ParseConfigFromJson(j, dir_ / "config.json");
+    config.ring_wait = WaitPolicy::PARK;  // the pipeline's threads may share one core
+    return config;
+  }
+
+  // Builds the stack the way main does and runs it single threaded or pipelined
+  static void Run(const AppConfig& config, bool pipelined) {
+    EventQueue event_queue;
+    DataReaderManager data_reader_manager;
+    ASSERT_TRUE(data_reader_manager.RegisterAndInitStreams(config.data_configs, config.start_time));
+    MarketStateManager market_state_manager;
+    market_state_manager.Initialize(config.active_instruments);
+    SnapshotMarketDataProvider frame_view(config.traded_instruments);
+    const IMarketDataProvider& market =
+        pipelined ? static_cast<const IMarketDataProvider&>(frame_view) : market_state_manager;
+
+    PortfolioManager portfolio_manager(config, market);
+    ReportGenerator report_generator(config);
+    ExecutionHandler execution_handler(event_queue, config, market);
+    StrategyManager strategy_manager(config);
+    strategy_manager.InitializeStrategies(market);
+    auto backtester = std::make_unique<Backtester>(event_queue, data_reader_manager,
+                                                   market_state_manager, portfolio_manager,
+                                                   report_generator, execution_handler,
+                                                   strategy_manager, config);
+    if (pipelined) {
+      backtester->RunLoopPipelined(frame_view);
+    } else {
+      backtester->RunLoopSingleThreaded();
+    }
+  }
+
+  // The most ticks one DeepBookProbe order filled across, from the trade log
+  static int64_t WidestSweepTicks(const std::string& trade_log) {
+    std::unordered_map<std::string, std::pair<double, double>> spans;  // ts,instr -> low,high
+    std::istringstream in(trade_log);
+    std::string line;
+    while (std::getline(in, line)) {
+      std::vector<std::string> fields;
+      std::istringstream row(line);
+      for (std::string field; std::getline(row, field, ',');) fields.push_back(field);
+      if (fields.size() < 5 || fields[1] != "DeepBookProbe") continue;
+      const double price = std::stod(fields[4]);
+      const auto [it, added] = spans.try_emplace(fields[0] + fields[2], price, price);
+      it->second = {std::min(it->second.first, price), std::max(it->second.second, price)};
+    }
+    int64_t widest = 0;
+    for (const auto& [key, span] : spans) {
+      widest = std::max(widest, static_cast<int64_t>((span.second - span.first) / 0.25));
+    }
+    return widest;
+  }
+
+  std::filesystem::path dir_;
+};
+
+TEST_F(BacktesterTest, PipelinedTradeLogMatchesSingle) {
+  WriteData(MboFixture(30'000));
+  Run(Config("single"), false);
+  Run(Config("pipelined"), true);
+
+  const std::string single = ReadFile(dir_ / "single" / "trade_log.csv");
+  const auto lines = std::count(single.begin(), single.end(), '\n');
+  EXPECT_GT(lines, 10) << "the fixture should make the market makers trade";
+  EXPECT_EQ(ReadFile(dir_ / "pipelined" / "trade_log.csv"), single);
+}
+
+// Orders sweeping and resting more than 16 ticks from the touch fill as they do against the book
+TEST_F(BacktesterTest, PipelinedDeepBookTradeLogsMatchSingle) {
+  WriteData(MboFixture(30'000));
+  Run(Config("single", true), false);
+  const std::string single = ReadFile(dir_ / "single" / "trade_log.csv");
+  EXPECT_GT(WidestSweepTicks(single), 16) << "the probes should walk past 16 ticks";
+
+  for (const uint32_t shards : {1u, 2u, 3u}) {
+    SCOPED_TRACE(shards);
+    const std::string run = "shards_" + std::to_string(shards);
+    AppConfig config = Config(run, true);
+    config.book_shards = shards;
+    Run(config, true);
+    EXPECT_EQ(ReadFile(dir_ / run / "trade_log.csv"), single);
+  }
+}
+
+// A queue position further out than a frame reaches stops the run instead of reading as empty
+TEST_F(BacktesterTest, PipelinedQueryPastTheLadderWritesNoReport) {
+  WriteData(MboFixture(30'000));
+  auto resting_past_ladder = [&](const std::string& run) {
+    AppConfig config = Config(run, true);
+    for (auto& strategy : config.strategies) {
+      if (strategy.name == "DeepBookProbe") strategy.params = {static_cast<int>(kFrameDepth) + 10};
+    }
+    return config;
+  };
+  Run(resting_past_ladder("single"), false);
+  EXPECT_TRUE(std::filesystem::exists(dir_ / "single" / "trade_log.csv"));
+
+  for (const uint32_t shards : {1u, 2u}) {
+    SCOPED_TRACE(shards);
+    const std::string run = "shards_" + std::to_string(shards);
+    AppConfig config = resting_past_ladder(run);
+    config.book_shards = shards;
+    EXPECT_THROW(Run(config, true), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(dir_ / run));
+  }
+}
+
+// Replicas behind one book fill as runs with books of their own, and a combination resting past
+// the ladder fails rather than report different fills
+TEST_F(BacktesterTest, SharedBookSweepMatchesOwnBooks) {
+  WriteData(MboFixture(30'000));
+  auto sweep = [&](const std::string& run, bool share_book) {
+    AppConfig config = Config(run, true);
+    const int past_ladder = static_cast<int>(kFrameDepth) + 10;
+    config.sweep.axes = {{1, 0, {DeepBookProbe::kRestTicks, 40, past_ladder}}};
+    config.sweep.threads = 3;
+    config.sweep.share_book = share_book;
+    ParameterSweep sweep(config);
+    const bool ok = sweep.Run();
+    return std::make_pair(ok, sweep.Results());
+  };
+  const auto [own_ok, own] = sweep("own", false);
+  const auto [shared_ok, shared] = sweep("shared", true);
+  EXPECT_TRUE(own_ok);
+  EXPECT_FALSE(shared_ok);
+  ASSERT_EQ(own.size(), 3u);
+  ASSERT_EQ(shared.size(), 3u);
+  for (size_t i = 0; i < 2; ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_TRUE(shared[i].ok);
+    EXPECT_EQ(ReadFile(std::filesystem::path(shared[i].report_dir) / "trade_log.csv"),
+              ReadFile(std::filesystem::path(own[i].report_dir) / "trade_log.csv"));
+  }
+  EXPECT_TRUE(own[2].ok);
+  EXPECT_FALSE(shared[2].ok);
+}
+
+TEST_F(BacktesterTest, PipelinedBookFailureWritesNoReport) {
+  WriteData(MboFixture(2'000, true));
+  for (const uint32_t shards : {1u, 2u}) {
+    SCOPED_TRACE(shards);
+    AppConfig config = Config("shards_" + std::to_string(shards));
+    config.book_shards = shards;
+    EXPECT_THROW(Run(config, true), std::invalid_argument);
+    EXPECT_FALSE(std::filesystem::exists(dir_ / ("shards_" + std::to_string(shards))));
+  }
+}
+
+}  // namespace backtester
@@ -0,0 +1,146 @@
+#include "core/BroadcastRing.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace backtester {
+namespace {
+
+//////////////////////////////////////////////////////////
+// MARK: Single-threaded
+//////////////////////////////////////////////////////////
+
+TEST(BroadcastRingTest, EveryReaderSeesEveryItem) {
+  BroadcastRing<uint64_t, 4> ring(2);
+  for (uint64_t v = 1; v <= 3; ++v) {
+    uint64_t* slot = ring.PrepareWrite();
+    ASSERT_NE(slot, nullptr);
+    *slot = v;
+    ring.CommitWrite();
+  }
+  for (size_t r = 0; r < 2; ++r) {
+    for (uint64_t v = 1; v <= 3; ++v) {
+      const uint64_t* item = ring.PeekRead(r);
+      ASSERT_NE(item, nullptr);
+      EXPECT_EQ(*item, v);
+      ring.CommitRead(r);
+    }
+    EXPECT_EQ(ring.PeekRead(r), nullptr);
+  }
+}
+
+TEST(BroadcastRingTest, SlowestReaderHoldsTheProducerUntilItDetaches) {
+  BroadcastRing<uint64_t, 4> ring(2);
+  for (uint64_t v = 0; v < 4; ++v) {
+    uint64_t* slot = ring.PrepareWrite();
+    ASSERT_NE(slot, nullptr);
+    *slot = v;
+    ring.CommitWrite();
+  }
+  // reader 0 drains, reader 1 has not read anything: still full
+  while (ring.PeekRead(0)) ring.CommitRead(0);
+  EXPECT_EQ(ring.PrepareWrite(), nullptr);
+
+  ring.Detach(1);
+  EXPECT_NE(ring.PrepareWrite(), nullptr);
+  EXPECT_FALSE(ring.Abandoned());
+  ring.Detach(0);
+  EXPECT_TRUE(ring.Abandoned());
+}
+
+TEST(BroadcastRingTest, ProducerIsRefusedOnceEveryReaderDetached) {
+  BroadcastRing<uint64_t, 4> ring(2);
+  ring.Detach(0);
+  ring.Detach(1);
+  // Within one ring of writes the producer sees a full ring, and then Abandoned
+  size_t written = 0;
+  while (uint64_t* slot = ring.PrepareWrite()) {
+    *slot = written;
+    ring.CommitWrite();
+    ASSERT_LE(++written, 4u);
+  }
+  EXPECT_TRUE(ring.Abandoned());
+  EXPECT_EQ(ring.PrepareWrite(), nullptr);
+}
+
+TEST(BroadcastRingTest, WaitReadEndsAfterCloseAndDrain) {
+  BroadcastRing<uint64_t, 4> ring(1);
+  uint64_t* slot = ring.PrepareWrite();
+  ASSERT_NE(slot, nullptr);
+  *slot = 7;
+  ring.CommitWrite();
+  ring.Close();
+  const uint64_t* item = ring.WaitRead(0);
+  ASSERT_NE(item, nullptr);
+  EXPECT_EQ(*item, 7u);
+  ring.CommitRead(0);
+  EXPECT_EQ(ring.WaitRead(0), nullptr);
+}
+
+//////////////////////////////////////////////////////////
+// MARK: Multi-threaded
+//////////////////////////////////////////////////////////
+
+// Parked readers and producer: spinning ones would take each other's core on a small machine
+template <size_t Capacity>
+void ExpectEveryReaderSeesTheSequence(uint64_t items, size_t reader_count) {
+  BroadcastRing<uint64_t, Capacity> ring(reader_count, WaitPolicy::PARK);
+
+  std::vector<uint64_t> sums(reader_count, 0);
+  std::vector<uint8_t> ordered(reader_count, 1);
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < reader_count; ++r) {
+    readers.emplace_back([&, r]() {
+      uint64_t expected = 0;
+      while (const uint64_t* item = ring.WaitRead(r)) {
+        if (*item != expected++) ordered[r] = 0;
+        sums[r] += *item;
+        ring.CommitRead(r);
+      }
+    });
+  }
+  for (uint64_t v = 0; v < items; ++v) {
+    uint64_t* slot = ring.WaitWrite();
+    ASSERT_NE(slot, nullptr);
+    *slot = v;
+    ring.CommitWrite();
+  }
+  ring.Close();
+  for (auto& t : readers) t.join();
+
+  for (size_t r = 0; r < reader_count; ++r) {
+    EXPECT_TRUE(ordered[r]) << "reader " << r;
+    EXPECT_EQ(sums[r], items * (items - 1) / 2) << "reader " << r;
+  }
+}
+
+TEST(BroadcastRingTest, ReadersOnTheirOwnThreadsSeeTheWholeSequence) {
+  ExpectEveryReaderSeesTheSequence<64>(100'000, 3);
+}
+
+TEST(BroadcastRingTest, ParkedReadersWakeWhenTheRingFillsBeforeAWakeBatch) {
+  // Fewer slots than RingWaiter::kWakeBatch: only the full-ring and empty-ring wakes get either
+  // side going
+  ExpectEveryReaderSeesTheSequence<4>(10'000, 2);
+}
+
+TEST(BroadcastRingTest, ParkedProducerWakesWhenTheLastReaderDetaches) {
+  BroadcastRing<uint64_t, 2> ring(1, WaitPolicy::PARK);
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_NE(ring.PrepareWrite(), nullptr);
+    ring.CommitWrite();
+  }
+  std::thread reader([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let the producer park
+    ring.Detach(0);
+  });
+  EXPECT_EQ(ring.WaitWrite(), nullptr);
+  reader.join();
+}
+
+}  // namespace
+}  // namespace backtester
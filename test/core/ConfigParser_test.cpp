@@ -184,11 +184,92 @@ TEST_F(ConfigParserTest, ParsesDataStreamEnumsAndPaths) {
   EXPECT_EQ(s.data_filepath, data_path.string());
 }
  
+TEST_F(ConfigParserTest, AssignsDataSourceIdsInConfigOrder) {
+  auto cfg = MakeValidConfig();
+  auto second = cfg["data_streams"][0];
+  second["data_source_name"] = "NQ";
+  cfg["data_streams"].push_back(second);
+  AppConfig r = Parse(cfg);
+  ASSERT_EQ(r.data_configs.size(), 2);
+  EXPECT_EQ(r.data_configs[0].data_source_id, 0);
+  EXPECT_EQ(r.data_configs[1].data_source_id, 1);
+}
+ 
+TEST_F(ConfigParserTest, DecodeThreadsDefaultsToOneAndRejectsZero) {
+  auto cfg = MakeValidConfig();
+  EXPECT_EQ(Parse(cfg).data_configs[0].decode_threads, 1u);
+  cfg["data_streams"][0]["decode_threads"] = 4;
+  EXPECT_EQ(Parse(cfg).data_configs[0].decode_threads, 4u);
+  cfg["data_streams"][0]["decode_threads"] = 0;
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, BookShardsDefaultsToOneAndRejectsOutOfRange) {
+  auto cfg = MakeValidConfig();
+  EXPECT_EQ(Parse(cfg).book_shards, 1u);
+  cfg["book_shards"] = 64;
+  EXPECT_EQ(Parse(cfg).book_shards, 64u);
+  for (const int shards : {0, 65}) {
+    SCOPED_TRACE(shards);
+    cfg["book_shards"] = shards;
+    EXPECT_THROW(Parse(cfg), std::runtime_error);
+  }
+}
+
+TEST_F(ConfigParserTest, PrefetchBlocksDefaultsToThree) {
+  auto cfg = MakeValidConfig();
+  EXPECT_EQ(Parse(cfg).data_configs[0].prefetch_blocks, 3u);
+  cfg["data_streams"][0]["prefetch_blocks"] = 0;
+  EXPECT_EQ(Parse(cfg).data_configs[0].prefetch_blocks, 0u);
+}
+ 
+TEST_F(ConfigParserTest, DataFilepathExpandsDatesAndGlobs) {
+  WriteFile(tmp_dir / "ES-20240101.csv.zst", "");
+  WriteFile(tmp_dir / "ES-20240103.csv.zst", "");
+  WriteFile(tmp_dir / "ES-20240105.csv.zst", "");  // after end_time
+
+  auto cfg = MakeValidConfig();
+  cfg["end_time"] = "2024-01-04T16:00:00Z";
+  cfg["data_streams"][0]["data_filepath"] = "ES-{date}.csv.zst";  // relative to the config
+  auto by_date = Parse(cfg).data_configs[0];
+  ASSERT_EQ(by_date.data_files.size(), 2u);
+  EXPECT_EQ(by_date.data_files[0], (tmp_dir / "ES-20240101.csv.zst").string());
+  EXPECT_EQ(by_date.data_files[1], (tmp_dir / "ES-20240103.csv.zst").string());
+  EXPECT_EQ(by_date.data_filepath, by_date.data_files[0]);
+
+  cfg["data_streams"][0]["data_filepath"] = "ES-2024010*.csv.zst";
+  auto by_glob = Parse(cfg).data_configs[0];
+  ASSERT_EQ(by_glob.data_files.size(), 3u);
+  EXPECT_EQ(by_glob.data_files[2], (tmp_dir / "ES-20240105.csv.zst").string());
+
+  EXPECT_TRUE(Parse(MakeValidConfig()).data_configs[0].data_files.empty());  // single file
+  cfg["data_streams"][0]["data_filepath"] = "NQ-*.csv.zst";
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, Mbp10StreamRejectsStrategiesDeeperThanTenLevels) {
+  auto cfg = MakeValidConfig();
+  cfg["data_streams"][0]["schema"] = "mbp-10";
+  cfg["strategies"][0]["max_lob_lvl"] = 10;
+  EXPECT_EQ(Parse(cfg).data_configs[0].schema, DataSchema::MBP10);
+  cfg["strategies"][0]["max_lob_lvl"] = 11;
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+}
+
 TEST_F(ConfigParserTest, BuildsActiveInstrumentsFromSymbology) {
   AppConfig r = Parse(MakeValidConfig());
   std::vector<uint32_t> expected = {42140860, 42005050, 294973};
   EXPECT_EQ(r.active_instruments, expected);
 }
+
+TEST_F(ConfigParserTest, FilterInstrumentsKeepsTheStreamsSymbology) {
+  auto cfg = MakeValidConfig();
+  EXPECT_TRUE(Parse(cfg).data_configs[0].instrument_filter.empty());
+  cfg["data_streams"][0]["filter_instruments"] = true;
+  const auto source = Parse(cfg).data_configs[0];
+  ASSERT_EQ(source.instrument_filter.size(), source.data_symbology.size());
+  EXPECT_EQ(source.instrument_filter[0], source.data_symbology[0].instrument_id);
+}
  
 //////////////////////////////////////////////////////////
 // MARK: start_time / end_time
@@ -637,6 +718,33 @@ TEST_F(ConfigParserTest, CommissionPartialUsesPerFieldDefaults) {
   ExpectFixedPointNear(c.stock_clearing_fee, 0.0002);  
 }
  
+//////////////////////////////////////////////////////////
+// MARK: Sweep
+//////////////////////////////////////////////////////////
+TEST_F(ConfigParserTest, SweepGridResolvesStrategyAndParamSlot) {
+  auto cfg = MakeValidConfig();
+  EXPECT_TRUE(Parse(cfg).sweep.axes.empty());
+  cfg["sweep"] = {{"threads", 4},
+                  {"grid",
+                   {{{"strategy", "MovAvgCrossMin"}, {"param", 1}, {"values", {20, 30, 40}}}}}};
+  const auto sweep = Parse(cfg).sweep;
+  EXPECT_EQ(sweep.threads, 4u);
+  ASSERT_EQ(sweep.axes.size(), 1u);
+  EXPECT_EQ(sweep.axes[0].strategy_index, 0u);
+  EXPECT_EQ(sweep.axes[0].param_index, 1u);
+  EXPECT_EQ(sweep.axes[0].values, (std::vector<int>{20, 30, 40}));
+}
+
+TEST_F(ConfigParserTest, SweepThrowsOnUnknownStrategyOrSlot) {
+  auto cfg = MakeValidConfig();
+  cfg["sweep"] = {{"grid", {{{"strategy", "Nope"}, {"param", 0}, {"values", {1}}}}}};
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+  cfg["sweep"] = {{"grid", {{{"strategy", "MovAvgCrossMin"}, {"param", 2}, {"values", {1}}}}}};
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+  cfg["sweep"] = {{"grid", nlohmann::json::array()}};
+  EXPECT_THROW(Parse(cfg), std::runtime_error);
+}
+ 
 //////////////////////////////////////////////////////////
 // MARK: Data Streams
 //////////////////////////////////////////////////////////
@@ -673,6 +781,10 @@ TEST_F(ConfigParserTest, ParsesAlternateEnumValues) {
     auto cfg = MakeValidConfig();
     cfg["data_streams"][0]["schema"] = "OHLCV";
     EXPECT_EQ(Parse(cfg).data_configs[0].schema, DataSchema::OHLCV);
+    EXPECT_EQ(Parse(cfg).data_configs[0].bar_interval_ns, 0u);
+    cfg["data_streams"][0]["schema"] = "ohlcv-1m";
+    EXPECT_EQ(Parse(cfg).data_configs[0].schema, DataSchema::OHLCV);
+    EXPECT_EQ(Parse(cfg).data_configs[0].bar_interval_ns, 60'000'000'000ULL);
   }
   {
     auto cfg = MakeValidConfig();
@@ -684,6 +796,17 @@ TEST_F(ConfigParserTest, ParsesAlternateEnumValues) {
     cfg["data_streams"][0]["encoding"] = "JSON";
     EXPECT_EQ(Parse(cfg).data_configs[0].encoding, Encoding::JSON);
   }
+  {
+    auto cfg = MakeValidConfig();
+    cfg["data_streams"][0]["encoding"] = "mbocache";
+    EXPECT_EQ(Parse(cfg).data_configs[0].encoding, Encoding::MBOCACHE);
+  }
+  {
+    auto cfg = MakeValidConfig();
+    EXPECT_EQ(Parse(cfg).data_configs[0].parser, CsvParser::SCALAR);
+    cfg["data_streams"][0]["parser"] = "SIMD";
+    EXPECT_EQ(Parse(cfg).data_configs[0].parser, CsvParser::SIMD);
+  }
   {
     auto cfg = MakeValidConfig();
     cfg["data_streams"][0]["compression"] = "NONE";
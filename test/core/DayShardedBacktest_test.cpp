@@ -0,0 +1,101 @@
+#include "core/DayShardedBacktest.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace backtester {
+
+namespace {
+
+constexpr timestamp_t kDay = 86'400'000'000'000ULL;
+constexpr timestamp_t kNov5 = 1'762'300'800'000'000'000ULL;  // 2025-11-05T00:00:00Z
+constexpr money_t kCash = 100'000;
+
+DataSourceConfig Source(uint16_t id, std::vector<std::string> files) {
+  DataSourceConfig dc{};
+  dc.data_source_id = id;
+  dc.data_filepath = files.front();
+  if (files.size() > 1) dc.data_files = std::move(files);
+  return dc;
+}
+
+EquitySnapshot Snap(timestamp_t ts, money_t equity, money_t drawdown) {
+  EquitySnapshot s;
+  s.timestamp = ts;
+  s.equity = s.cash = equity;
+  s.drawdown = drawdown;
+  return s;
+}
+
+}  // namespace
+
+TEST(DayShardedBacktestTest, SplitsAtUtcMidnightAndPicksEachDaysFiles) {
+  AppConfig config{};
+  config.start_time = kNov5 + kDay / 2;  // noon on the 5th
+  config.end_time = kNov5 + 3 * kDay + 1000;  // just into the 8th
+  config.report_output_dir = "/tmp/reports";
+  config.data_configs = {
+      Source(0, {"data/ES-20251105.mbo.csv.zst", "data/ES-20251106.mbo.csv.zst",
+                 "data/ES-20251108.mbo.csv.zst"}),
+      Source(3, {"data/NQ-20251106.mbo.csv.zst"}),
+      Source(4, {"data/bars.csv"}),  // undated: replayed every day
+  };
+
+  const auto days = SplitIntoDays(config);
+  ASSERT_EQ(days.size(), 4u);
+  EXPECT_EQ(days[0].label, "20251105");
+  EXPECT_EQ(days[0].config.start_time, config.start_time);
+  EXPECT_EQ(days[0].config.end_time, kNov5 + kDay - 1);
+  EXPECT_EQ(days[0].config.report_output_dir, "/tmp/reports/days/20251105");
+  ASSERT_EQ(days[0].config.data_configs.size(), 2u);
+  EXPECT_EQ(days[0].config.data_configs[0].data_filepath, "data/ES-20251105.mbo.csv.zst");
+  EXPECT_TRUE(days[0].config.data_configs[0].data_files.empty());
+  EXPECT_EQ(days[0].config.data_configs[1].data_source_id, 4);
+
+  ASSERT_EQ(days[1].config.data_configs.size(), 3u);
+  EXPECT_EQ(days[1].config.data_configs[1].data_filepath, "data/NQ-20251106.mbo.csv.zst");
+  EXPECT_EQ(days[1].config.start_time, kNov5 + kDay);
+
+  // The 7th has no dated file, only the undated source
+  ASSERT_EQ(days[2].config.data_configs.size(), 1u);
+  EXPECT_EQ(days[2].config.data_configs[0].data_source_id, 4);
+
+  EXPECT_EQ(days[3].label, "20251108");
+  EXPECT_EQ(days[3].config.end_time, config.end_time);
+
+  // Without the undated source the 7th has nothing to run
+  config.data_configs.pop_back();
+  const auto dated_only = SplitIntoDays(config);
+  ASSERT_EQ(dated_only.size(), 3u);
+  EXPECT_EQ(dated_only[2].label, "20251108");
+}
+
+TEST(DayShardedBacktestTest, StitchingCarriesPnlAndPeakAcrossDays) {
+  std::vector<DayResult> days(3);
+  // Day 1: up 50, ends +40 after the close
+  days[0].ok = true;
+  days[0].equity_curve = {Snap(1, kCash + 50, 0), Snap(2, kCash + 45, 5)};
+  days[0].final_equity = kCash + 40;
+  days[0].final_realized_pnl = 40;
+  // Day 2 fails and is left out
+  days[1].final_equity = kCash + 1'000;
+  // Day 3: dips 20, never sees the earlier peak again
+  days[2].ok = true;
+  days[2].equity_curve = {Snap(5, kCash - 20, 20), Snap(6, kCash + 5, 0)};
+  days[2].final_equity = kCash + 5;
+
+  const auto curve = StitchEquityCurves(days, kCash);
+  ASSERT_EQ(curve.size(), 4u);
+  EXPECT_EQ(curve[1].equity, kCash + 45);
+  EXPECT_EQ(curve[1].drawdown, 5);
+  EXPECT_EQ(curve[2].equity, kCash + 20);
+  EXPECT_EQ(curve[2].cash, kCash + 20);
+  EXPECT_EQ(curve[2].realized_pnl, 40);
+  EXPECT_EQ(curve[2].drawdown, 30);  // against day 1's peak of +50
+  EXPECT_EQ(curve[3].equity, kCash + 45);
+  EXPECT_EQ(curve[3].drawdown, 5);
+}
+
+}  // namespace backtester
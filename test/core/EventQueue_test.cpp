@@ -134,16 +134,16 @@ namespace backtester {
         //////////////////////////////////////////////////////////
 
         // CONTRACT "Market -> Strategy -> Backtest".
-        // At an equal timestamp the queue must hand back Market events (enum 0..7)
-        // before Strategy events (8..13) before Control events (14..17), so that the
+        // At an equal timestamp the queue must hand back Market events (enum 0..9)
+        // before Strategy events (10..15) before Control events (16..19), so that the
         // book is updated before strategies react at the same instant.
 
         TEST_F(EventQueueTest, EqualTimestamp_MarketBeforeStrategyBeforeControl) {
             const uint64_t ts = 1000;
             // Insert in a deliberately scrambled order.
-            q.PushEvent(MakeEvent(ts, EventType::kBacktestControlSnapshot)); // 16
+            q.PushEvent(MakeEvent(ts, EventType::kBacktestControlSnapshot)); // 18
             q.PushEvent(MakeEvent(ts, EventType::kMarketTrade));             // 4
-            q.PushEvent(MakeEvent(ts, EventType::kStrategySignal));          // 8
+            q.PushEvent(MakeEvent(ts, EventType::kStrategySignal));          // 10
 
             auto types = DrainTypes(q);
             ASSERT_EQ(types.size(), 3u);
@@ -340,5 +340,62 @@ namespace backtester {
             EXPECT_EQ(pushed, popped);
         }
 
+        //////////////////////////////////////////////////////////
+        // MARK: Lanes and overflow
+        //////////////////////////////////////////////////////////
+
+        TEST_F(EventQueueTest, EqualTimestampAndType_InOrderPushes_PopInPushOrder) {
+            for (uint64_t id = 1; id <= 4; ++id) {
+                q.PushEvent(MakeTagged(100, EventType::kStrategySignal, id));
+            }
+            std::vector<uint64_t> ids;
+            while (!q.IsEmpty()) ids.push_back(TagOf(q.PopTopEvent()));
+            EXPECT_EQ(ids, (std::vector<uint64_t>{1, 2, 3, 4}));
+        }
+
+        TEST_F(EventQueueTest, LatePushes_StillPopInSortedOrder) {
+            // Mostly time-ordered per type like the backtest loop, with some late stragglers
+            std::mt19937_64 rng(0x5EED);
+            std::uniform_int_distribution<int> type_dist(10, 15);
+            std::uniform_int_distribution<uint64_t> jitter(0, 50);
+            std::uniform_int_distribution<int> pct(0, 99);
+
+            std::vector<std::pair<uint64_t, EventType>> expected;
+            uint64_t now = 1000;
+            for (int i = 0; i < 5000; ++i) {
+                now += jitter(rng);
+                const uint64_t ts = pct(rng) < 10 ? now - jitter(rng) : now + jitter(rng);
+                const auto type = static_cast<EventType>(type_dist(rng));
+                q.PushEvent(MakeEvent(ts, type));
+                expected.emplace_back(ts, type);
+            }
+            std::sort(expected.begin(), expected.end());
+
+            std::vector<std::pair<uint64_t, EventType>> popped;
+            ASSERT_EQ(q.size(), expected.size());
+            while (!q.IsEmpty()) {
+                const EventHeader top = Hdr(q.ReadTopEvent());
+                const EventHeader h = Hdr(q.PopTopEvent());
+                EXPECT_EQ(top.timestamp, h.timestamp);
+                popped.emplace_back(h.timestamp, h.type);
+            }
+            EXPECT_EQ(popped, expected);
+        }
+
+        TEST_F(EventQueueTest, LatePushes_KeepTheirPayloadAcrossSlotReuse) {
+            // Pushed behind the lane's tail, so these live in the heap's slab
+            q.PushEvent(MakeTagged(500, EventType::kStrategyOrderFill, 1u));
+            q.PushEvent(MakeTagged(300, EventType::kStrategyOrderFill, 2u));
+            q.PushEvent(MakeTagged(200, EventType::kStrategyOrderFill, 3u));
+            EXPECT_EQ(TagOf(q.PopTopEvent()), 3u);
+            // takes the freed slot
+            q.PushEvent(MakeTagged(250, EventType::kStrategyOrderFill, 4u));
+            EXPECT_EQ(TagOf(q.ReadTopEvent()), 4u);
+            EXPECT_EQ(TagOf(q.PopTopEvent()), 4u);
+            EXPECT_EQ(TagOf(q.PopTopEvent()), 2u);
+            EXPECT_EQ(TagOf(q.PopTopEvent()), 1u);
+            EXPECT_TRUE(q.IsEmpty());
+        }
+
     }
 }
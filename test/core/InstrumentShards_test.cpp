@@ -0,0 +1,101 @@
+#include "core/InstrumentShards.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace backtester {
+
+namespace {
+
+constexpr int64_t kTick = 25;
+
+EventUnion Add(uint32_t instrument_id, uint64_t ts, OrderSide side, int64_t price,
+               uint64_t order_id) {
+  return {.mbo = {.header = {.timestamp = ts, .type = EventType::kMarketOrderAdd},
+                  .ts_recv = ts,
+                  .order_id = order_id,
+                  .price = price,
+                  .size = 1,
+                  .sequence = 1,
+                  .instrument_id = instrument_id,
+                  .ts_in_delta = 0,
+                  .data_source_id = 0,
+                  .publisher_id = 1,
+                  .side = side,
+                  .flags = 0x80}};
+}
+
+AppConfig ShardConfig(WaitPolicy wait) {
+  AppConfig config{};
+  config.ring_wait = wait;
+  config.active_instruments = {10, 11, 12, 13, 14};
+  for (uint32_t id : {11u, 14u}) {
+    TradedInstrument instr{};
+    instr.instrument_id = id;
+    instr.tick_size = kTick;
+    config.traded_instruments.push_back(instr);
+  }
+  return config;
+}
+
+}  // namespace
+
+TEST(InstrumentShardsTest, FramesComeBackInRoutingOrderWithEachBooksState) {
+  for (const WaitPolicy wait : {WaitPolicy::SPIN, WaitPolicy::PARK}) {
+    SCOPED_TRACE(wait == WaitPolicy::PARK ? "park" : "spin");
+    InstrumentShards shards(3, ShardConfig(wait));
+
+    // More events than any one ring holds, with equal timestamps across instruments
+    std::vector<EventUnion> events;
+    for (uint64_t i = 0; i < 3 * InstrumentShards::kInputCapacity; ++i) {
+      const auto id = static_cast<uint32_t>(10 + (i * 7) % 5);
+      const OrderSide side = (i % 2 == 0) ? OrderSide::kBid : OrderSide::kAsk;
+      const int64_t price = (side == OrderSide::kBid ? 1000 : 1100) + (id - 10) * kTick;
+      events.push_back(Add(id, 1'000 + i / 4, side, price, i + 1));
+    }
+
+    std::thread router([&]() {
+      for (const auto& ev : events) ASSERT_TRUE(shards.Route(ev));
+      shards.Close();
+    });
+
+    size_t n = 0;
+    while (const MarketFrame* frame = shards.WaitRead(0)) {
+      ASSERT_LT(n, events.size());
+      EXPECT_EQ(frame->event.mbo.order_id, events[n].mbo.order_id);
+      const uint32_t id = frame->event.mbo.instrument_id;
+      EXPECT_EQ(frame->has_state, id == 11 || id == 14);
+      if (frame->has_state && n > 10) {
+        EXPECT_EQ(frame->state.snapshot.bbo.bid.price, 1000 + (id - 10) * kTick);
+        EXPECT_EQ(frame->state.snapshot.bbo.ask.price, 1100 + (id - 10) * kTick);
+      }
+      shards.CommitRead(0);
+      ++n;
+    }
+    router.join();
+    shards.Join();
+    EXPECT_EQ(n, events.size());
+  }
+}
+
+TEST(InstrumentShardsTest, DetachingStopsTheRouterAndWorkers) {
+  for (const WaitPolicy wait : {WaitPolicy::SPIN, WaitPolicy::PARK}) {
+    SCOPED_TRACE(wait == WaitPolicy::PARK ? "park" : "spin");
+    InstrumentShards shards(2, ShardConfig(wait));
+    std::thread router([&]() {
+      uint64_t oid = 1;
+      while (shards.Route(Add(10 + oid % 2, oid, OrderSide::kBid, 1000, oid))) ++oid;
+    });
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_NE(shards.WaitRead(0), nullptr);
+      shards.CommitRead(0);
+    }
+    shards.Detach(0);  // the router blocks on full rings until it sees this
+    router.join();
+    shards.Join();
+  }
+}
+
+}  // namespace backtester
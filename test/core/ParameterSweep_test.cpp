@@ -0,0 +1,78 @@
+#include "core/ParameterSweep.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+
+namespace backtester {
+
+class ParameterSweepTest : public TempPathTest {
+ protected:
+  ParameterSweepTest() : TempPathTest("sweep") {}
+};
+
+namespace {
+
+AppConfig SweepBase() {
+  AppConfig config{};
+  config.report_output_dir = "/tmp/reports";
+  config.strategies = {{"MovAvgCross", {5, 20}, 1, 1}, {"SimpleMarketMaker", {1, 1, 5, 1}, 1, 1}};
+  config.sweep.axes = {{0, 0, {5, 10}}, {0, 1, {20, 50, 100}}, {1, 3, {0, 2}}};
+  return config;
+}
+
+SweepResult Result(size_t combo, double sharpe, money_t pnl, bool ok = true) {
+  SweepResult r;
+  r.combo = combo;
+  r.summary.sharpe_ratio = sharpe;
+  r.summary.total_pnl = pnl;
+  r.ok = ok;
+  return r;
+}
+
+}  // namespace
+
+TEST_F(ParameterSweepTest, GridIsTheCartesianProductLastAxisFastest) {
+  const auto combos = ExpandSweepGrid(SweepBase().sweep);
+  ASSERT_EQ(combos.size(), 12u);
+  EXPECT_EQ(combos.front(), (std::vector<int>{5, 20, 0}));
+  EXPECT_EQ(combos[1], (std::vector<int>{5, 20, 2}));
+  EXPECT_EQ(combos[2], (std::vector<int>{5, 50, 0}));
+  EXPECT_EQ(combos.back(), (std::vector<int>{10, 100, 2}));
+  EXPECT_TRUE(ExpandSweepGrid({}).empty());
+}
+
+TEST_F(ParameterSweepTest, ComboOverwritesOnlyTheSweptSlots) {
+  const AppConfig base = SweepBase();
+  const AppConfig config = ApplySweepCombo(base, {10, 50, 2}, "/tmp/reports/sweep/combo_0009");
+  EXPECT_EQ(config.strategies[0].params, (std::vector<int>{10, 50}));
+  EXPECT_EQ(config.strategies[1].params, (std::vector<int>{1, 1, 5, 2}));
+  EXPECT_EQ(config.report_output_dir, "/tmp/reports/sweep/combo_0009");
+  EXPECT_EQ(base.strategies[0].params, (std::vector<int>{5, 20}));
+}
+
+TEST_F(ParameterSweepTest, RankingDropsFailuresAndOrdersBySharpeThenPnl) {
+  const auto ranked = ParameterSweep::Rank(
+      {Result(0, 0.5, 10), Result(1, 1.5, 0), Result(2, 0.5, 30), Result(3, 9.0, 0, false)});
+  ASSERT_EQ(ranked.size(), 3u);
+  EXPECT_EQ(ranked[0].combo, 1u);
+  EXPECT_EQ(ranked[1].combo, 2u);
+  EXPECT_EQ(ranked[2].combo, 0u);
+
+  const auto path = TempPath(".csv");
+  AppConfig config = SweepBase();
+  ASSERT_TRUE(ParameterSweep::WriteRanking(path.string(), config, ranked));
+  std::ifstream file(path);
+  std::string header, first;
+  std::getline(file, header);
+  std::getline(file, first);
+  EXPECT_EQ(header.rfind("rank,combo,MovAvgCross.p0,MovAvgCross.p1,SimpleMarketMaker.p3,", 0), 0u);
+  EXPECT_EQ(first.rfind("1,1,", 0), 0u);
+}
+
+}  // namespace backtester
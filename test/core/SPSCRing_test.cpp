@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <limits>
 #include <random>
@@ -271,5 +272,133 @@ TEST(SPSCRingConcurrent, TwoThreads_ZeroCopyApi) {
   EXPECT_TRUE(order_ok.load());
 }
 
+//////////////////////////////////////////////////////////
+// MARK: Batched API
+//////////////////////////////////////////////////////////
+
+TEST(SPSCRingBatch, BatchesStopAtTheWrapAndAtFull) {
+  SPSCRing<uint64_t, 8> ring;
+  auto w = ring.PrepareWriteBatch(5);
+  ASSERT_EQ(w.size(), 5u);
+  for (size_t i = 0; i < w.size(); ++i) w[i] = i;
+  EXPECT_EQ(ring.PeekReadBatch(8).size(), 0u);  // nothing published yet
+  ring.CommitWriteBatch(5);
+
+  auto r = ring.PeekReadBatch(3);
+  ASSERT_EQ(r.size(), 3u);
+  EXPECT_EQ(r[2], 2u);
+  ring.CommitReadBatch(3);
+
+  // 6 free, but only 3 contiguous before the end of the slots
+  w = ring.PrepareWriteBatch(8);
+  ASSERT_EQ(w.size(), 3u);
+  for (size_t i = 0; i < w.size(); ++i) w[i] = 5 + i;
+  ring.CommitWriteBatch(3);
+  w = ring.PrepareWriteBatch(8);
+  ASSERT_EQ(w.size(), 3u);  // wrapped; the 2 unread slots are still taken
+  for (size_t i = 0; i < w.size(); ++i) w[i] = 8 + i;
+  ring.CommitWriteBatch(3);
+  EXPECT_TRUE(ring.PrepareWriteBatch(8).empty());
+
+  std::vector<uint64_t> out;
+  for (auto batch = ring.PeekReadBatch(8); !batch.empty(); batch = ring.PeekReadBatch(8)) {
+    out.insert(out.end(), batch.begin(), batch.end());
+    ring.CommitReadBatch(batch.size());
+  }
+  EXPECT_EQ(out, (std::vector<uint64_t>{3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST(SPSCRingConcurrent, TwoThreads_BatchedApi) {
+  SPSCRing<Payload, 1024> ring;
+  constexpr uint64_t N = 2'000'000;
+  std::atomic<bool> order_ok{true};
+
+  std::thread consumer([&] {
+    uint64_t expect = 0;
+    while (expect < N) {
+      const auto batch = ring.PeekReadBatch(64);
+      if (batch.empty()) std::this_thread::yield();
+      for (const Payload& p : batch) {
+        if (p.seq != expect++) order_ok.store(false);
+      }
+      ring.CommitReadBatch(batch.size());
+    }
+  });
+  for (uint64_t i = 0; i < N;) {
+    const auto slots = ring.PrepareWriteBatch(std::min<uint64_t>(64, N - i));
+    if (slots.empty()) std::this_thread::yield();
+    for (Payload& p : slots) p.seq = i++;
+    ring.CommitWriteBatch(slots.size());
+  }
+  consumer.join();
+  EXPECT_TRUE(order_ok.load());
+}
+
+//////////////////////////////////////////////////////////
+// MARK: Wait policies
+//////////////////////////////////////////////////////////
+
+TEST(RingWaiterTest, SpinAndPause_ReturnOnceReady_CountingTurns) {
+  for (WaitPolicy policy : {WaitPolicy::SPIN, WaitPolicy::PAUSE}) {
+    RingWaiter waiter(policy);
+    int polls = 0;
+    waiter.Wait([&] { return ++polls > 5; });
+    EXPECT_EQ(waiter.Stats().spins, 5u);
+    EXPECT_EQ(waiter.Stats().parks, 0u);
+    waiter.NotifyNow();  // nobody parks under these policies
+    EXPECT_EQ(waiter.Stats().wakes, 0u);
+  }
+}
+
+TEST(RingWaiterTest, Park_SleepsUntilNotified) {
+  SPSCRing<uint64_t, 16> ring;
+  RingWaiter waiter(WaitPolicy::PARK);
+  uint64_t got = 0;
+  std::thread consumer([&] {
+    waiter.Wait([&] { return ring.PeekRead() != nullptr; });
+    ring.TryPop(got);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));  // long enough to park
+  ASSERT_TRUE(ring.TryPush(7));
+  waiter.NotifyNow();
+  consumer.join();
+  EXPECT_EQ(got, 7u);
+  EXPECT_GE(waiter.Stats().parks, 1u);
+  EXPECT_GE(waiter.Stats().wakes, 1u);
+}
+
+TEST(RingWaiterConcurrent, ParkBothSides_AllItemsInOrder) {
+  SPSCRing<Payload, 64> ring;
+  RingWaiter consumer_wait(WaitPolicy::PARK);
+  RingWaiter producer_wait(WaitPolicy::PARK);
+  constexpr uint64_t N = 200'000;
+  std::atomic<bool> done{false};
+  bool order_ok = true;
+
+  std::thread consumer([&] {
+    uint64_t expect = 0;
+    while (true) {
+      consumer_wait.Wait([&] { return ring.PeekRead() != nullptr || done.load(); });
+      const Payload* p = ring.PeekRead();
+      if (!p) break;  // done and drained
+      if (p->seq != expect++) order_ok = false;
+      ring.CommitRead();
+      producer_wait.Notify();
+    }
+    EXPECT_EQ(expect, N);
+  });
+  for (uint64_t i = 0; i < N; ++i) {
+    Payload* slot = nullptr;
+    producer_wait.Wait([&] { return (slot = ring.PrepareWrite()) != nullptr; });
+    slot->seq = i;
+    ring.CommitWrite();
+    consumer_wait.Notify();
+  }
+  done.store(true);
+  consumer_wait.NotifyNow();
+  consumer.join();
+  EXPECT_TRUE(order_ok);
+}
+
 }  // namespace
 }  // namespace backtester
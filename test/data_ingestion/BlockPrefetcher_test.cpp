@@ -0,0 +1,112 @@
+#include "data_ingestion/BlockPrefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "data_ingestion/CsvZstReader.h"
+
+namespace backtester {
+
+class BlockPrefetcherTest : public ::testing::Test {
+ protected:
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  const std::filesystem::path path_ = std::filesystem::temp_directory_path() / "prefetch.bin";
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+  }
+
+  void WriteFile(const std::string& bytes) const {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    out << bytes;
+  }
+
+  static std::string Drain(BlockPrefetcher& prefetcher) {
+    std::string got;
+    for (auto block = prefetcher.NextBlock(); !block.empty(); block = prefetcher.NextBlock()) {
+      got.append(block.data(), block.size());
+    }
+    return got;
+  }
+};
+
+TEST_F(BlockPrefetcherTest, ReturnsFileInOrderAtEveryDepth) {
+  std::string bytes;
+  for (int i = 0; i < 1000; ++i) bytes += std::to_string(i * 7919) + ",";
+  WriteFile(bytes);
+
+  for (size_t depth : {size_t{0}, size_t{1}, size_t{2}, size_t{3}}) {
+    SCOPED_TRACE("depth " + std::to_string(depth));
+    BlockPrefetcher prefetcher(depth, 333);
+    ASSERT_TRUE(prefetcher.Open(path_));
+    EXPECT_EQ(Drain(prefetcher), bytes);
+    EXPECT_TRUE(prefetcher.NextBlock().empty());  // stays at end
+  }
+}
+
+TEST_F(BlockPrefetcherTest, EmptyAndMissingFiles) {
+  WriteFile("");
+  BlockPrefetcher prefetcher(3, 64);
+  ASSERT_TRUE(prefetcher.Open(path_));
+  EXPECT_TRUE(prefetcher.NextBlock().empty());
+  EXPECT_FALSE(prefetcher.Open((kTestDataFolder / "does_not_exist.zst").string()));
+  EXPECT_TRUE(prefetcher.NextBlock().empty());
+}
+
+TEST_F(BlockPrefetcherTest, ReadErrorEndsTheBlocksFailed) {
+  // A directory opens but every pread on it fails with EISDIR.
+  for (size_t depth : {size_t{0}, size_t{3}}) {
+    SCOPED_TRACE("depth " + std::to_string(depth));
+    BlockPrefetcher prefetcher(depth, 64);
+    ASSERT_TRUE(prefetcher.Open(kTestDataFolder.string()));
+    EXPECT_TRUE(prefetcher.NextBlock().empty());
+    EXPECT_TRUE(prefetcher.Failed());
+    prefetcher.Close();
+    EXPECT_TRUE(prefetcher.Failed());  // still there for a reader that closed first
+
+    WriteFile("abc");
+    ASSERT_TRUE(prefetcher.Open(path_));
+    EXPECT_EQ(Drain(prefetcher), "abc");
+    EXPECT_FALSE(prefetcher.Failed());
+  }
+
+  CsvZstReader reader(3);
+  std::string line;
+  ASSERT_TRUE(reader.Open(kTestDataFolder.string()));
+  EXPECT_FALSE(reader.ReadLine(line));
+  EXPECT_TRUE(reader.Failed());
+}
+
+TEST_F(BlockPrefetcherTest, ClosesMidFileAndReopens) {
+  WriteFile(std::string(10000, 'x'));
+  BlockPrefetcher prefetcher(2, 100);
+  ASSERT_TRUE(prefetcher.Open(path_));
+  EXPECT_EQ(prefetcher.NextBlock().size(), 100u);
+  prefetcher.Close();  // reader thread is blocked on a full ring here
+  ASSERT_TRUE(prefetcher.Open(path_));
+  EXPECT_EQ(Drain(prefetcher).size(), 10000u);
+}
+
+TEST_F(BlockPrefetcherTest, CsvZstReaderSameLinesWithAndWithoutPrefetch) {
+  const std::string file = (kTestDataFolder / "futures_mbo.csv.zst").string();
+  CsvZstReader inline_reader(0);
+  CsvZstReader prefetch_reader(3);
+  ASSERT_TRUE(inline_reader.Open(file));
+  ASSERT_TRUE(prefetch_reader.Open(file));
+
+  std::string a, b;
+  size_t lines = 0;
+  while (inline_reader.ReadLine(a)) {
+    ASSERT_TRUE(prefetch_reader.ReadLine(b));
+    EXPECT_EQ(a, b);
+    ++lines;
+  }
+  EXPECT_FALSE(prefetch_reader.ReadLine(b));
+  EXPECT_EQ(lines, 21u);  // header + 20 rows
+}
+
+}  // namespace backtester
@@ -0,0 +1,88 @@
+#include "data_ingestion/CsvReader.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class CsvReaderTest : public TempPathTest {
+ protected:
+  CsvReaderTest() : TempPathTest("csvreader") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+
+  DataSourceConfig Source(Compression compression, CsvParser parser) const {
+    return {"ES",
+            0,
+            {},
+            kTestDataFolder /
+                (compression == Compression::NONE ? "futures_mbo.csv" : "futures_mbo.csv.zst"),
+            DataSchema::MBO,
+            Encoding::CSV,
+            compression,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO,
+            1,
+            parser};
+  }
+
+  static std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> events(64);
+    events.resize(manager.LoadNextBatch(0, events));
+    return events;
+  }
+};
+
+TEST_F(CsvReaderTest, PlainFileMatchesCompressed) {
+  const auto expected = Drain(Source(Compression::ZSTD, CsvParser::SCALAR));
+  ASSERT_EQ(expected.size(), 20u);
+
+  for (CsvParser parser : {CsvParser::SCALAR, CsvParser::SIMD}) {
+    const auto got = Drain(Source(Compression::NONE, parser));
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      EXPECT_EQ(got[i].header.timestamp, expected[i].header.timestamp) << "event " << i;
+      EXPECT_EQ(got[i].order_id, expected[i].order_id) << "event " << i;
+      EXPECT_EQ(got[i].price, expected[i].price) << "event " << i;
+      EXPECT_EQ(got[i].flags, expected[i].flags) << "event " << i;
+    }
+  }
+}
+
+TEST_F(CsvReaderTest, LineViewsHandleCrlfAndNoTrailingNewline) {
+  const auto path = TempPath(".csv");
+  {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f << "line1\r\n\nline3";
+  }
+  CsvReader reader(Source(Compression::NONE, CsvParser::SCALAR));
+  ASSERT_TRUE(reader.Open(path));
+
+  std::string_view view;
+  ASSERT_TRUE(reader.ReadLineView(view));
+  EXPECT_EQ(view, "line1");
+  ASSERT_TRUE(reader.ReadLineView(view));
+  EXPECT_EQ(view, "");
+  ASSERT_TRUE(reader.ReadLineView(view));
+  EXPECT_EQ(view, "line3");
+  EXPECT_FALSE(reader.ReadLineView(view));
+}
+
+TEST_F(CsvReaderTest, FactoryRejectsUnimplementedEncoding) {
+  DataSourceConfig source = Source(Compression::NONE, CsvParser::SCALAR);
+  source.encoding = Encoding::JSON;
+  EXPECT_EQ(MakeDataReader(source), nullptr);
+  DataReaderManager manager;
+  EXPECT_FALSE(manager.RegisterAndInitStreams({source}));
+}
+
+}  // namespace backtester
@@ -284,4 +284,39 @@ TEST_F(CsvZstReaderTest, ReadRealMBOFile) {
     EXPECT_EQ(lines, 21);  // Known sample size
 }
 
+// Lines straddling the 128KB decompression buffer are stitched, the rest are views
+TEST_F(CsvZstReaderTest, ReadLineViewAcrossBufferRefills) {
+    std::vector<std::string> expected;
+    std::string content;
+    for (size_t i = 0; content.size() < 3 * ZSTD_DStreamOutSize(); ++i) {
+        expected.push_back(std::to_string(i) + "," + std::string(i % 997, 'x'));
+        content += expected.back() + ((i % 3 == 0) ? "\r\n" : "\n");
+    }
+    const auto path = std::filesystem::temp_directory_path() / "csvzst_views.zst";
+    createZstFile(path, content);
+
+    CsvZstReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    std::string_view view;
+    for (const auto& line : expected) {
+        ASSERT_TRUE(reader.ReadLineView(view));
+        ASSERT_EQ(view, line);
+    }
+    EXPECT_FALSE(reader.ReadLineView(view));
+    std::filesystem::remove(path);
+}
+
+TEST_F(CsvZstReaderTest, ReadLineViewNoTrailingNewline) {
+    createZstFile(kTestDataFolder / "notrailingNL", "line1\nline2");
+    CsvZstReader reader;
+    ASSERT_TRUE(reader.Open(kTestDataFolder / "notrailingNL"));
+
+    std::string_view view;
+    EXPECT_TRUE(reader.ReadLineView(view));
+    EXPECT_EQ(view, "line1");
+    EXPECT_TRUE(reader.ReadLineView(view));
+    EXPECT_EQ(view, "line2");
+    EXPECT_FALSE(reader.ReadLineView(view));
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "data_ingestion/DataReaderManager.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+
+namespace backtester {
+
+class DataReaderManagerTest : public TempPathTest {
+ protected:
+  DataReaderManagerTest() : TempPathTest("drm") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+
+  DataSourceConfig Source(uint16_t id, CsvParser parser = CsvParser::SCALAR) const {
+    return {"ES",
+            id,
+            {},
+            kTestDataFolder / "futures_mbo.csv.zst",
+            DataSchema::MBO,
+            Encoding::CSV,
+            Compression::ZSTD,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO,
+            1,
+            parser};
+  }
+
+  static std::vector<MarketByOrderEvent> DrainOneByOne(const DataSourceConfig& source) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> events;
+    MarketByOrderEvent mbo;
+    while (manager.LoadNextEventFromSource(source.data_source_id, mbo)) events.push_back(mbo);
+    return events;
+  }
+};
+
+TEST_F(DataReaderManagerTest, BatchesMatchSingleEvents) {
+  for (CsvParser parser : {CsvParser::SCALAR, CsvParser::SIMD}) {
+    const auto expected = DrainOneByOne(Source(0, parser));
+    ASSERT_EQ(expected.size(), 20u);
+
+    DataReaderManager manager;
+    ASSERT_TRUE(manager.RegisterAndInitStreams({Source(0, parser)}));
+    std::vector<MarketByOrderEvent> got;
+    std::vector<MarketByOrderEvent> batch(7);  // does not divide 20
+    while (size_t n = manager.LoadNextBatch(0, batch)) {
+      EXPECT_LE(n, batch.size());
+      got.insert(got.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      EXPECT_EQ(got[i].order_id, expected[i].order_id) << "event " << i;
+      EXPECT_EQ(got[i].header.timestamp, expected[i].header.timestamp) << "event " << i;
+    }
+    EXPECT_EQ(manager.LoadNextBatch(0, batch), 0u);
+  }
+}
+
+TEST_F(DataReaderManagerTest, LooksUpSparseSourceIds) {
+  DataReaderManager manager;
+  ASSERT_TRUE(manager.RegisterAndInitStreams({Source(3), Source(1)}));
+
+  std::vector<MarketByOrderEvent> batch(4);
+  ASSERT_EQ(manager.LoadNextBatch(3, batch), 4u);
+  EXPECT_EQ(batch[0].data_source_id, 3u);
+  ASSERT_EQ(manager.LoadNextBatch(1, batch), 4u);
+  EXPECT_EQ(batch[0].data_source_id, 1u);
+
+  EXPECT_EQ(manager.LoadNextBatch(2, batch), 0u);
+  EXPECT_EQ(manager.LoadNextBatch(9, batch), 0u);
+  MarketByOrderEvent mbo;
+  EXPECT_FALSE(manager.LoadNextEventFromSource(2, mbo));
+}
+
+TEST_F(DataReaderManagerTest, InstrumentFilterDropsRowsBeforeParsing) {
+  uint32_t id = 0;
+  EXPECT_TRUE(PeekInstrumentId("a,b,160,1,206323,A,B", kMboInstrumentColumn, id));
+  EXPECT_EQ(id, 206323u);
+  EXPECT_FALSE(PeekInstrumentId("a,b,160,1", kMboInstrumentColumn, id));
+  EXPECT_FALSE(PeekInstrumentId("a,b,160,1,,A", kMboInstrumentColumn, id));
+
+  // Every other row moved to an instrument the source does not trade
+  const auto path = TempPath(".csv");
+  {
+    std::ifstream in(kTestDataFolder / "futures_mbo.csv");
+    std::ofstream out(path, std::ios::trunc);
+    std::string row;
+    std::getline(in, row);
+    out << row << "\n";
+    for (size_t i = 0; std::getline(in, row); ++i) {
+      if (i % 2 == 1) row.replace(row.find(",206323,"), 8, ",999,");
+      out << row << "\n";
+    }
+  }
+
+  for (CsvParser parser : {CsvParser::SCALAR, CsvParser::SIMD}) {
+    DataSourceConfig source = Source(0, parser);
+    source.data_filepath = path.string();
+    source.compression = Compression::NONE;
+    source.instrument_filter = {206323};
+
+    DataReaderManager manager;
+    ASSERT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> batch(3);
+    size_t total = 0;
+    while (size_t n = manager.LoadNextBatch(0, batch)) {
+      for (size_t i = 0; i < n; ++i) EXPECT_EQ(batch[i].instrument_id, 206323u);
+      total += n;
+    }
+    EXPECT_EQ(total, 10u);
+    EXPECT_EQ(manager.SkippedMessages(0), 10u);
+
+    const auto one_by_one = DrainOneByOne(source);
+    EXPECT_EQ(one_by_one.size(), 10u);
+  }
+}
+
+}  // namespace backtester
@@ -0,0 +1,171 @@
+#include "data_ingestion/DbnMboReader.h"
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class DbnMboReaderTest : public TempPathTest {
+ protected:
+  DbnMboReaderTest() : TempPathTest("dbn") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  std::filesystem::path dbn_path;
+
+  void SetUp() override { dbn_path = TempPath(".dbn"); }
+
+  DataSourceConfig Source(Encoding encoding, Compression compression,
+                          const std::filesystem::path& path) const {
+    return {"ES",
+            0,
+            {},
+            path,
+            DataSchema::MBO,
+            encoding,
+            compression,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO};
+  }
+
+  std::vector<MarketByOrderEvent> CsvEvents() const {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams(
+        {Source(Encoding::CSV, Compression::ZSTD, kTestDataFolder / "futures_mbo.csv.zst")}));
+    std::vector<MarketByOrderEvent> events;
+    MarketByOrderEvent mbo;
+    while (manager.LoadNextEventFromSource(0, mbo)) events.push_back(mbo);
+    return events;
+  }
+
+  static char ActionChar(EventType type) {
+    switch (type) {
+      case EventType::kMarketOrderAdd: return 'A';
+      case EventType::kMarketOrderModify: return 'M';
+      case EventType::kMarketOrderCancel: return 'C';
+      case EventType::kMarketOrderClear: return 'R';
+      case EventType::kMarketTrade: return 'T';
+      case EventType::kMarketFill: return 'F';
+      default: return 'N';
+    }
+  }
+
+  // Encodes `events` as a DBN v2 MBO stream, with a non-MBO record after the first one.
+  static std::string EncodeDbn(const std::vector<MarketByOrderEvent>& events,
+                               uint16_t schema = kDbnSchemaMbo) {
+    std::string metadata(100, '\0');
+    std::memcpy(metadata.data(), "GLBX.MDP3", 9);
+    std::memcpy(metadata.data() + kDbnDatasetLen, &schema, sizeof(schema));
+
+    std::string out("DBN\x02", 4);
+    const auto metadata_len = static_cast<uint32_t>(metadata.size());
+    out.append(reinterpret_cast<const char*>(&metadata_len), sizeof(metadata_len));
+    out += metadata;
+
+    for (size_t i = 0; i < events.size(); ++i) {
+      const auto& ev = events[i];
+      DbnMboMsg msg{};
+      msg.hd = {.length = sizeof(DbnMboMsg) / 4,
+                .rtype = kDbnRtypeMbo,
+                .publisher_id = ev.publisher_id,
+                .instrument_id = ev.instrument_id,
+                .ts_event = ev.header.timestamp};
+      msg.order_id = ev.order_id;
+      msg.price = ev.header.type == EventType::kMarketOrderClear ? kDbnUndefPrice : ev.price;
+      msg.size = ev.size;
+      msg.flags = ev.flags;
+      msg.action = ActionChar(ev.header.type);
+      msg.side = ev.side == OrderSide::kAsk ? 'A' : ev.side == OrderSide::kBid ? 'B' : 'N';
+      msg.ts_recv = ev.ts_recv;
+      msg.ts_in_delta = ev.ts_in_delta;
+      msg.sequence = ev.sequence;
+      out.append(reinterpret_cast<const char*>(&msg), sizeof(msg));
+
+      if (i == 0) {  // system message: header + 64 bytes of text
+        std::string system(80, '\0');
+        system[0] = static_cast<char>(system.size() / 4);
+        system[1] = 0x17;
+        out += system;
+      }
+    }
+    return out;
+  }
+
+  void WriteFile(const std::string& bytes, bool compress) const {
+    std::ofstream f(dbn_path, std::ios::binary | std::ios::trunc);
+    if (!compress) {
+      f << bytes;
+      return;
+    }
+    std::vector<char> buf(ZSTD_compressBound(bytes.size()));
+    const size_t n = ZSTD_compress(buf.data(), buf.size(), bytes.data(), bytes.size(), 3);
+    f.write(buf.data(), static_cast<std::streamsize>(n));
+  }
+
+  static void ExpectSameEvents(const std::vector<MarketByOrderEvent>& got,
+                               const std::vector<MarketByOrderEvent>& expected) {
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      SCOPED_TRACE("event " + std::to_string(i));
+      EXPECT_EQ(got[i].header.timestamp, expected[i].header.timestamp);
+      EXPECT_EQ(got[i].header.type, expected[i].header.type);
+      EXPECT_EQ(got[i].ts_recv, expected[i].ts_recv);
+      EXPECT_EQ(got[i].order_id, expected[i].order_id);
+      EXPECT_EQ(got[i].price, expected[i].price);
+      EXPECT_EQ(got[i].size, expected[i].size);
+      EXPECT_EQ(got[i].sequence, expected[i].sequence);
+      EXPECT_EQ(got[i].instrument_id, expected[i].instrument_id);
+      EXPECT_EQ(got[i].ts_in_delta, expected[i].ts_in_delta);
+      EXPECT_EQ(got[i].publisher_id, expected[i].publisher_id);
+      EXPECT_EQ(got[i].side, expected[i].side);
+      EXPECT_EQ(got[i].flags, expected[i].flags);
+    }
+  }
+};
+
+TEST_F(DbnMboReaderTest, DecodesLikeCsvExport) {
+  const auto expected = CsvEvents();
+  ASSERT_EQ(expected.size(), 20u);
+
+  for (Compression compression : {Compression::NONE, Compression::ZSTD}) {
+    WriteFile(EncodeDbn(expected), compression == Compression::ZSTD);
+    DataReaderManager manager;
+    ASSERT_TRUE(manager.RegisterAndInitStreams({Source(Encoding::DBN, compression, dbn_path)}));
+
+    std::vector<MarketByOrderEvent> got;
+    MarketByOrderEvent mbo;
+    while (manager.LoadNextEventFromSource(0, mbo)) got.push_back(mbo);
+    ExpectSameEvents(got, expected);
+  }
+}
+
+TEST_F(DbnMboReaderTest, SkipsNonMboRecords) {
+  WriteFile(EncodeDbn(CsvEvents()), false);
+  DbnMboReader reader(Source(Encoding::DBN, Compression::NONE, dbn_path));
+  ASSERT_TRUE(reader.Open(dbn_path));
+  EXPECT_EQ(reader.Version(), 2);
+
+  std::vector<MarketByOrderEvent> batch(64);
+  EXPECT_EQ(reader.ReadEvents(batch), 20u);
+  EXPECT_EQ(reader.SkippedRecords(), 1u);
+  EXPECT_EQ(reader.ReadEvents(batch), 0u);
+}
+
+TEST_F(DbnMboReaderTest, RejectsOtherSchemasAndNonDbn) {
+  WriteFile(EncodeDbn(CsvEvents(), /*schema=*/2), false);
+  DbnMboReader reader(Source(Encoding::DBN, Compression::NONE, dbn_path));
+  EXPECT_FALSE(reader.Open(dbn_path));
+
+  WriteFile("ts_recv,ts_event\n", false);
+  EXPECT_FALSE(reader.Open(dbn_path));
+}
+
+}  // namespace backtester
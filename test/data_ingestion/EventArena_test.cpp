@@ -0,0 +1,99 @@
+#include "data_ingestion/EventArena.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class EventArenaTest : public TempPathTest {
+ protected:
+  EventArenaTest() : TempPathTest("arena") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  std::filesystem::path dir_;
+
+  void SetUp() override { dir_ = TempDir(); }
+
+  DataSourceConfig Source(uint16_t id) const {
+    return {"ES",
+            id,
+            {},
+            kTestDataFolder / "futures_mbo.csv.zst",
+            DataSchema::MBO,
+            Encoding::CSV,
+            Compression::ZSTD,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO};
+  }
+
+  static std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source,
+                                               std::shared_ptr<const EventArena> arena) {
+    DataReaderManager manager;
+    manager.UseArena(std::move(arena));
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> got;
+    std::vector<MarketByOrderEvent> batch(6);
+    while (size_t n = manager.LoadNextBatch(source.data_source_id, batch)) {
+      got.insert(got.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    return got;
+  }
+
+  static void ExpectSame(const std::vector<MarketByOrderEvent>& a,
+                         const std::vector<MarketByOrderEvent>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+      EXPECT_EQ(a[i].order_id, b[i].order_id) << "event " << i;
+      EXPECT_EQ(a[i].header.timestamp, b[i].header.timestamp) << "event " << i;
+      EXPECT_EQ(a[i].data_source_id, b[i].data_source_id) << "event " << i;
+    }
+  }
+};
+
+TEST_F(EventArenaTest, InMemoryArenaReplaysLikeTheDataFile) {
+  const auto source = Source(2);
+  const auto direct = Drain(source, nullptr);
+  ASSERT_EQ(direct.size(), 20u);
+
+  const auto arena = EventArena::Build({source});
+  ASSERT_NE(arena, nullptr);
+  ASSERT_TRUE(arena->Contains(2));
+  EXPECT_FALSE(arena->Contains(0));
+  EXPECT_EQ(arena->Events(2).size(), 20u);
+
+  // Every run replays the same decoded events
+  ExpectSame(Drain(source, arena), direct);
+  ExpectSame(Drain(source, arena), direct);
+}
+
+TEST_F(EventArenaTest, SharedArenaIsWrittenOnceAndKeyedBySettings) {
+  const auto source = Source(0);
+  const std::string path = EventArena::SharedPathFor(source, dir_.string(), 0);
+  EXPECT_FALSE(EventArena::OpenShared({source}, dir_.string())->Contains(0));
+
+  const auto built = EventArena::BuildShared({source}, dir_.string());
+  ASSERT_NE(built, nullptr);
+  ASSERT_TRUE(std::filesystem::exists(path));
+  const auto written = std::filesystem::last_write_time(path);
+
+  // A second process maps the same file instead of decoding again
+  const auto opened = EventArena::BuildShared({source}, dir_.string());
+  ASSERT_TRUE(opened->Contains(0));
+  EXPECT_EQ(std::filesystem::last_write_time(path), written);
+  ExpectSame(Drain(source, opened), Drain(source, nullptr));
+
+  auto filtered = source;
+  filtered.instrument_filter = {1};
+  EXPECT_NE(EventArena::SharedPathFor(filtered, dir_.string(), 0), path);
+  auto seeking = source;
+  seeking.seek_to_start = true;
+  EXPECT_NE(EventArena::SharedPathFor(seeking, dir_.string(), 5), path);
+  EXPECT_EQ(EventArena::SharedPathFor(source, dir_.string(), 5), path);
+}
+
+}  // namespace backtester
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+#include "data_ingestion/MboCacheReader.h"
+#include "data_ingestion/MboCacheWriter.h"
+
+namespace backtester {
+
+class MboCacheTest : public TempPathTest {
+ protected:
+  MboCacheTest() : TempPathTest("mbocache") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  std::filesystem::path cache_path;
+
+  void SetUp() override { cache_path = TempPath(".bin"); }
+
+  DataSourceConfig CsvSource() const {
+    return {"ES",
+            0,
+            {},
+            kTestDataFolder / "futures_mbo.csv.zst",
+            DataSchema::MBO,
+            Encoding::CSV,
+            Compression::ZSTD,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO};
+  }
+
+  static MarketByOrderEvent MakeEvent(uint64_t ts, uint32_t instr, uint16_t pub, uint64_t id) {
+    return {.header = {.timestamp = ts, .type = EventType::kMarketOrderAdd},
+            .ts_recv = ts + 1,
+            .order_id = id,
+            .price = 4500'250'000'000,
+            .size = 3,
+            .sequence = 7,
+            .instrument_id = instr,
+            .ts_in_delta = -12,
+            .data_source_id = 0,
+            .publisher_id = pub,
+            .side = OrderSide::kAsk,
+            .flags = 0x80};
+  }
+};
+
+TEST_F(MboCacheTest, PathForStripsCsvZstSuffix) {
+  EXPECT_EQ(MboCachePathFor("/d/ES-glbx-20251105.mbo.csv.zst"), "/d/ES-glbx-20251105.mbo.bin");
+  EXPECT_EQ(MboCachePathFor("/d/raw.dat"), "/d/raw.dat.bin");
+}
+
+TEST_F(MboCacheTest, RoundTripsRecordsAndIndex) {
+  MboCacheWriter writer;
+  ASSERT_TRUE(writer.Open(cache_path));
+  ASSERT_TRUE(writer.Append(MakeEvent(100, 5, 1, 11)));
+  ASSERT_TRUE(writer.Append(MakeEvent(200, 9, 1, 12)));
+  ASSERT_TRUE(writer.Append(MakeEvent(300, 5, 2, 13)));
+  ASSERT_TRUE(writer.Finalize());
+
+  MboCacheReader reader;
+  ASSERT_TRUE(reader.Open(cache_path));
+  EXPECT_TRUE(reader.ProducesEvents());
+  EXPECT_EQ(reader.Header().record_count, 3u);
+  EXPECT_EQ(reader.Header().first_ts, 100u);
+  EXPECT_EQ(reader.Header().last_ts, 300u);
+
+  ASSERT_EQ(reader.InstrumentIndex().size(), 2u);
+  EXPECT_EQ(reader.InstrumentIndex()[0].id, 5u);
+  EXPECT_EQ(reader.InstrumentIndex()[0].record_count, 2u);
+  ASSERT_EQ(reader.PublisherIndex().size(), 2u);
+  EXPECT_EQ(reader.PublisherIndex()[1].id, 2u);
+
+  MarketByOrderEvent out;
+  ASSERT_TRUE(reader.ReadEvent(out));
+  EXPECT_EQ(out.header.timestamp, 100u);
+  EXPECT_EQ(out.ts_recv, 101u);
+  EXPECT_EQ(out.order_id, 11u);
+  EXPECT_EQ(out.price, 4500'250'000'000);
+  EXPECT_EQ(out.ts_in_delta, -12);
+  EXPECT_EQ(out.side, OrderSide::kAsk);
+  ASSERT_TRUE(reader.ReadEvent(out));
+  ASSERT_TRUE(reader.ReadEvent(out));
+  EXPECT_EQ(out.publisher_id, 2u);
+  EXPECT_FALSE(reader.ReadEvent(out));
+}
+
+TEST_F(MboCacheTest, RejectsCorruptedRecords) {
+  MboCacheWriter writer;
+  ASSERT_TRUE(writer.Open(cache_path));
+  ASSERT_TRUE(writer.Append(MakeEvent(100, 5, 1, 11)));
+  ASSERT_TRUE(writer.Finalize());
+
+  {
+    std::fstream f(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(static_cast<std::streamoff>(kMboCacheRecordsOffset) + 20);
+    f.put('\x7f');
+  }
+
+  MboCacheReader checked;
+  EXPECT_FALSE(checked.Open(cache_path));
+  MboCacheReader unchecked(false);
+  EXPECT_TRUE(unchecked.Open(cache_path));
+}
+
+TEST_F(MboCacheTest, RejectsTruncatedFile) {
+  MboCacheWriter writer;
+  ASSERT_TRUE(writer.Open(cache_path));
+  ASSERT_TRUE(writer.Append(MakeEvent(100, 5, 1, 11)));
+  ASSERT_TRUE(writer.Finalize());
+  std::filesystem::resize_file(cache_path, std::filesystem::file_size(cache_path) - 8);
+
+  MboCacheReader reader;
+  EXPECT_FALSE(reader.Open(cache_path));
+}
+
+TEST_F(MboCacheTest, CachedReplayMatchesCsvParse) {
+  std::vector<MarketByOrderEvent> parsed;
+  {
+    DataReaderManager csv_manager;
+    ASSERT_TRUE(csv_manager.RegisterAndInitStreams({CsvSource()}));
+    MboCacheWriter writer;
+    ASSERT_TRUE(writer.Open(cache_path));
+    MarketByOrderEvent mbo;
+    while (csv_manager.LoadNextEventFromSource(0, mbo)) {
+      parsed.push_back(mbo);
+      ASSERT_TRUE(writer.Append(mbo));
+    }
+    ASSERT_TRUE(writer.Finalize());
+  }
+  ASSERT_EQ(parsed.size(), 20u);
+
+  DataSourceConfig cached = CsvSource();
+  cached.encoding = Encoding::MBOCACHE;
+  cached.data_filepath = cache_path;
+  DataReaderManager cache_manager;
+  ASSERT_TRUE(cache_manager.RegisterAndInitStreams({cached}));
+
+  MarketByOrderEvent mbo;
+  for (const auto& expected : parsed) {
+    ASSERT_TRUE(cache_manager.LoadNextEventFromSource(0, mbo));
+    EXPECT_EQ(mbo.header.timestamp, expected.header.timestamp);
+    EXPECT_EQ(mbo.header.type, expected.header.type);
+    EXPECT_EQ(mbo.order_id, expected.order_id);
+    EXPECT_EQ(mbo.price, expected.price);
+    EXPECT_EQ(mbo.size, expected.size);
+    EXPECT_EQ(mbo.instrument_id, expected.instrument_id);
+    EXPECT_EQ(mbo.flags, expected.flags);
+  }
+  EXPECT_FALSE(cache_manager.LoadNextEventFromSource(0, mbo));
+}
+
+}  // namespace backtester
@@ -0,0 +1,150 @@
+#include "data_ingestion/Mbp10CsvParser.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "core/Constants.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class Mbp10CsvParserTest : public TempPathTest {
+ protected:
+  Mbp10CsvParserTest() : TempPathTest("mbp10") {}
+
+  using Events = std::array<EventUnion, Mbp10CsvDecoder::kMaxEventsPerRow>;
+  // bid_px, ask_px, bid_sz, ask_sz per level; counts are written as 1
+  using Level = std::array<std::string, 4>;
+
+  std::filesystem::path path_;
+
+  void SetUp() override { path_ = TempPath(".csv"); }
+
+  static DataSourceConfig Source(const std::string& path = "") {
+    return {"ES_MBP10",
+            2,
+            {},
+            path,
+            DataSchema::MBP10,
+            Encoding::CSV,
+            Compression::NONE,
+            PriceFormat::FIXPNTINT,
+            TmStampFormat::UNIX};
+  }
+
+  static std::string Row(uint64_t ts, char action, char side, const std::string& price,
+                         uint32_t size, const std::vector<Level>& levels,
+                         uint32_t instrument_id = 7) {
+    std::string row = std::to_string(ts) + "," + std::to_string(ts) + ",10,1," +
+                      std::to_string(instrument_id) + "," + action + "," + side + ",0," + price +
+                      "," + std::to_string(size) + ",128,0,99";
+    for (size_t d = 0; d < kMbp10Depth; ++d) {
+      if (d < levels.size()) {
+        const Level& l = levels[d];
+        row += "," + l[0] + "," + l[1] + "," + l[2] + "," + l[3] + ",1,1";
+      } else {
+        row += ",,,0,0,0,0";
+      }
+    }
+    return row + ",ESZ5";
+  }
+};
+
+TEST_F(Mbp10CsvParserTest, EmitsChangedLevelsThenTheAction) {
+  Mbp10CsvDecoder decoder(Source());
+  Events out;
+
+  const size_t first = decoder.DecodeLine(
+      Row(100, 'A', 'B', "99", 5, {{"100", "101", "5", "3"}, {"99", "102", "4", "2"}}), out);
+  ASSERT_EQ(first, 5u);  // two levels on both sides, then the add
+  EXPECT_EQ(out[0].level.header.type, EventType::kMarketLevelUpdate);
+  EXPECT_EQ(out[0].level.side, OrderSide::kBid);
+  EXPECT_EQ(out[0].level.depth, 0u);
+  EXPECT_EQ(out[0].level.price, 100);
+  EXPECT_EQ(out[1].level.side, OrderSide::kAsk);
+  EXPECT_EQ(out[1].level.size, 3u);
+  EXPECT_EQ(out[3].level.depth, 1u);
+  EXPECT_EQ(out[3].level.price, 102);
+  EXPECT_EQ(out[3].level.data_source_id, 2u);
+
+  const MarketByOrderEvent& add = out[4].mbo;
+  EXPECT_EQ(add.header.type, EventType::kMarketOrderAdd);
+  EXPECT_EQ(add.header.timestamp, 100u);
+  EXPECT_EQ(add.order_id, 0u);
+  EXPECT_EQ(add.price, 99);
+  EXPECT_EQ(add.size, 5u);
+  EXPECT_EQ(add.side, OrderSide::kBid);
+  EXPECT_EQ(add.flags, 128u);
+  EXPECT_EQ(add.instrument_id, 7u);
+
+  // Only the best bid size moved, and the second ask level emptied out
+  ASSERT_EQ(decoder.DecodeLine(
+                Row(200, 'C', 'A', "102", 2, {{"100", "101", "6", "3"}, {"99", "", "4", "0"}}),
+                out),
+            3u);
+  EXPECT_EQ(out[0].level.side, OrderSide::kBid);
+  EXPECT_EQ(out[0].level.size, 6u);
+  EXPECT_EQ(out[1].level.side, OrderSide::kAsk);
+  EXPECT_EQ(out[1].level.depth, 1u);
+  EXPECT_EQ(out[1].level.price, kUndefPrice);
+  EXPECT_EQ(out[2].mbo.header.type, EventType::kMarketOrderCancel);
+}
+
+TEST_F(Mbp10CsvParserTest, TradeAlsoFillsTheRestingSide) {
+  Mbp10CsvDecoder decoder(Source());
+  Events out;
+  const std::vector<Level> book = {{"100", "101", "5", "3"}};
+  decoder.DecodeLine(Row(100, 'A', 'A', "101", 3, book), out);
+
+  ASSERT_EQ(decoder.DecodeLine(Row(110, 'T', 'B', "101", 2, book), out), 2u);
+  EXPECT_EQ(out[0].mbo.header.type, EventType::kMarketTrade);
+  EXPECT_EQ(out[0].mbo.side, OrderSide::kBid);
+  EXPECT_EQ(out[1].mbo.header.type, EventType::kMarketFill);
+  EXPECT_EQ(out[1].mbo.side, OrderSide::kAsk);
+  EXPECT_EQ(out[1].mbo.price, 101);
+  EXPECT_EQ(out[1].mbo.size, 2u);
+
+  ASSERT_EQ(decoder.DecodeLine(Row(120, 'T', 'N', "101", 1, book), out), 1u);
+  EXPECT_EQ(decoder.DecodeLine("", out), 0u);
+}
+
+TEST_F(Mbp10CsvParserTest, TracksEachInstrumentSeparately) {
+  Mbp10CsvDecoder decoder(Source());
+  Events out;
+  const std::vector<Level> book = {{"100", "101", "5", "3"}};
+  EXPECT_EQ(decoder.DecodeLine(Row(100, 'A', 'B', "100", 5, book, 7), out), 3u);
+  EXPECT_EQ(decoder.DecodeLine(Row(100, 'A', 'B', "100", 5, book, 8), out), 3u);
+  EXPECT_EQ(decoder.DecodeLine(Row(101, 'A', 'B', "100", 5, book, 7), out), 1u);
+}
+
+TEST_F(Mbp10CsvParserTest, ManagerLoadsRowsAndChecksHeader) {
+  const std::vector<Level> book = {{"100", "101", "5", "3"}};
+  std::ofstream(path_, std::ios::binary | std::ios::trunc)
+      << kExpectedMBP10Header << "\n"
+      << Row(100, 'A', 'B', "100", 5, book) << "\n"
+      << Row(200, 'T', 'A', "100", 1, {{"100", "101", "4", "3"}}) << "\n";
+
+  DataReaderManager manager;
+  ASSERT_TRUE(manager.RegisterAndInitStreams({Source(path_.string())}));
+  std::vector<EventUnion> small(Mbp10CsvDecoder::kMaxEventsPerRow - 1);
+  EXPECT_THROW(manager.LoadNextMarketEvents(2, small), std::invalid_argument);
+
+  std::vector<EventUnion> events(64);
+  ASSERT_EQ(manager.LoadNextMarketEvents(2, events), 6u);  // 2 levels + add, 1 level + T + F
+  EXPECT_EQ(Hdr(events[2]).type, EventType::kMarketOrderAdd);
+  EXPECT_EQ(Hdr(events[3]).type, EventType::kMarketLevelUpdate);
+  EXPECT_EQ(Hdr(events[5]).type, EventType::kMarketFill);
+  EXPECT_EQ(manager.LoadNextMarketEvents(2, events), 0u);
+
+  std::ofstream(path_, std::ios::binary | std::ios::trunc) << kExpectedMboHeader << "\n";
+  DataReaderManager rejecting;
+  EXPECT_FALSE(rejecting.RegisterAndInitStreams({Source(path_.string())}));
+}
+
+}  // namespace backtester
@@ -0,0 +1,159 @@
+#include "data_ingestion/MultiFileReader.h"
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class MultiFileReaderTest : public TempPathTest {
+ protected:
+  MultiFileReaderTest() : TempPathTest("multifile") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  std::filesystem::path dir_;
+  std::string header_;
+  std::vector<std::string> rows_;
+
+  void SetUp() override {
+    dir_ = TempDir();
+
+    std::ifstream in(kTestDataFolder / "futures_mbo.csv");
+    std::getline(in, header_);
+    for (std::string row; std::getline(in, row);) {
+      if (!row.empty()) rows_.push_back(row);
+    }
+  }
+
+  // Splits the sample rows into files of `per_file` rows, each with its own header.
+  std::vector<std::string> SplitDays(size_t per_file, bool zstd) const {
+    std::vector<std::string> files;
+    for (size_t first = 0; first < rows_.size(); first += per_file) {
+      std::string text = header_ + "\n";
+      for (size_t i = first; i < std::min(rows_.size(), first + per_file); ++i) {
+        text += rows_[i] + "\n";
+      }
+      const std::string path =
+          (dir_ / ("day" + std::to_string(files.size()) + (zstd ? ".csv.zst" : ".csv"))).string();
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      if (zstd) {
+        std::vector<char> buf(ZSTD_compressBound(text.size()));
+        const size_t n = ZSTD_compress(buf.data(), buf.size(), text.data(), text.size(), 1);
+        out.write(buf.data(), static_cast<std::streamsize>(n));
+      } else {
+        out << text;
+      }
+      files.push_back(path);
+    }
+    return files;
+  }
+
+  static DataSourceConfig Source(const std::vector<std::string>& files, Compression compression) {
+    DataSourceConfig source{"ES",
+                            0,
+                            {},
+                            files.front(),
+                            DataSchema::MBO,
+                            Encoding::CSV,
+                            compression,
+                            PriceFormat::DECIMAL,
+                            TmStampFormat::ISO};
+    source.data_files = files;
+    return source;
+  }
+
+  static std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> got;
+    std::vector<MarketByOrderEvent> batch(4);
+    while (size_t n = manager.LoadNextBatch(0, batch)) {
+      got.insert(got.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    return got;
+  }
+};
+
+TEST_F(MultiFileReaderTest, ReplaysFilesInOrderAsOneStream) {
+  DataSourceConfig single{"ES",
+                          0,
+                          {},
+                          (kTestDataFolder / "futures_mbo.csv.zst").string(),
+                          DataSchema::MBO,
+                          Encoding::CSV,
+                          Compression::ZSTD,
+                          PriceFormat::DECIMAL,
+                          TmStampFormat::ISO};
+  const auto expected = Drain(single);
+  ASSERT_EQ(expected.size(), 20u);
+
+  for (bool zstd : {false, true}) {
+    SCOPED_TRACE(zstd ? "zstd" : "plain");
+    const auto files = SplitDays(7, zstd);
+    ASSERT_EQ(files.size(), 3u);
+    const auto got = Drain(Source(files, zstd ? Compression::ZSTD : Compression::NONE));
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+      EXPECT_EQ(got[i].order_id, expected[i].order_id) << "event " << i;
+      EXPECT_EQ(got[i].header.timestamp, expected[i].header.timestamp) << "event " << i;
+    }
+  }
+}
+
+TEST_F(MultiFileReaderTest, HeaderOnceAndEmptyDaysSkipped) {
+  auto files = SplitDays(10, false);
+  const std::string empty_day = (dir_ / "empty.csv").string();
+  std::ofstream(empty_day) << header_ << "\n";
+  files.insert(files.begin() + 1, empty_day);
+
+  MultiFileReader reader(Source(files, Compression::NONE));
+  ASSERT_TRUE(reader.Open(files.front()));
+  std::string line;
+  ASSERT_TRUE(reader.ReadLine(line));
+  EXPECT_EQ(line, header_);
+  size_t lines = 0;
+  while (reader.ReadLine(line)) {
+    EXPECT_NE(line, header_);
+    ++lines;
+  }
+  EXPECT_EQ(lines, rows_.size());
+  EXPECT_EQ(reader.FileIndex(), files.size() - 1);
+  EXPECT_FALSE(reader.Open((dir_ / "not_listed.csv").string()));
+}
+
+TEST_F(MultiFileReaderTest, MismatchedHeaderOrMissingFileEndsTheStreamFailed) {
+  for (const bool missing : {false, true}) {
+    SCOPED_TRACE(missing);
+    auto files = SplitDays(10, false);
+    if (missing) {
+      std::filesystem::remove(files[1]);
+    } else {
+      std::ofstream(files[1], std::ios::trunc) << "ts_event,other\n1,2\n";
+    }
+
+    MultiFileReader reader(Source(files, Compression::NONE));
+    ASSERT_TRUE(reader.Open(files.front()));
+    std::string line;
+    size_t lines = 0;
+    while (reader.ReadLine(line)) ++lines;
+    EXPECT_EQ(lines, 11u);  // the header and the first file's rows
+    EXPECT_TRUE(reader.Failed());
+
+    DataReaderManager manager;
+    ASSERT_TRUE(manager.RegisterAndInitStreams({Source(files, Compression::NONE)}));
+    std::vector<MarketByOrderEvent> batch(64);
+    while (manager.LoadNextBatch(0, batch) > 0) {
+    }
+    EXPECT_TRUE(manager.Failed());
+  }
+}
+
+}  // namespace backtester
@@ -0,0 +1,130 @@
+#include "data_ingestion/OhlcvCsvParser.h"
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "core/Constants.h"
+#include "data_ingestion/DataReaderManager.h"
+
+namespace backtester {
+
+class OhlcvCsvParserTest : public TempPathTest {
+ protected:
+  OhlcvCsvParserTest() : TempPathTest("ohlcv") {}
+
+  static constexpr timestamp_t kMinuteNs = 60'000'000'000ULL;
+  std::filesystem::path path_;
+
+  void SetUp() override { path_ = TempPath(".csv"); }
+
+  static DataSourceConfig Source(const std::string& path, Compression compression,
+                                 TmStampFormat ts_format = TmStampFormat::ISO) {
+    DataSourceConfig source{"ES_1M",
+                            3,
+                            {},
+                            path,
+                            DataSchema::OHLCV,
+                            Encoding::CSV,
+                            compression,
+                            PriceFormat::DECIMAL,
+                            ts_format};
+    source.bar_interval_ns = kMinuteNs;
+    return source;
+  }
+
+  static std::string Csv() {
+    return kExpectedOhlcvHeader + "\n" +
+           "2025-11-05T14:30:00.000000000Z,33,1,294973,6850.25,6852.00,6849.75,6851.50,1204,ESZ5\n"
+           "2025-11-05T14:31:00.000000000Z,33,1,294973,6851.50,6853.25,6851.00,6853.00,987,ESZ5\n";
+  }
+
+  void WritePlain(const std::string& text) const {
+    std::ofstream(path_, std::ios::binary | std::ios::trunc) << text;
+  }
+
+  std::string WriteZst(const std::string& text) {
+    std::vector<char> buf(ZSTD_compressBound(text.size()));
+    const size_t n = ZSTD_compress(buf.data(), buf.size(), text.data(), text.size(), 1);
+    const std::string zst = TempPath(".csv.zst").string();
+    std::ofstream(zst, std::ios::binary | std::ios::trunc)
+        .write(buf.data(), static_cast<std::streamsize>(n));
+    return zst;
+  }
+
+  static std::vector<OhlcvBarEvent> Drain(const DataSourceConfig& source) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<EventUnion> events(16);
+    events.resize(manager.LoadNextMarketEvents(source.data_source_id, events));
+    std::vector<OhlcvBarEvent> bars;
+    for (const auto& ev : events) bars.push_back(ev.bar);
+    return bars;
+  }
+};
+
+TEST_F(OhlcvCsvParserTest, ParsesRowAndStampsBarAtClose) {
+  const auto source = Source("", Compression::NONE);
+  OhlcvBarEvent bar;
+  ASSERT_TRUE(ParseOhlcvLine(
+      "2025-11-05T14:30:00.000000000Z,33,1,294973,6850.25,6852.00,6849.75,6851.50,1204,ESZ5",
+      source, bar));
+
+  EXPECT_EQ(bar.header.type, EventType::kMarketBar);
+  EXPECT_EQ(bar.header.timestamp, 1762353000'000000000ULL + kMinuteNs);
+  EXPECT_EQ(bar.open, 6850'250000000);
+  EXPECT_EQ(bar.high, 6852'000000000);
+  EXPECT_EQ(bar.low, 6849'750000000);
+  EXPECT_EQ(bar.close, 6851'500000000);
+  EXPECT_EQ(bar.volume, 1204u);
+  EXPECT_EQ(bar.instrument_id, 294973u);
+  EXPECT_EQ(bar.publisher_id, 1u);
+  EXPECT_EQ(bar.data_source_id, 3u);
+}
+
+TEST_F(OhlcvCsvParserTest, ParsesUnixFixedPointRows) {
+  auto source = Source("", Compression::NONE, TmStampFormat::UNIX);
+  source.price_format = PriceFormat::FIXPNTINT;
+  source.bar_interval_ns = 0;
+  OhlcvBarEvent bar;
+  ASSERT_TRUE(ParseOhlcvLine("1000,32,2,7,10,30,5,20,4", source, bar));
+  EXPECT_EQ(bar.header.timestamp, 1000u);
+  EXPECT_EQ(bar.open, 10);
+  EXPECT_EQ(bar.high, 30);
+  EXPECT_EQ(bar.low, 5);
+  EXPECT_EQ(bar.close, 20);
+  EXPECT_FALSE(ParseOhlcvLine("", source, bar));
+  EXPECT_THROW(ParseOhlcvLine("1000,32,2,7,,30,5,20,4", source, bar), std::runtime_error);
+}
+
+TEST_F(OhlcvCsvParserTest, ManagerLoadsBarsFromPlainAndZstdFiles) {
+  WritePlain(Csv());
+  const auto plain = Drain(Source(path_.string(), Compression::NONE));
+  const auto zst = Drain(Source(WriteZst(Csv()), Compression::ZSTD));
+
+  ASSERT_EQ(plain.size(), 2u);
+  ASSERT_EQ(zst.size(), 2u);
+  for (size_t i = 0; i < plain.size(); ++i) {
+    EXPECT_EQ(plain[i].header.timestamp, zst[i].header.timestamp);
+    EXPECT_EQ(plain[i].close, zst[i].close);
+    EXPECT_EQ(plain[i].volume, zst[i].volume);
+  }
+  EXPECT_EQ(plain[1].header.timestamp - plain[0].header.timestamp, kMinuteNs);
+}
+
+TEST_F(OhlcvCsvParserTest, ManagerRejectsMboHeaderAndDbnBars) {
+  WritePlain(kExpectedMboHeader + "\n");
+  DataReaderManager manager;
+  EXPECT_FALSE(manager.RegisterAndInitStreams({Source(path_.string(), Compression::NONE)}));
+
+  auto dbn = Source(path_.string(), Compression::NONE);
+  dbn.encoding = Encoding::DBN;
+  EXPECT_FALSE(manager.RegisterAndInitStreams({dbn}));
+}
+
+}  // namespace backtester
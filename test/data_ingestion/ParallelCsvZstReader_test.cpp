@@ -0,0 +1,121 @@
+#include "data_ingestion/ParallelCsvZstReader.h"
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "data_ingestion/DataReaderManager.h"
+#include "data_ingestion/ZstdFraming.h"
+
+namespace backtester {
+
+class ParallelCsvZstReaderTest : public TempPathTest {
+ protected:
+  ParallelCsvZstReaderTest() : TempPathTest("framed") {}
+
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+  std::filesystem::path framed_path;
+
+  void SetUp() override { framed_path = TempPath(".csv.zst"); }
+
+  DataSourceConfig Source(const std::filesystem::path& path, uint32_t threads) const {
+    return {"ES",
+            0,
+            {},
+            path,
+            DataSchema::MBO,
+            Encoding::CSV,
+            Compression::ZSTD,
+            PriceFormat::DECIMAL,
+            TmStampFormat::ISO,
+            threads};
+  }
+
+  // Compresses `text` as one frame per `stride` bytes, deliberately ignoring line breaks so
+  // rows straddle frame boundaries.
+  static void WriteFramed(const std::filesystem::path& path, const std::string& text,
+                          size_t stride) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    std::vector<char> buf;
+    for (size_t pos = 0; pos < text.size(); pos += stride) {
+      const size_t n = std::min(stride, text.size() - pos);
+      buf.resize(ZSTD_compressBound(n));
+      const size_t c = ZSTD_compress(buf.data(), buf.size(), text.data() + pos, n, 1);
+      out.write(buf.data(), static_cast<std::streamsize>(c));
+    }
+  }
+
+  std::string PlainCsv() const {
+    std::ifstream in(kTestDataFolder / "futures_mbo.csv", std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source) const {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> events;
+    MarketByOrderEvent mbo;
+    while (manager.LoadNextEventFromSource(0, mbo)) events.push_back(mbo);
+    return events;
+  }
+
+  static void ExpectSameEvents(const std::vector<MarketByOrderEvent>& a,
+                               const std::vector<MarketByOrderEvent>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+      EXPECT_EQ(a[i].header.timestamp, b[i].header.timestamp) << "event " << i;
+      EXPECT_EQ(a[i].header.type, b[i].header.type) << "event " << i;
+      EXPECT_EQ(a[i].order_id, b[i].order_id) << "event " << i;
+      EXPECT_EQ(a[i].price, b[i].price) << "event " << i;
+      EXPECT_EQ(a[i].size, b[i].size) << "event " << i;
+      EXPECT_EQ(a[i].sequence, b[i].sequence) << "event " << i;
+    }
+  }
+};
+
+TEST_F(ParallelCsvZstReaderTest, FramedPathForInsertsSuffix) {
+  EXPECT_EQ(FramedPathFor("/d/ES.mbo.csv.zst"), "/d/ES.mbo.framed.csv.zst");
+  EXPECT_EQ(FramedPathFor("/d/raw.zst"), "/d/raw.zst.framed");
+}
+
+TEST_F(ParallelCsvZstReaderTest, MatchesSequentialReaderAcrossSplitLines) {
+  const auto expected = Drain(Source(kTestDataFolder / "futures_mbo.csv.zst", 1));
+  ASSERT_EQ(expected.size(), 20u);
+
+  // Strides smaller than, equal to and larger than one row, including 1-byte frames
+  for (size_t stride : {size_t{1}, size_t{37}, size_t{150}, size_t{1024}}) {
+    WriteFramed(framed_path, PlainCsv(), stride);
+    ASSERT_GT(CountZstdFrames(framed_path), 1u);
+
+    ParallelCsvZstReader reader(Source(framed_path, 3), 3);
+    ASSERT_TRUE(reader.Open(framed_path));
+    std::vector<MarketByOrderEvent> got;
+    MarketByOrderEvent mbo;
+    while (reader.ReadEvent(mbo)) got.push_back(mbo);
+    SCOPED_TRACE("stride " + std::to_string(stride));
+    ExpectSameEvents(got, expected);
+  }
+}
+
+TEST_F(ParallelCsvZstReaderTest, ReframeRoundTripsThroughManager) {
+  ASSERT_TRUE(ReframeCsvZst(kTestDataFolder / "futures_mbo.csv.zst", framed_path, 256));
+  EXPECT_GT(CountZstdFrames(framed_path), 1u);
+
+  const auto expected = Drain(Source(kTestDataFolder / "futures_mbo.csv.zst", 1));
+  ExpectSameEvents(Drain(Source(framed_path, 4)), expected);
+}
+
+TEST_F(ParallelCsvZstReaderTest, RejectsWrongHeader) {
+  WriteFramed(framed_path, "a,b,c\n1,2,3\n", 4);
+  ParallelCsvZstReader reader(Source(framed_path, 2), 2);
+  EXPECT_FALSE(reader.Open(framed_path));
+}
+
+}  // namespace backtester
@@ -0,0 +1,159 @@
+#include "data_ingestion/SimdCsvZstReader.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "data_ingestion/DataReaderManager.h"
+#include "data_ingestion/MboCsvParser.h"
+#include "utils/SimdScan.h"
+
+namespace backtester {
+
+class SimdCsvZstReaderTest : public ::testing::Test {
+ protected:
+  const std::filesystem::path kTestDataFolder = TEST_DATA_DIR;
+
+  DataSourceConfig Source(CsvParser parser, PriceFormat price = PriceFormat::DECIMAL,
+                          TmStampFormat ts = TmStampFormat::ISO) const {
+    return {"ES",
+            0,
+            {},
+            kTestDataFolder / "futures_mbo.csv.zst",
+            DataSchema::MBO,
+            Encoding::CSV,
+            Compression::ZSTD,
+            price,
+            ts,
+            1,
+            parser};
+  }
+
+  static std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}));
+    std::vector<MarketByOrderEvent> events;
+    MarketByOrderEvent mbo;
+    while (manager.LoadNextEventFromSource(0, mbo)) events.push_back(mbo);
+    return events;
+  }
+
+  static void ExpectSameEvent(const MarketByOrderEvent& a, const MarketByOrderEvent& b) {
+    EXPECT_EQ(a.header.timestamp, b.header.timestamp);
+    EXPECT_EQ(a.header.type, b.header.type);
+    EXPECT_EQ(a.ts_recv, b.ts_recv);
+    EXPECT_EQ(a.order_id, b.order_id);
+    EXPECT_EQ(a.price, b.price);
+    EXPECT_EQ(a.size, b.size);
+    EXPECT_EQ(a.sequence, b.sequence);
+    EXPECT_EQ(a.instrument_id, b.instrument_id);
+    EXPECT_EQ(a.ts_in_delta, b.ts_in_delta);
+    EXPECT_EQ(a.publisher_id, b.publisher_id);
+    EXPECT_EQ(a.side, b.side);
+    EXPECT_EQ(a.flags, b.flags);
+  }
+};
+
+TEST_F(SimdCsvZstReaderTest, ScanMatchesScalarAtEveryAlignment) {
+  std::string text;
+  for (int i = 0; i < 50; ++i) text += "12,a,,bcd\n,x" + std::string(static_cast<size_t>(i), 'z');
+
+  std::vector<uint32_t> simd, scalar;
+  for (size_t offset = 0; offset < 40; ++offset) {
+    const char* data = text.data() + offset;
+    const size_t len = text.size() - offset;
+    const size_t n = simd_scan::FindCsvDelimiters(data, len, simd);
+    ASSERT_EQ(n, simd_scan::FindCsvDelimitersScalar(data, len, scalar));
+    for (size_t i = 0; i < n; ++i) ASSERT_EQ(simd[i], scalar[i]) << "offset " << offset;
+  }
+}
+
+TEST_F(SimdCsvZstReaderTest, BlockParseMatchesLineParse) {
+  const std::string rows =
+      "1700000000000000001,1700000000000000000,160,1,206323,A,B,4500250000000,3,0,77,128,-12,"
+      "9,ESZ5\n"
+      "1700000000000000003,1700000000000000002,160,2,206323,R,N,,0,0,0,8,0,10,ESZ5\r\n"
+      "\n"
+      "1700000000000000005,1700000000000000004,160,1,206323,T,A,4500000000000,1,0,0,0,35,11\n"
+      "1700000000000000007,17000";
+  const auto config = Source(CsvParser::SIMD, PriceFormat::FIXPNTINT, TmStampFormat::UNIX);
+
+  std::vector<uint32_t> delims;
+  std::vector<MarketByOrderEvent> events;
+  const size_t consumed = ParseMboBlock(rows, config, delims, events);
+  EXPECT_EQ(consumed, rows.rfind('\n') + 1);
+  ASSERT_EQ(events.size(), 3u);
+
+  size_t start = 0;
+  for (const auto& ev : events) {
+    size_t end = rows.find('\n', start);
+    if (end == start) end = rows.find('\n', ++start);
+    std::string_view line(rows.data() + start, end - start);
+    if (line.back() == '\r') line.remove_suffix(1);
+    MarketByOrderEvent expected;
+    ASSERT_TRUE(ParseMboLine(line, config, expected));
+    ExpectSameEvent(ev, expected);
+    start = end + 1;
+  }
+  EXPECT_EQ(events[0].ts_in_delta, -12);
+  EXPECT_EQ(events[1].price, 0);
+}
+
+TEST_F(SimdCsvZstReaderTest, OddNumericFieldsFallBackToLineParse) {
+  // A 20-digit order id, a size with trailing text and a flags value past uint8_t
+  const std::vector<std::string> rows = {
+      "1700000000000000001,1700000000000000000,160,1,206323,A,B,4500250000000,3,0,"
+      "12345678901234567890,128,-12,9,ESZ5",
+      "1700000000000000003,1700000000000000002,160,1,206323,A,B,4500250000000,3 ,0,77,128,0,"
+      "10,ESZ5",
+      "1700000000000000005,1700000000000000004,160,1,206323,A,B,4500250000000,3,0,77,300,0,"
+      "11,ESZ5",
+  };
+  const auto config = Source(CsvParser::SIMD, PriceFormat::FIXPNTINT, TmStampFormat::UNIX);
+
+  std::vector<uint32_t> delims;
+  for (const auto& row : rows) {
+    SCOPED_TRACE(row);
+    std::vector<MarketByOrderEvent> events;
+    ParseMboBlock(row + "\n", config, delims, events);
+    ASSERT_EQ(events.size(), 1u);
+    MarketByOrderEvent expected;
+    ASSERT_TRUE(ParseMboLine(row, config, expected));
+    ExpectSameEvent(events[0], expected);
+  }
+
+  std::vector<MarketByOrderEvent> events;
+  ParseMboBlock(rows[0] + "\n" + rows[1] + "\n", config, delims, events);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].order_id, 12345678901234567890u);
+  EXPECT_EQ(events[1].size, 3u);
+}
+
+TEST_F(SimdCsvZstReaderTest, ThrowsOnMissingRequiredField) {
+  std::vector<uint32_t> delims;
+  std::vector<MarketByOrderEvent> events;
+  EXPECT_THROW(ParseMboBlock("1,2,160,1,206323,A,B,5,3,0,,128,0,9\n",
+                             Source(CsvParser::SIMD, PriceFormat::FIXPNTINT, TmStampFormat::UNIX),
+                             delims, events),
+               std::runtime_error);
+}
+
+TEST_F(SimdCsvZstReaderTest, ReaderMatchesScalarReader) {
+  const auto expected = Drain(Source(CsvParser::SCALAR));
+  const auto got = Drain(Source(CsvParser::SIMD));
+  ASSERT_EQ(expected.size(), 20u);
+  ASSERT_EQ(got.size(), expected.size());
+  for (size_t i = 0; i < got.size(); ++i) {
+    SCOPED_TRACE("event " + std::to_string(i));
+    ExpectSameEvent(got[i], expected[i]);
+  }
+}
+
+TEST_F(SimdCsvZstReaderTest, RejectsWrongHeader) {
+  SimdCsvZstReader reader(Source(CsvParser::SIMD));
+  EXPECT_FALSE(reader.Open(kTestDataFolder / "multiline.zst"));
+}
+
+}  // namespace backtester
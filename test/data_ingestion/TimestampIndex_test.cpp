@@ -0,0 +1,268 @@
+#include "data_ingestion/TimestampIndex.h"
+
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TempPathTest.h"
+#include "core/Constants.h"
+#include "data_ingestion/DataReaderManager.h"
+#include "data_ingestion/MboCacheWriter.h"
+
+namespace backtester {
+
+class TimestampIndexTest : public TempPathTest {
+ protected:
+  TimestampIndexTest() : TempPathTest("tsidx") {}
+
+  static constexpr timestamp_t kSec = 1'000'000'000;
+  std::filesystem::path dir_;
+
+  void SetUp() override { dir_ = TempDir(); }
+
+  static std::string Row(timestamp_t ts, char action, uint64_t order_id, uint16_t publisher = 1) {
+    const std::string t = std::to_string(ts);
+    const char side = action == 'R' ? 'N' : (order_id % 2 ? 'B' : 'A');
+    const std::string price = action == 'R' ? "" : std::to_string(4700 + order_id % 50) + ".25";
+    return t + "," + t + ",160," + std::to_string(publisher) + ",42," + action + "," + side + "," +
+           price + "," + (action == 'R' ? "0" : "1") + ",0," + std::to_string(order_id) +
+           ",0,0," + std::to_string(order_id) + ",ESZ2\n";
+  }
+
+  // Three snapshots of one book at 0s, 100s and 200s, each followed by a minute of adds
+  static std::vector<std::string> Chunks() {
+    std::vector<std::string> chunks;
+    uint64_t order_id = 1;
+    for (timestamp_t base : {0 * kSec, 100 * kSec, 200 * kSec}) {
+      std::string chunk = Row(base + kSec, 'R', 0);
+      for (timestamp_t s = 2; s < 60; s += 3) chunk += Row(base + s * kSec, 'A', order_id++);
+      chunks.push_back(chunk);
+    }
+    return chunks;
+  }
+
+  static DataSourceConfig Source(const std::string& path, Encoding encoding,
+                                 Compression compression) {
+    DataSourceConfig source{"ES",          0,        {},
+                            path,          DataSchema::MBO,
+                            encoding,      compression,
+                            PriceFormat::DECIMAL,
+                            TmStampFormat::UNIX};
+    source.seek_to_start = true;
+    return source;
+  }
+
+  std::string WritePlain(const std::vector<std::string>& chunks) const {
+    const std::string path = (dir_ / "day.csv").string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << kExpectedMboHeader << "\n";
+    for (const auto& c : chunks) out << c;
+    return path;
+  }
+
+  // One frame per chunk (header in the first), except that the second chunk is split
+  // mid-row so its second frame is not a seek target.
+  std::string WriteFramed(const std::vector<std::string>& chunks) const {
+    std::vector<std::string> frames = {kExpectedMboHeader + "\n" + chunks[0]};
+    frames.push_back(chunks[1].substr(0, 50));
+    frames.push_back(chunks[1].substr(50));
+    frames.push_back(chunks[2]);
+    const std::string path = (dir_ / "day.csv.zst").string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (const auto& f : frames) {
+      std::vector<char> buf(ZSTD_compressBound(f.size()));
+      const size_t n = ZSTD_compress(buf.data(), buf.size(), f.data(), f.size(), 1);
+      out.write(buf.data(), static_cast<std::streamsize>(n));
+    }
+    return path;
+  }
+
+  static std::vector<MarketByOrderEvent> Drain(const DataSourceConfig& source,
+                                               timestamp_t start_time) {
+    DataReaderManager manager;
+    EXPECT_TRUE(manager.RegisterAndInitStreams({source}, start_time));
+    std::vector<MarketByOrderEvent> got;
+    std::vector<MarketByOrderEvent> batch(8);
+    while (size_t n = manager.LoadNextBatch(0, batch)) {
+      got.insert(got.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    return got;
+  }
+
+  static void ExpectSuffix(const std::vector<MarketByOrderEvent>& full,
+                           const std::vector<MarketByOrderEvent>& got) {
+    ASSERT_LE(got.size(), full.size());
+    const size_t first = full.size() - got.size();
+    for (size_t i = 0; i < got.size(); ++i) {
+      EXPECT_EQ(got[i].order_id, full[first + i].order_id) << "event " << i;
+      EXPECT_EQ(got[i].header.timestamp, full[first + i].header.timestamp) << "event " << i;
+    }
+  }
+};
+
+TEST_F(TimestampIndexTest, ResumesAtLastSnapshotBeforeStart) {
+  const auto chunks = Chunks();
+  const std::string plain = WritePlain(chunks);
+  const std::string framed = WriteFramed(chunks);
+
+  // MBO cache of the same rows
+  const std::string cache = (dir_ / "day.bin").string();
+  {
+    MboCacheWriter writer;
+    ASSERT_TRUE(writer.Open(cache));
+    for (const auto& ev : Drain(Source(plain, Encoding::CSV, Compression::NONE), 0)) {
+      ASSERT_TRUE(writer.Append(ev));
+    }
+    ASSERT_TRUE(writer.Finalize());
+  }
+
+  const std::vector<DataSourceConfig> sources = {
+      Source(plain, Encoding::CSV, Compression::NONE),
+      Source(framed, Encoding::CSV, Compression::ZSTD),
+      Source(cache, Encoding::MBOCACHE, Compression::NONE)};
+  for (const auto& source : sources) {
+    SCOPED_TRACE(source.data_filepath);
+    ASSERT_TRUE(BuildTimestampIndex(source, source.data_filepath, 30 * kSec));
+
+    TimestampIndex index;
+    ASSERT_TRUE(index.Load(TimestampIndexPathFor(source.data_filepath), source.data_filepath,
+                           *IndexPositionFor(source)));
+    const TimestampIndexEntry* entry = index.RecoveryPointBefore(250 * kSec);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->ts, 201 * kSec);
+    EXPECT_EQ(index.RecoveryPointBefore(201 * kSec)->ts, 101 * kSec);
+    EXPECT_EQ(index.RecoveryPointBefore(kSec), nullptr);
+    EXPECT_GT(index.Entries().size(), 3u);  // interval entries between the snapshots
+
+    const auto full = Drain(source, 0);
+    ASSERT_EQ(full.size(), 63u);
+    for (timestamp_t start : {150 * kSec, 250 * kSec}) {
+      const auto got = Drain(source, start);
+      ASSERT_EQ(got.size(), start == 150 * kSec ? 42u : 21u);
+      EXPECT_EQ(got.front().header.type, EventType::kMarketOrderClear);
+      ExpectSuffix(full, got);
+    }
+  }
+
+  // The middle chunk's second frame starts mid-row, so its rows resume from the chunk's
+  // first frame and skip forward.
+  TimestampIndex framed_index;
+  ASSERT_TRUE(framed_index.Load(TimestampIndexPathFor(framed), framed,
+                                IndexPosition::kFrameOffset));
+  const TimestampIndexEntry* middle = framed_index.RecoveryPointBefore(150 * kSec);
+  EXPECT_GT(middle->position, 0u);
+  EXPECT_EQ(middle->skip_rows, 0u);
+  bool interval_in_middle = false;
+  for (const auto& e : framed_index.Entries()) {
+    if (e.ts == 120 * kSec) {
+      interval_in_middle = true;
+      EXPECT_EQ(e.position, middle->position);
+      EXPECT_EQ(e.skip_rows, 7u);
+      EXPECT_EQ(e.flags, kIndexInterval);
+    }
+  }
+  EXPECT_TRUE(interval_in_middle);
+}
+
+TEST_F(TimestampIndexTest, MultiBookSnapshotNeedsEveryBookCleared) {
+  std::string rows = Row(1 * kSec, 'R', 0, 1) + Row(1 * kSec, 'R', 0, 2) +
+                     Row(2 * kSec, 'A', 1, 1) + Row(3 * kSec, 'A', 2, 2) +
+                     Row(10 * kSec, 'R', 0, 1) + Row(11 * kSec, 'A', 3, 1) +  // one book only
+                     Row(20 * kSec, 'R', 0, 2) + Row(20 * kSec, 'A', 4, 2) +
+                     Row(20 * kSec, 'R', 0, 1) + Row(21 * kSec, 'A', 5, 1);
+  const std::string path = WritePlain({rows});
+  const auto source = Source(path, Encoding::CSV, Compression::NONE);
+  ASSERT_TRUE(BuildTimestampIndex(source, path, 1000 * kSec));
+
+  TimestampIndex index;
+  ASSERT_TRUE(index.Load(TimestampIndexPathFor(path), path, IndexPosition::kByteOffset));
+  EXPECT_EQ(index.RecoveryPointBefore(15 * kSec)->ts, 1 * kSec);
+  EXPECT_EQ(index.RecoveryPointBefore(25 * kSec)->ts, 20 * kSec);
+
+  const auto got = Drain(source, 25 * kSec);
+  ASSERT_EQ(got.size(), 4u);
+  EXPECT_EQ(got[0].publisher_id, 2);
+  EXPECT_EQ(got[1].order_id, 4u);
+}
+
+TEST_F(TimestampIndexTest, BarRecoveryWaitsForEveryInstrument) {
+  // Instrument 1 has a bar every 10s, instrument 2 only at 5s and 65s. Bars close a second
+  // after they open.
+  auto bar = [](timestamp_t open, uint32_t instrument) {
+    return std::to_string(open) + ",33,1," + std::to_string(instrument) +
+           ",6850.25,6852.00,6849.75,6851.50,10,ES\n";
+  };
+  std::string text = kExpectedOhlcvHeader + "\n" + bar(0, 1) + bar(5 * kSec, 2);
+  for (timestamp_t s = 10; s <= 100; s += 10) {
+    text += bar(s * kSec, 1);
+    if (s == 60) text += bar(65 * kSec, 2);
+  }
+  const std::string path = (dir_ / "bars.csv").string();
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+
+  DataSourceConfig source = Source(path, Encoding::CSV, Compression::NONE);
+  source.schema = DataSchema::OHLCV;
+  source.bar_interval_ns = kSec;
+  ASSERT_TRUE(BuildTimestampIndex(source, path, 30 * kSec));
+
+  TimestampIndex index;
+  ASSERT_TRUE(index.Load(TimestampIndexPathFor(path), path, IndexPosition::kByteOffset));
+  // The 31s interval entry leaves instrument 2 without a bar until 66s
+  EXPECT_EQ(index.RecoveryPointBefore(50 * kSec)->ts, 1 * kSec);
+  const TimestampIndexEntry* entry = index.RecoveryPointBefore(95 * kSec);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->ts, 66 * kSec);  // the 61s row, whole once instrument 2 had its bar
+
+  DataReaderManager manager;
+  ASSERT_TRUE(manager.RegisterAndInitStreams({source}, 95 * kSec));
+  std::vector<EventUnion> events(16);
+  events.resize(manager.LoadNextMarketEvents(0, events));
+  ASSERT_EQ(events.size(), 6u);
+  EXPECT_EQ(events[0].bar.header.timestamp, 61 * kSec);
+  EXPECT_EQ(events[1].bar.instrument_id, 2u);
+}
+
+TEST_F(TimestampIndexTest, CorruptEntryCountIsRejected) {
+  const std::string path = WritePlain(Chunks());
+  const auto source = Source(path, Encoding::CSV, Compression::NONE);
+  ASSERT_TRUE(BuildTimestampIndex(source, path, 30 * kSec));
+
+  const std::string index_path = TimestampIndexPathFor(path);
+  TimestampIndexHeader header{};
+  {
+    std::ifstream in(index_path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  }
+  header.entry_count = uint64_t{1} << 60;
+  {
+    std::fstream out(index_path, std::ios::binary | std::ios::in | std::ios::out);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  TimestampIndex index;
+  EXPECT_FALSE(index.Load(index_path, path, IndexPosition::kByteOffset));
+  EXPECT_TRUE(index.Entries().empty());
+}
+
+TEST_F(TimestampIndexTest, StaleOrMissingIndexReplaysEverything) {
+  const std::string path = WritePlain(Chunks());
+  const auto source = Source(path, Encoding::CSV, Compression::NONE);
+  EXPECT_EQ(Drain(source, 250 * kSec).size(), 63u);  // no index yet
+
+  ASSERT_TRUE(BuildTimestampIndex(source, path, 30 * kSec));
+  std::ofstream(path, std::ios::app) << Row(300 * kSec, 'A', 99);
+  TimestampIndex index;
+  EXPECT_FALSE(index.Load(TimestampIndexPathFor(path), path, IndexPosition::kByteOffset));
+  EXPECT_EQ(Drain(source, 250 * kSec).size(), 64u);
+
+  // Same size, rewritten later
+  ASSERT_TRUE(BuildTimestampIndex(source, path, 30 * kSec));
+  std::filesystem::last_write_time(
+      path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+  EXPECT_FALSE(index.Load(TimestampIndexPathFor(path), path, IndexPosition::kByteOffset));
+}
+
+}  // namespace backtester
@@ -1670,4 +1670,66 @@ namespace backtester {
         EXPECT_EQ(eh.GetPendingOrder(1)->remaining_qty, 3);
     }
 
+
+    // =============================================================================
+    // MARK: Bar Fill Model
+    // =============================================================================
+
+    static OhlcvBarEvent MakeBar(uint64_t ts, int64_t open, int64_t high, int64_t low,
+        int64_t close, uint32_t instr_id = 294973) {
+        return OhlcvBarEvent {
+            .header = { .timestamp = ts, .type = EventType::kMarketBar },
+            .open = open * 1'000'000'000,
+            .high = high * 1'000'000'000,
+            .low = low * 1'000'000'000,
+            .close = close * 1'000'000'000,
+            .volume = 100,
+            .instrument_id = instr_id,
+            .data_source_id = 1,
+            .publisher_id = 1
+        };
+    }
+
+    TEST_F(ExecutionHandlerTest, Bar_FillsAtLimitWhenRangeReachesPrice) {
+        ExecutionHandler eh(event_queue_, config_, m_state_manager);
+        eh.OnBarEvent(MakeBar(500, 5010, 5012, 5008, 5010));
+        eh.OnStrategyOrder(MakeOrderAdd(1, OrderSide::kBid, 5005, 2, 1000));
+        eh.OnStrategyOrder(MakeOrderAdd(2, OrderSide::kAsk, 5020, 1, 1000));
+
+        const uint64_t bar_ts = 1000 + kLatencyNs + 60;
+        eh.OnBarEvent(MakeBar(bar_ts, 5009, 5015, 5001, 5003));
+
+        auto fills = DrainFills();
+        ASSERT_EQ(fills.size(), 1);
+        EXPECT_EQ(AsFill(fills[0])->order_id, 1);
+        EXPECT_EQ(AsFill(fills[0])->price, 5005'000'000'000);  // limit, not the low
+        EXPECT_EQ(AsFill(fills[0])->quantity, 2);
+        EXPECT_EQ(AsFill(fills[0])->header.timestamp, bar_ts);
+        EXPECT_EQ(eh.GetPendingOrder(1), nullptr);
+        EXPECT_NE(eh.GetPendingOrder(2), nullptr);  // high never reached 5020
+    }
+
+    TEST_F(ExecutionHandlerTest, Bar_OrderNotLiveBeforeLatency) {
+        ExecutionHandler eh(event_queue_, config_, m_state_manager);
+        eh.OnBarEvent(MakeBar(500, 5010, 5012, 5008, 5010));
+        eh.OnStrategyOrder(MakeOrderAdd(1, OrderSide::kBid, 5010, 1, 1000));
+
+        eh.OnBarEvent(MakeBar(1000 + kLatencyNs - 1, 5010, 5012, 4990, 5000));
+        EXPECT_TRUE(event_queue_.IsEmpty());
+        EXPECT_NE(eh.GetPendingOrder(1), nullptr);
+    }
+
+    TEST_F(ExecutionHandlerTest, Bar_DrivenInstrumentIgnoresBookModel) {
+        ExecutionHandler eh(event_queue_, config_, m_state_manager);
+        eh.OnBarEvent(MakeBar(500, 5010, 5012, 5008, 5010));
+        eh.OnStrategyOrder(MakeOrderAdd(1, OrderSide::kBid, 5030, 1, 1000));
+
+        // Marketable against the seeded MBO book, but the instrument is priced by bars
+        auto add = MakeMboAdd(OrderSide::kAsk, 5026, 1, 1000 + kLatencyNs, 5);
+        m_state_manager.OnMarketEvent(add);
+        eh.OnMarketEvent(add);
+        EXPECT_TRUE(event_queue_.IsEmpty());
+        EXPECT_NE(eh.GetPendingOrder(1), nullptr);
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "market_state/LevelBook.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "market_state/MarketStateManager.h"
+
+namespace backtester {
+
+class LevelBookTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kInstr = 7;
+
+  static MarketLevelEvent Level(OrderSide side, uint8_t depth, int64_t price, uint32_t size,
+                                uint16_t publisher_id = 1) {
+    return {.header = {.timestamp = 100, .type = EventType::kMarketLevelUpdate},
+            .price = price,
+            .size = size,
+            .count = 1,
+            .instrument_id = kInstr,
+            .sequence = 0,
+            .data_source_id = 0,
+            .publisher_id = publisher_id,
+            .side = side,
+            .depth = depth};
+  }
+
+  static MarketByOrderEvent Trade(int64_t price, uint32_t size) {
+    return {.header = {.timestamp = 200, .type = EventType::kMarketTrade},
+            .ts_recv = 200,
+            .order_id = 0,
+            .price = price,
+            .size = size,
+            .sequence = 0,
+            .instrument_id = kInstr,
+            .ts_in_delta = 0,
+            .data_source_id = 0,
+            .publisher_id = 1,
+            .side = OrderSide::kBid,
+            .flags = 128};
+  }
+};
+
+TEST_F(LevelBookTest, AppliesSlotsAndReadsLikeOrderBook) {
+  LevelBook book(1);
+  book.Apply(Level(OrderSide::kBid, 0, 100, 5));
+  book.Apply(Level(OrderSide::kBid, 1, 99, 4));
+  book.Apply(Level(OrderSide::kAsk, 0, 101, 3));
+
+  EXPECT_EQ(book.GetBbo().bid.price, 100);
+  EXPECT_EQ(book.GetBbo().ask.size, 3u);
+  EXPECT_EQ(book.GetBidLevel(1).price, 99);
+  EXPECT_EQ(book.GetAskLevel(1).price, kUndefPrice);
+  EXPECT_EQ(book.GetBidLevel(LevelBook::kDepth).price, kUndefPrice);
+  EXPECT_EQ(book.GetLevelByPx(OrderSide::kBid, 99).size, 4u);
+  EXPECT_EQ(book.GetLevelByPx(OrderSide::kAsk, 99).size, 0u);
+
+  auto snapshot = book.GetSnapshot(3);
+  ASSERT_EQ(snapshot.size(), 3u);
+  EXPECT_EQ(snapshot[1].bid.price, 99);
+  EXPECT_EQ(snapshot[2].bid.price, kUndefPrice);
+
+  book.Apply(Level(OrderSide::kBid, 1, kUndefPrice, 0));  // slot emptied
+  EXPECT_EQ(book.GetBidLevel(1).price, kUndefPrice);
+  book.Apply(Level(OrderSide::kBid, LevelBook::kDepth, 90, 1));  // past the fixed depth
+  book.Clear();
+  EXPECT_EQ(book.GetBbo().bid.price, kUndefPrice);
+}
+
+TEST_F(LevelBookTest, MarketStateServesProviderQueriesFromLevels) {
+  MarketStateManager msm;
+  msm.Initialize({kInstr});
+  msm.OnLevelEvent(Level(OrderSide::kBid, 0, 100, 5, 1));
+  msm.OnLevelEvent(Level(OrderSide::kBid, 1, 99, 4, 1));
+  msm.OnLevelEvent(Level(OrderSide::kAsk, 0, 101, 3, 1));
+  msm.OnLevelEvent(Level(OrderSide::kBid, 0, 100, 2, 2));  // second publisher at the same px
+  msm.OnLevelEvent(Level(OrderSide::kAsk, 0, 101, 1, 2));
+
+  const MarketSnapshot* snap = msm.GetSnapshotByInstr(kInstr);
+  EXPECT_EQ(snap->bbo.bid.price, 100);
+  EXPECT_EQ(snap->bbo.bid.size, 7u);
+  EXPECT_EQ(snap->bbo.ask.size, 4u);
+  EXPECT_EQ(snap->wmp, (100 * 4 + 101 * 7) / 11);
+
+  std::array<PriceLevel, 2> bids{PriceLevel{100, 0, 0}, PriceLevel{99, 0, 0}};
+  msm.GetAggOBBidsSnapshot(kInstr, bids);
+  EXPECT_EQ(bids[0].size, 7u);
+  EXPECT_EQ(bids[1].size, 4u);
+  std::array<PriceLevel, 1> asks{PriceLevel{101, 0, 0}};
+  msm.GetAggOBAsksSnapshot(kInstr, asks);
+  EXPECT_EQ(asks[0].size, 4u);
+
+  EXPECT_EQ(msm.GetQueueDepth(kInstr, OrderSide::kBid, 99), 4);
+  EXPECT_EQ(msm.GetOBSnapshotByPub(kInstr, 2, 1)[0].bid.size, 2u);
+
+  // order_id 0 actions never reach a book; trades still drive the snapshot
+  msm.OnMarketEvent(Trade(101, 2));
+  EXPECT_EQ(snap->last_trade.price, 101);
+  EXPECT_EQ(snap->vwap, 101);
+  EXPECT_EQ(msm.GetQueueDepth(kInstr, OrderSide::kAsk, 101), 4);
+}
+
+}  // namespace backtester
@@ -0,0 +1,126 @@
+#include "market_state/SnapshotMarketDataProvider.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "market_state/MarketStateManager.h"
+
+namespace backtester {
+
+class SnapshotMarketDataProviderTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kInstr = 7;
+  static constexpr int64_t kTick = 25;
+
+  void SetUp() override {
+    book_.Initialize({kInstr, 8});
+    TradedInstrument instr{};
+    instr.instrument_id = kInstr;
+    instr.tick_size = kTick;
+    traded_ = {instr};
+  }
+
+  static EventUnion Add(OrderSide side, int64_t price, uint32_t size, uint16_t publisher_id,
+                        uint64_t order_id) {
+    return {.mbo = {.header = {.timestamp = 100, .type = EventType::kMarketOrderAdd},
+                    .ts_recv = 100,
+                    .order_id = order_id,
+                    .price = price,
+                    .size = size,
+                    .sequence = 1,
+                    .instrument_id = kInstr,
+                    .ts_in_delta = 0,
+                    .data_source_id = 0,
+                    .publisher_id = publisher_id,
+                    .side = side,
+                    .flags = 0x80}};
+  }
+
+  // What the book thread does for one event
+  MarketFrame Publish(const EventUnion& ev) {
+    book_.OnMarketEvent(ev.mbo);
+    MarketFrame frame{};
+    frame.event = ev;
+    frame.has_state = true;
+    SnapshotMarketDataProvider::Capture(book_, kInstr, kTick, frame.state);
+    return frame;
+  }
+
+  MarketStateManager book_;
+  std::vector<TradedInstrument> traded_;
+};
+
+TEST_F(SnapshotMarketDataProviderTest, ViewAnswersLikeTheBook) {
+  SnapshotMarketDataProvider view(traded_);
+  uint64_t oid = 1;
+  for (const auto& ev :
+       {Add(OrderSide::kBid, 1000, 5, 1, oid++), Add(OrderSide::kBid, 1000, 2, 2, oid++),
+        Add(OrderSide::kBid, 950, 4, 1, oid++), Add(OrderSide::kAsk, 1050, 3, 2, oid++),
+        Add(OrderSide::kAsk, 1100, 6, 1, oid++)}) {
+    view.Apply(Publish(ev));
+  }
+
+  const auto& book_snap = *book_.GetSnapshotByInstr(kInstr);
+  EXPECT_EQ(view.GetSnapshotByInstr(kInstr)->bbo, book_snap.bbo);
+  EXPECT_EQ(view.GetSnapshotByInstr(kInstr)->wmp, book_snap.wmp);
+  EXPECT_EQ(view.GetTradedInstrsBbo().at(kInstr), book_snap.bbo);
+
+  for (int64_t px : {1000, 975, 950, 925}) {
+    EXPECT_EQ(view.GetQueueDepth(kInstr, OrderSide::kBid, px),
+              book_.GetQueueDepth(kInstr, OrderSide::kBid, px))
+        << px;
+  }
+  EXPECT_EQ(view.GetQueueDepth(kInstr, OrderSide::kAsk, 1100), 6);
+
+  // Same tick grid the execution handler walks
+  std::array<PriceLevel, 3> from_view, from_book;
+  for (size_t i = 0; i < 3; ++i) {
+    from_view[i].price = from_book[i].price = 1050 + kTick * static_cast<int64_t>(i);
+  }
+  view.GetAggOBAsksSnapshot(kInstr, from_view);
+  book_.GetAggOBAsksSnapshot(kInstr, from_book);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(from_view[i].size, from_book[i].size) << i;
+    EXPECT_EQ(from_view[i].count, from_book[i].count) << i;
+  }
+}
+
+TEST_F(SnapshotMarketDataProviderTest, FramesWithoutStateAndFarLevels) {
+  SnapshotMarketDataProvider view(traded_);
+  view.Apply(Publish(Add(OrderSide::kBid, 1000, 5, 1, 1)));
+
+  // An event of an instrument that is not traded carries no state and changes nothing
+  EventUnion other = Add(OrderSide::kBid, 2000, 1, 1, 2);
+  other.mbo.instrument_id = 8;
+  MarketFrame frame{};
+  frame.event = other;
+  view.Apply(frame);
+  EXPECT_EQ(view.GetSnapshotByInstr(kInstr)->bbo.bid.price, 1000);
+  EXPECT_THROW(view.GetSnapshotByInstr(8), std::runtime_error);
+
+  // Deep levels read like the book, up to kFrameDepth ticks from the best bid
+  const int64_t deep = 1000 - kTick * 20;
+  view.Apply(Publish(Add(OrderSide::kBid, deep, 9, 1, 3)));
+  EXPECT_EQ(view.GetQueueDepth(kInstr, OrderSide::kBid, deep), 9);
+  EXPECT_EQ(view.GetQueueDepth(kInstr, OrderSide::kBid, deep + kTick), 0);
+  EXPECT_EQ(view.GetQueueDepth(kInstr, OrderSide::kBid, 1000 + kTick), 0);  // above the best
+
+  std::array<PriceLevel, kFrameDepth> walk{}, from_book{};
+  for (size_t i = 0; i < walk.size(); ++i) {
+    walk[i].price = from_book[i].price = 1000 - kTick * static_cast<int64_t>(i);
+  }
+  view.GetAggOBBidsSnapshot(kInstr, walk);
+  book_.GetAggOBBidsSnapshot(kInstr, from_book);
+  for (size_t i = 0; i < walk.size(); ++i) EXPECT_EQ(walk[i].size, from_book[i].size) << i;
+  EXPECT_EQ(walk[20].size, 9u);
+
+  // Past that the view cannot answer like the book, so it refuses
+  const int64_t past = 1000 - kTick * static_cast<int64_t>(kFrameDepth);
+  EXPECT_THROW(view.GetQueueDepth(kInstr, OrderSide::kBid, past), std::runtime_error);
+  std::array<PriceLevel, 1> beyond{};
+  beyond[0].price = past;
+  EXPECT_THROW(view.GetAggOBBidsSnapshot(kInstr, beyond), std::runtime_error);
+}
+
+}  // namespace backtester
@@ -0,0 +1,66 @@
+#include "utils/StageProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+namespace backtester {
+
+TEST(LatencyHistogramTest, BucketsAreExactLowAndWithinThreePercentHigh) {
+  for (uint64_t v = 0; v < 2 * LatencyHistogram::kSubBuckets; ++v) {
+    EXPECT_EQ(LatencyHistogram::BucketLowest(LatencyHistogram::BucketOf(v)), v);
+  }
+  for (uint64_t v : {64ULL, 65ULL, 1'000ULL, 123'456ULL, 987'654'321ULL}) {
+    const size_t b = LatencyHistogram::BucketOf(v);
+    const uint64_t lowest = LatencyHistogram::BucketLowest(b);
+    const uint64_t next = LatencyHistogram::BucketLowest(b + 1);
+    EXPECT_LE(lowest, v);
+    EXPECT_GT(next, v);
+    EXPECT_LE(static_cast<double>(next - lowest), static_cast<double>(v) / 32.0 + 1.0) << v;
+  }
+  EXPECT_EQ(LatencyHistogram::BucketOf(LatencyHistogram::kMaxValue),
+            LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, QuantilesTotalsAndMerge) {
+  auto a = std::make_unique<LatencyHistogram>();
+  auto b = std::make_unique<LatencyHistogram>();
+  for (uint64_t v = 1; v <= 500; ++v) a->Record(v * 10);
+  for (uint64_t v = 501; v <= 1000; ++v) b->Record(v * 10);
+  a->Merge(*b);
+
+  EXPECT_EQ(a->Count(), 1000u);
+  EXPECT_EQ(a->Total(), 10u * 1000u * 1001u / 2u);
+  EXPECT_EQ(a->Max(), 10'000u);
+  EXPECT_NEAR(static_cast<double>(a->ValueAtQuantile(0.5)), 5'000.0, 5'000.0 * 0.032);
+  EXPECT_NEAR(static_cast<double>(a->ValueAtQuantile(0.99)), 9'900.0, 9'900.0 * 0.032);
+  EXPECT_EQ(a->ValueAtQuantile(1.0), 10'000u);
+  EXPECT_EQ(LatencyHistogram{}.ValueAtQuantile(0.5), 0u);
+}
+
+TEST(StageProfilerTest, NestedTimersRecordExclusiveTime) {
+  StageProfiler& profiler = StageProfiler::ThisThread();
+  profiler.Reset();
+  {
+    StageTimer outer(Stage::kMerge);
+    for (int i = 0; i < 3; ++i) {
+      StageTimer inner(Stage::kRead);
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+  }
+  const LatencyHistogram& merge = profiler.Histogram(Stage::kMerge);
+  const LatencyHistogram& read = profiler.Histogram(Stage::kRead);
+  EXPECT_EQ(merge.Count(), 1u);
+  EXPECT_EQ(read.Count(), 3u);
+  // The reads slept; the merge around them did next to nothing on its own
+  EXPECT_LT(merge.Total() * 10, read.Total());
+
+  const std::string table = profiler.Format(StageProfiler::TicksPerNs());
+  EXPECT_NE(table.find("merge"), std::string::npos);
+  EXPECT_NE(table.find("read"), std::string::npos);
+  EXPECT_EQ(table.find("parse"), std::string::npos);  // stages never timed are left out
+  profiler.Reset();
+}
+
+}  // namespace backtester